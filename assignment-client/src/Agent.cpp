@@ -664,6 +664,8 @@ void Agent::queryAvatars() {
 
     destinationBuffer += conicalView.serialize(destinationBuffer);
 
+    destinationBuffer += DependencyManager::get<AvatarHashMap>()->packJointKeyframeRequests(destinationBuffer);
+
     avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
 
     DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket),
@@ -458,6 +458,16 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the in-memory cache for frequently requested assets
+    static const QString HOT_ASSET_CACHE_SIZE_OPTION = "hot_asset_cache_size";
+    auto hotAssetCacheSizeJSONValue = assetServerObject[HOT_ASSET_CACHE_SIZE_OPTION];
+    if (hotAssetCacheSizeJSONValue.isDouble()) {
+        static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+        auto hotAssetCacheSize = (qint64)hotAssetCacheSizeJSONValue.toInt() * BYTES_PER_MEGABYTE;
+        _hotAssetCache->setCapacity(hotAssetCacheSize);
+        qCInfo(asset_server) << "Hot asset cache size set to" << hotAssetCacheSizeJSONValue.toInt() << "MB";
+    }
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -538,6 +548,10 @@ void AssetServer::cleanupUnmappedFiles() {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
+                // some platforms won't remove a file that is still mapped
+                _mappedAssetCache->remove(_filesDirectory.filePath(filename));
+                _hotAssetCache->remove(filename);
+
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
@@ -867,7 +881,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _hotAssetCache, _mappedAssetCache);
     _transferTaskPool.start(task);
 }
 
@@ -912,7 +926,7 @@ void AssetServer::sendStatsPacket() {
 
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->eachNode([&](auto& node) {
-        auto& stats = node->getConnectionStats();
+        auto stats = node->getConnectionStats();
 
         QJsonObject nodeStats;
         auto endTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(stats.endTime);
@@ -957,6 +971,22 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    auto hotAssetCacheStats = _hotAssetCache->getStats();
+    auto hotAssetCacheRequests = hotAssetCacheStats.hits + hotAssetCacheStats.misses;
+
+    QJsonObject hotAssetCacheObject;
+    hotAssetCacheObject["1. Hits"] = (double)hotAssetCacheStats.hits;
+    hotAssetCacheObject["2. Misses"] = (double)hotAssetCacheStats.misses;
+    hotAssetCacheObject["3. Hit Rate (%)"] = hotAssetCacheRequests > 0
+        ? 100.0 * hotAssetCacheStats.hits / hotAssetCacheRequests : 0.0;
+    hotAssetCacheObject["4. Admissions"] = (double)hotAssetCacheStats.admissions;
+    hotAssetCacheObject["5. Rejections"] = (double)hotAssetCacheStats.rejections;
+    hotAssetCacheObject["6. Evictions"] = (double)hotAssetCacheStats.evictions;
+    hotAssetCacheObject["7. Entries"] = hotAssetCacheStats.numEntries;
+    hotAssetCacheObject["8. Size (MB)"] = (double)hotAssetCacheStats.sizeBytes / (1024.0 * 1024.0);
+    hotAssetCacheObject["9. Capacity (MB)"] = (double)_hotAssetCache->getCapacity() / (1024.0 * 1024.0);
+    serverStats["hot_asset_cache"] = hotAssetCacheObject;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1172,6 +1202,10 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
+            // some platforms won't remove a file that is still mapped
+            _mappedAssetCache->remove(_filesDirectory.filePath(hash));
+            _hotAssetCache->remove(hash);
+
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
@@ -19,6 +19,8 @@
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
+#include "HotAssetCache.h"
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
 
 #include "RegisteredMetaTypes.h"
@@ -153,6 +155,12 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Whole assets that are requested often enough to be kept in memory
+    std::shared_ptr<HotAssetCache> _hotAssetCache { std::make_shared<HotAssetCache>() };
+
+    /// Open mappings of recently requested asset files, shared by the SendAssetTasks
+    std::shared_ptr<MappedAssetCache> _mappedAssetCache { std::make_shared<MappedAssetCache>() };
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
@@ -0,0 +1,164 @@
+//
+//  HotAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HotAssetCache.h"
+
+#include <algorithm>
+
+// an asset larger than this fraction of a shard would push out too much of what is already cached
+static const int MAX_ENTRY_FRACTION_OF_SHARD = 4;
+
+HotAssetCache::FrequencySketch::FrequencySketch() : _counters(NUM_ROWS * ROW_WIDTH, 0) {
+}
+
+int HotAssetCache::FrequencySketch::indexFor(const AssetUtils::AssetHash& hash, int row) const {
+    static const uint ROW_SEEDS[NUM_ROWS] = { 0x9E3779B9, 0x85EBCA6B, 0xC2B2AE35, 0x27D4EB2F };
+    return row * ROW_WIDTH + (qHash(hash, ROW_SEEDS[row]) & (ROW_WIDTH - 1));
+}
+
+void HotAssetCache::FrequencySketch::increment(const AssetUtils::AssetHash& hash) {
+    for (int row = 0; row < NUM_ROWS; ++row) {
+        auto& counter = _counters[indexFor(hash, row)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+        }
+    }
+
+    if (++_numIncrements >= SAMPLE_SIZE) {
+        // age every count so that assets that were popular a while ago don't keep their place forever
+        for (auto& counter : _counters) {
+            counter >>= 1;
+        }
+        _numIncrements /= 2;
+    }
+}
+
+int HotAssetCache::FrequencySketch::estimate(const AssetUtils::AssetHash& hash) const {
+    int frequency = MAX_COUNT;
+    for (int row = 0; row < NUM_ROWS; ++row) {
+        frequency = std::min(frequency, (int)_counters[indexFor(hash, row)]);
+    }
+    return frequency;
+}
+
+HotAssetCache::HotAssetCache(qint64 capacityBytes) : _capacity(capacityBytes) {
+}
+
+HotAssetCache::Shard& HotAssetCache::shardFor(const AssetUtils::AssetHash& hash) {
+    return _shards[qHash(hash) % NUM_SHARDS];
+}
+
+void HotAssetCache::setCapacity(qint64 capacityBytes) {
+    _capacity = std::max(capacityBytes, (qint64)0);
+
+    for (auto& shard : _shards) {
+        QMutexLocker locker(&shard.mutex);
+        evictToCapacity(shard, _capacity / NUM_SHARDS);
+    }
+}
+
+bool HotAssetCache::get(const AssetUtils::AssetHash& hash, QByteArray& data) {
+    if (_capacity == 0) {
+        return false;
+    }
+
+    auto& shard = shardFor(hash);
+    QMutexLocker locker(&shard.mutex);
+
+    shard.sketch.increment(hash);
+
+    auto it = shard.entriesByHash.find(hash);
+    if (it == shard.entriesByHash.end()) {
+        ++_misses;
+        return false;
+    }
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, it.value());
+
+    // QByteArray is implicitly shared, the caller gets a reference to the cached data and not a copy
+    data = it.value()->second;
+    ++_hits;
+    return true;
+}
+
+void HotAssetCache::offer(const AssetUtils::AssetHash& hash, const char* data, qint64 size) {
+    qint64 shardCapacity = _capacity / NUM_SHARDS;
+    if (size <= 0 || size > shardCapacity / MAX_ENTRY_FRACTION_OF_SHARD) {
+        return;
+    }
+
+    auto& shard = shardFor(hash);
+    QMutexLocker locker(&shard.mutex);
+
+    if (shard.entriesByHash.contains(hash)) {
+        // another task got here first
+        return;
+    }
+
+    qint64 bytesToFree = shard.size + size - shardCapacity;
+    if (bytesToFree > 0) {
+        // only admit the asset if it is requested more often than every asset it would evict
+        int candidateFrequency = shard.sketch.estimate(hash);
+        qint64 bytesFreed = 0;
+        for (auto it = shard.entries.rbegin(); it != shard.entries.rend() && bytesFreed < bytesToFree; ++it) {
+            if (shard.sketch.estimate(it->first) >= candidateFrequency) {
+                ++_rejections;
+                return;
+            }
+            bytesFreed += it->second.size();
+        }
+
+        evictToCapacity(shard, shardCapacity - size);
+    }
+
+    shard.entries.emplace_front(hash, QByteArray(data, size));
+    shard.entriesByHash.insert(hash, shard.entries.begin());
+    shard.size += size;
+    ++_admissions;
+}
+
+void HotAssetCache::remove(const AssetUtils::AssetHash& hash) {
+    auto& shard = shardFor(hash);
+    QMutexLocker locker(&shard.mutex);
+
+    auto it = shard.entriesByHash.find(hash);
+    if (it != shard.entriesByHash.end()) {
+        shard.size -= it.value()->second.size();
+        shard.entries.erase(it.value());
+        shard.entriesByHash.erase(it);
+    }
+}
+
+void HotAssetCache::evictToCapacity(Shard& shard, qint64 shardCapacity) {
+    while (shard.size > shardCapacity && !shard.entries.empty()) {
+        auto& victim = shard.entries.back();
+        shard.size -= victim.second.size();
+        shard.entriesByHash.remove(victim.first);
+        shard.entries.pop_back();
+        ++_evictions;
+    }
+}
+
+HotAssetCache::Stats HotAssetCache::getStats() const {
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.admissions = _admissions;
+    stats.rejections = _rejections;
+    stats.evictions = _evictions;
+
+    for (const auto& shard : _shards) {
+        QMutexLocker locker(&shard.mutex);
+        stats.sizeBytes += shard.size;
+        stats.numEntries += (int)shard.entries.size();
+    }
+
+    return stats;
+}
@@ -0,0 +1,106 @@
+//
+//  HotAssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HotAssetCache_h
+#define hifi_HotAssetCache_h
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include "AssetUtils.h"
+
+/// Size bounded in-memory cache of whole assets, so that the handful of assets every arriving client asks for
+/// are served without touching the disk.
+///
+/// The cache is split into shards by asset hash, each with its own lock and LRU. An asset read from disk is only
+/// admitted if it has been requested more often than the assets it would evict (TinyLFU) - request frequencies
+/// are tracked in a small count-min sketch per shard that is halved periodically so that it follows changes in
+/// popularity.
+class HotAssetCache {
+    friend class HotAssetCacheTests;
+public:
+    static const int NUM_SHARDS = 16;
+    static const qint64 DEFAULT_CAPACITY_BYTES = 256 * 1024 * 1024;
+
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 admissions { 0 };
+        quint64 rejections { 0 };
+        quint64 evictions { 0 };
+        qint64 sizeBytes { 0 };
+        int numEntries { 0 };
+    };
+
+    HotAssetCache(qint64 capacityBytes = DEFAULT_CAPACITY_BYTES);
+
+    void setCapacity(qint64 capacityBytes);
+    qint64 getCapacity() const { return _capacity; }
+
+    /// Looks up an asset, counting the request towards its admission frequency either way
+    bool get(const AssetUtils::AssetHash& hash, QByteArray& data);
+
+    /// Offers an asset that was just read from disk after a miss - the data is only copied if it is admitted
+    void offer(const AssetUtils::AssetHash& hash, const char* data, qint64 size);
+
+    void remove(const AssetUtils::AssetHash& hash);
+
+    Stats getStats() const;
+
+private:
+    class FrequencySketch {
+    public:
+        FrequencySketch();
+
+        void increment(const AssetUtils::AssetHash& hash);
+        int estimate(const AssetUtils::AssetHash& hash) const;
+
+    private:
+        static const int NUM_ROWS = 4;
+        static const int ROW_WIDTH = 1024;
+        static const int MAX_COUNT = 15;
+        static const int SAMPLE_SIZE = 10 * ROW_WIDTH;
+
+        int indexFor(const AssetUtils::AssetHash& hash, int row) const;
+
+        std::vector<uint8_t> _counters;
+        int _numIncrements { 0 };
+    };
+
+    using Entry = std::pair<AssetUtils::AssetHash, QByteArray>;
+
+    struct Shard {
+        mutable QMutex mutex;
+        std::list<Entry> entries; // most recently used first
+        QHash<AssetUtils::AssetHash, std::list<Entry>::iterator> entriesByHash;
+        qint64 size { 0 };
+        FrequencySketch sketch;
+    };
+
+    Shard& shardFor(const AssetUtils::AssetHash& hash);
+    void evictToCapacity(Shard& shard, qint64 shardCapacity);
+
+    std::array<Shard, NUM_SHARDS> _shards;
+    std::atomic<qint64> _capacity;
+
+    std::atomic<quint64> _hits { 0 };
+    std::atomic<quint64> _misses { 0 };
+    std::atomic<quint64> _admissions { 0 };
+    std::atomic<quint64> _rejections { 0 };
+    std::atomic<quint64> _evictions { 0 };
+};
+
+#endif // hifi_HotAssetCache_h
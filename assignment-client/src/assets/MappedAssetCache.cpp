@@ -0,0 +1,89 @@
+//
+//  MappedAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCache.h"
+
+#include "AssetServerLogging.h"
+
+MappedAsset::MappedAsset(const QString& filePath) : _file(filePath) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    _size = _file.size();
+
+    if (_size == 0) {
+        // there is nothing to map in an empty file
+        _isValid = true;
+        return;
+    }
+
+    // the mapping is owned by the file and goes away with it
+    _data = _file.map(0, _size);
+    _isValid = _data != nullptr;
+
+    if (!_isValid) {
+        qCWarning(asset_server) << "Could not map asset file" << filePath << "-" << _file.errorString();
+    }
+}
+
+std::shared_ptr<const MappedAsset> MappedAssetCache::get(const QString& filePath) {
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _entriesByPath.find(filePath);
+        if (it != _entriesByPath.end()) {
+            // move the entry to the front of the LRU
+            _entries.splice(_entries.begin(), _entries, it.value());
+            return _entries.front().second;
+        }
+    }
+
+    // map the file outside of the lock, hits for other assets shouldn't wait on the file system
+    auto mappedAsset = std::make_shared<const MappedAsset>(filePath);
+    if (!mappedAsset->isValid()) {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entriesByPath.find(filePath);
+    if (it != _entriesByPath.end()) {
+        // another task mapped the same file while we were, use theirs
+        _entries.splice(_entries.begin(), _entries, it.value());
+        return _entries.front().second;
+    }
+
+    _entries.emplace_front(filePath, mappedAsset);
+    _entriesByPath.insert(filePath, _entries.begin());
+
+    while ((int)_entries.size() > _maxMappings) {
+        // tasks still sending from the evicted mapping keep it alive until they're done
+        _entriesByPath.remove(_entries.back().first);
+        _entries.pop_back();
+    }
+
+    return mappedAsset;
+}
+
+void MappedAssetCache::remove(const QString& filePath) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entriesByPath.find(filePath);
+    if (it != _entriesByPath.end()) {
+        _entries.erase(it.value());
+        _entriesByPath.erase(it);
+    }
+}
+
+void MappedAssetCache::clear() {
+    QMutexLocker locker(&_mutex);
+    _entriesByPath.clear();
+    _entries.clear();
+}
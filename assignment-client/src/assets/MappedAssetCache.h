@@ -0,0 +1,64 @@
+//
+//  MappedAssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedAssetCache_h
+#define hifi_MappedAssetCache_h
+
+#include <list>
+#include <memory>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+/// Read-only memory mapping of an asset file. The mapping stays valid for as long as someone holds on to it,
+/// even after it has been evicted from the MappedAssetCache.
+class MappedAsset {
+public:
+    MappedAsset(const QString& filePath);
+
+    bool isValid() const { return _isValid; }
+
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+/// Thread-safe LRU of open asset mappings, shared by the SendAssetTasks so that concurrent range requests
+/// for a hot asset don't each open and read the file.
+class MappedAssetCache {
+public:
+    static const int DEFAULT_MAX_MAPPINGS = 64;
+
+    MappedAssetCache(int maxMappings = DEFAULT_MAX_MAPPINGS) : _maxMappings(maxMappings) {}
+
+    /// Returns the mapping for the file, mapping it if needed - nullptr if the file can't be opened or mapped
+    std::shared_ptr<const MappedAsset> get(const QString& filePath);
+
+    /// Drop the mapping for a file that is about to be removed
+    void remove(const QString& filePath);
+    void clear();
+
+private:
+    using Entry = std::pair<QString, std::shared_ptr<const MappedAsset>>;
+
+    QMutex _mutex;
+    std::list<Entry> _entries; // most recently used first
+    QHash<QString, std::list<Entry>::iterator> _entriesByPath;
+    int _maxMappings;
+};
+
+#endif // hifi_MappedAssetCache_h
@@ -13,8 +13,6 @@
 
 #include <cmath>
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -26,11 +24,14 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             std::shared_ptr<HotAssetCache> hotAssetCache, std::shared_ptr<MappedAssetCache> mappedAssetCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _hotAssetCache(hotAssetCache),
+    _mappedAssetCache(mappedAssetCache)
 {
     
 }
@@ -65,16 +66,31 @@ void SendAssetTask::run() {
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
         
-        QFile file { filePath };
+        // serve from memory if this is a hot asset, otherwise from a mapping of the file
+        QByteArray cachedAsset;
+        std::shared_ptr<const MappedAsset> mappedAsset;
+        const char* assetData = nullptr;
+        qint64 fileSize = -1;
+
+        if (_hotAssetCache->get(hexHash, cachedAsset)) {
+            assetData = cachedAsset.constData();
+            fileSize = cachedAsset.size();
+        } else if ((mappedAsset = _mappedAssetCache->get(filePath))) {
+            assetData = mappedAsset->getData();
+            fileSize = mappedAsset->getSize();
+
+            // whatever range was asked for, the cache holds whole assets
+            _hotAssetCache->offer(hexHash, assetData, fileSize);
+        }
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (fileSize >= 0) {
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +98,17 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                // a positive range starts at an offset into the file, a negative range is counted back from its end
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+                // slice the data straight out of the cache or the mapping into the reply packets
+                replyPacketList->write(assetData + offset, size);
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -17,15 +17,20 @@
 #include <QtCore/QString>
 #include <QtCore/QRunnable>
 
+#include <memory>
+
 #include "AssetUtils.h"
 #include "AssetServer.h"
+#include "HotAssetCache.h"
+#include "MappedAssetCache.h"
 #include "Node.h"
 
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  std::shared_ptr<HotAssetCache> hotAssetCache, std::shared_ptr<MappedAssetCache> mappedAssetCache);
 
     void run() override;
 
@@ -33,6 +38,8 @@ private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    std::shared_ptr<HotAssetCache> _hotAssetCache;
+    std::shared_ptr<MappedAssetCache> _mappedAssetCache;
 };
 
 #endif
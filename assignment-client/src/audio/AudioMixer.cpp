@@ -44,6 +44,7 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DEFAULT_INAUDIBLE_LEVEL = -48.0f;    // dB, where sources are culled
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -52,6 +53,7 @@ static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
+float AudioMixer::_inaudibleLevel{ DEFAULT_INAUDIBLE_LEVEL };
 map<QString, shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
@@ -282,6 +284,20 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["threads"] = _slavePool.numThreads();
 
+    // load balance of the slave threads, averaged per frame
+    QJsonObject slaveThreadStats;
+    auto workerStats = _slavePool.getWorkerStats();
+    for (int i = 0; i < (int)workerStats.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["us_busy_per_frame"] = (qint64)(workerStats[i].busyUsecs / _numStatFrames);
+        threadStats["us_idle_per_frame"] = (qint64)(workerStats[i].idleUsecs / _numStatFrames);
+        threadStats["jobs_per_frame"] = (float)workerStats[i].numJobs / (float)_numStatFrames;
+        threadStats["steals_per_frame"] = (float)workerStats[i].numSteals / (float)_numStatFrames;
+        slaveThreadStats[QString("thread_%1").arg(i)] = threadStats;
+    }
+    statsObject["slave_threads"] = slaveThreadStats;
+    _slavePool.resetWorkerStats();
+
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
@@ -309,6 +325,9 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
+    timingStats["ns_per_listener_mix"] = (_stats.sumListeners > 0) ?
+        (qint64)(_stats.listenerMixTime / _stats.sumListeners) : 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -330,6 +349,7 @@ void AudioMixer::sendStatsPacket() {
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    mixStats["2_culled_streams"] = (int)(_stats.culled / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
     mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
@@ -338,6 +358,9 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
 
+    mixStats["4_shared_source_frames"] = (int)(_stats.sharedSourceFrames / (float)_numStatFrames);
+    mixStats["4_uncached_source_frames"] = (int)(_stats.uncachedSourceFrames / (float)_numStatFrames);
+
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
@@ -435,10 +458,21 @@ void AudioMixer::start() {
 
             // first clear the concurrent vector of added streams that the slaves will add to when they process packets
             _workerSharedData.addedStreams.clear();
+            _workerSharedData.sourceFrames.clear();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 _slavePool.processPackets(cbegin, cend);
             });
+
+            // index the source frames prepared while processing packets, the slaves share them while mixing
+            _workerSharedData.sourceFramesByStream.clear();
+            _workerSharedData.sourceGrid.clear();
+            for (int i = 0; i < (int)_workerSharedData.sourceFrames.size(); ++i) {
+                const auto& sourceFrame = _workerSharedData.sourceFrames[i];
+                _workerSharedData.sourceFramesByStream[sourceFrame.stream] = &sourceFrame;
+                _workerSharedData.sourceGrid.insert(sourceFrame.stream->getPosition(), i);
+            }
+            _workerSharedData.sourceGrid.build();
         }
 
         // process queued events (networking, global audio packets, &c.)
@@ -461,7 +495,7 @@ void AudioMixer::start() {
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
-            _slavePool.mix(cbegin, cend, frame, numToRetain);
+            _slavePool.mix(cbegin, cend, frame, numToRetain, _batchSends);
         });
 
         // gather stats
@@ -549,6 +583,7 @@ void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
+    _inaudibleLevel = DEFAULT_INAUDIBLE_LEVEL;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
     _zoneSettings.clear();
@@ -588,6 +623,10 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString BATCH_SENDS_KEY = "batch_sends";
+        _batchSends = audioThreadingGroupObject[BATCH_SENDS_KEY].toBool();
+        qCDebug(audio) << "Batched mix sends:" << (_batchSends ? "enabled" : "disabled");
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -674,6 +713,16 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString INAUDIBLE_LEVEL = "inaudible_level";
+        if (audioEnvGroupObject[INAUDIBLE_LEVEL].isString()) {
+            bool ok = false;
+            float inaudibleLevel = audioEnvGroupObject[INAUDIBLE_LEVEL].toString().toFloat(&ok);
+            if (ok) {
+                _inaudibleLevel = std::min(inaudibleLevel, 0.0f);
+                qCDebug(audio) << "Inaudible level changed to" << _inaudibleLevel << "dB";
+            }
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
@@ -53,6 +53,7 @@ public:
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
+    static float getInaudibleLevel() { return _inaudibleLevel; }
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
@@ -141,6 +142,7 @@ private:
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
+    static float _inaudibleLevel; // dB, sources attenuated below it are culled
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
 
@@ -151,6 +153,8 @@ private:
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
 
+    bool _batchSends { false };
+
     AudioMixerSlave::SharedData _workerSharedData;
 };
 
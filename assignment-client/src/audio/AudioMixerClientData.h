@@ -13,6 +13,7 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <unordered_map>
 
 #include <tbb/concurrent_vector.h>
 
@@ -132,6 +133,9 @@ public:
         MixableStreamsVector active;
         MixableStreamsVector inactive;
         MixableStreamsVector skipped;
+
+        // out of audible range, only revisited when the source grid puts them back in range
+        std::unordered_map<const PositionalAudioStream*, MixableStream> culled;
     };
 
     Streams& getStreams() { return _streams; }
@@ -12,6 +12,8 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -21,6 +23,7 @@
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
+#include <PortableHighResolutionClock.h>
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
@@ -35,6 +38,7 @@
 #include "AvatarAudioStream.h"
 #include "InjectedAudioStream.h"
 #include "AudioHelpers.h"
+#include "AudioMixKernels.h"
 
 using namespace std;
 using AudioStreamVector = AudioMixerClientData::AudioStreamVector;
@@ -49,25 +53,82 @@ void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
+void prepareSourceFrame(AudioMixerSlave::SourceFrame& sourceFrame, const PositionalAudioStream& stream);
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
 inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
+float computeAudibleDistance(float attenuationPerDoublingInDistance, float inaudibleLevel);
+
+void prepareSourceFrame(AudioMixerSlave::SourceFrame& sourceFrame, const PositionalAudioStream& stream) {
+    sourceFrame.stream = &stream;
+    sourceFrame.isSilent = false;
+    sourceFrame.fadeGain = 1.0f;
+
+    if (!stream.lastPopSucceeded()) {
+        sourceFrame.isSilent = true;
+
+        if (!stream.getLastPopOutput().isNull()) {
+            bool isInjector = dynamic_cast<const InjectedAudioStream*>(&stream);
+
+            // in an injector, just go silent - the injector has likely ended
+            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
+            if (!isInjector) {
+                // calculate its fade factor, which depends on how many times it's already been repeated.
+                float fadeFactor = calculateRepeatedFrameFadeFactor(stream.getConsecutiveNotMixedCount() - 1);
+                if (fadeFactor > 0.0f) {
+                    sourceFrame.fadeGain = fadeFactor;
+                    sourceFrame.isSilent = false;
+                }
+            }
+        }
+
+        if (sourceFrame.isSilent) {
+            return;
+        }
+    }
+
+    // grab the stream from the ring buffer
+    AudioRingBuffer::ConstIterator streamPopOutput = stream.getLastPopOutput();
+    streamPopOutput.readSamples(sourceFrame.samples, stream.isStereo() ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
+                                                                      : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+}
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
         // process packets and collect the number of streams available for this frame
         stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+
+        // read this frame's audio out of each of the node's streams, once for all listeners
+        for (const auto& stream : data->getAudioStreams()) {
+            auto sourceFrame = _sharedData.sourceFrames.grow_by(1);
+            sourceFrame->nodeLocalID = node->getLocalID();
+            sourceFrame->streamID = stream->getStreamIdentifier();
+            prepareSourceFrame(*sourceFrame, *stream);
+        }
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain,
+                                   bool batchSends) {
     _begin = begin;
     _end = end;
     _frame = frame;
     _numToRetain = numToRetain;
+    _batchSends = batchSends;
+
+    if (_batchSends) {
+        DependencyManager::get<NodeList>()->beginSendBatch();
+    }
+}
+
+void AudioMixerSlave::finishMix() {
+    if (_batchSends) {
+        DependencyManager::get<NodeList>()->flushSendBatch();
+        _batchSends = false;
+    }
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -286,6 +347,124 @@ bool shouldBeSkipped(MixableStream& stream, const Node& listener,
     return false;
 };
 
+void AudioMixerSlave::cullStreams(Node& listener, AudioMixerClientData& listenerData,
+                                  const AvatarAudioStream& listenerAudioStream, bool isSoloing) {
+    auto& streams = listenerData.getStreams();
+
+    // culled streams are not visited by the passes in prepareMix, drop the removed ones here
+    if (!streams.culled.empty() && (!_sharedData.removedNodes.empty() || !_sharedData.removedStreams.empty())) {
+        for (auto it = streams.culled.begin(); it != streams.culled.end();) {
+            it = shouldBeRemoved(it->second, _sharedData) ? streams.culled.erase(it) : std::next(it);
+        }
+    }
+
+    auto restore = [&](MixableStream& stream) {
+        // ignore changes were not applied while the stream was culled, start over from the current sets
+        stream.ignoredByListener = contains(listener.getIgnoredNodeIDs(), stream.nodeStreamID.nodeID);
+        stream.ignoringListener = contains(listenerData.getIgnoringNodeIDs(), stream.nodeStreamID.nodeID);
+
+        // the skipped pass sorts it into the right vector
+        streams.skipped.push_back(move(stream));
+    };
+
+    glm::vec3 listenerPosition = listenerAudioStream.getPosition();
+    float inaudibleLevel = AudioMixer::getInaudibleLevel();
+    float audibleDistance = computeAudibleDistance(AudioMixer::getAttenuationPerDoublingInDistance(), inaudibleLevel);
+
+    // soloed sources are heard at any distance
+    if (isSoloing || !std::isfinite(audibleDistance)) {
+        for (auto& culledStream : streams.culled) {
+            restore(culledStream.second);
+        }
+        streams.culled.clear();
+        return;
+    }
+
+    // zone settings for the listener's zone override the audible distance of the sources in the source zone
+    auto& audioZones = AudioMixer::getAudioZones();
+    _audibleZones.clear();
+    for (const auto& settings : AudioMixer::getZoneSettings()) {
+        if (audioZones[settings.listener].area.contains(listenerPosition)) {
+            _audibleZones.push_back({ audioZones[settings.source].area, computeAudibleDistance(settings.coefficient, inaudibleLevel) });
+        }
+    }
+
+    auto isAudible = [&](const glm::vec3& sourcePosition) {
+        // the first matching zone wins, as in computeGain
+        float distance = audibleDistance;
+        for (const auto& zone : _audibleZones) {
+            if (zone.sourceArea.contains(sourcePosition)) {
+                distance = zone.distance;
+                break;
+            }
+        }
+        return glm::distance(sourcePosition, listenerPosition) <= distance;
+    };
+
+    // move the streams that went out of range to the culled set
+    auto cull = [&](MixableStreamsVector& vector) {
+        erase_if(vector, [&](MixableStream& stream) {
+            if (shouldBeRemoved(stream, _sharedData) || stream.nodeStreamID.nodeLocalID == listener.getLocalID() ||
+                isAudible(stream.positionalStream->getPosition())) {
+                return false;
+            }
+
+            resetHRTFState(stream);
+
+            auto positionalStream = stream.positionalStream;
+            streams.culled.erase(positionalStream);
+            streams.culled.emplace(positionalStream, move(stream));
+            return true;
+        });
+    };
+    cull(streams.skipped);
+    cull(streams.inactive);
+    cull(streams.active);
+
+    if (streams.culled.empty()) {
+        return;
+    }
+
+    // bring back the culled streams that are in range again, only looking at the sources in nearby cells
+    auto uncull = [&](const glm::vec3& minimum, const glm::vec3& maximum) {
+        _sharedData.sourceGrid.query(minimum, maximum, [&](int source) {
+            const SourceFrame& sourceFrame = _sharedData.sourceFrames[source];
+            auto it = streams.culled.find(sourceFrame.stream);
+            if (it == streams.culled.end()) {
+                return;
+            }
+
+            if (it->second.nodeStreamID.nodeLocalID != sourceFrame.nodeLocalID ||
+                it->second.nodeStreamID.streamID != sourceFrame.streamID) {
+                // left over from a deleted stream, the address has been reused
+                streams.culled.erase(it);
+                return;
+            }
+
+            if (isAudible(sourceFrame.stream->getPosition())) {
+                restore(it->second);
+                streams.culled.erase(it);
+            }
+        });
+    };
+
+    glm::vec3 range(audibleDistance);
+    uncull(listenerPosition - range, listenerPosition + range);
+
+    for (const auto& zone : _audibleZones) {
+        glm::vec3 minimum = zone.sourceArea.getMinimumPoint();
+        glm::vec3 maximum = zone.sourceArea.getMaximumPoint();
+        if (std::isfinite(zone.distance)) {
+            glm::vec3 zoneRange(zone.distance);
+            minimum = glm::max(minimum, listenerPosition - zoneRange);
+            maximum = glm::min(maximum, listenerPosition + zoneRange);
+        }
+        if (glm::all(glm::lessThanEqual(minimum, maximum))) {
+            uncull(minimum, maximum);
+        }
+    }
+}
+
 float approximateVolume(const MixableStream& stream, const AvatarAudioStream* listenerAudioStream) {
     if (stream.positionalStream->getLastPopOutputTrailingLoudness() == 0.0f) {
         return 0.0f;
@@ -310,6 +489,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
+    auto listenerMixStart = p_high_resolution_clock::now();
+
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
@@ -320,6 +501,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     addStreams(*listener, *listenerData);
 
+    cullStreams(*listener, *listenerData, *listenerAudioStream, isSoloing);
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -463,6 +646,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
+    stats.culled += (int)streams.culled.size();
 
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
@@ -475,17 +659,14 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
-    bool hasAudio = false;
-    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-        if (_mixSamples[i] != 0.0f) {
-            hasAudio = true;
-            break;
-        }
-    }
+    bool hasAudio = hasNonZeroSamples(_mixSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
     // use the per listener AudioLimiter to render the mixed data
     listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
+    auto listenerMixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - listenerMixStart);
+    stats.listenerMixTime += listenerMixTime.count();
+
     return hasAudio;
 }
 
@@ -512,69 +693,57 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
     const int HRTF_DATASET_INDEX = 1;
 
-    if (!streamToAdd->lastPopSucceeded()) {
-        bool forceSilentBlock = true;
+    const SourceFrame& sourceFrame = getSourceFrame(*streamToAdd);
 
-        if (!streamToAdd->getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
+    if (sourceFrame.isSilent) {
+        // call renderSilent with a forced silent block to reduce artifacts
+        // (this is not done for stereo streams since they do not go through the HRTF)
+        if (!streamToAdd->isStereo() && !isEcho) {
+            static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+            mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-            // in an injector, just go silent - the injector has likely ended
-            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
-            if (!isInjector) {
-                // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd->getConsecutiveNotMixedCount() - 1);
-                if (fadeFactor > 0.0f) {
-                    // apply the fadeFactor to the gain
-                    gain *= fadeFactor;
-                    forceSilentBlock = false;
-                }
-            }
+            ++stats.hrtfRenders;
         }
 
-        if (forceSilentBlock) {
-            // call renderSilent with a forced silent block to reduce artifacts
-            // (this is not done for stereo streams since they do not go through the HRTF)
-            if (!streamToAdd->isStereo() && !isEcho) {
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-                ++stats.hrtfRenders;
-            }
-
-            return;
-        }
+        return;
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
+    gain *= sourceFrame.fadeGain;
 
     if (streamToAdd->isStereo()) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
-
         // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixStereo(sourceFrame.samples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
         // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixMono(sourceFrame.samples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
     } else {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+        mixableStream.hrtf->render(sourceFrame.samples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         ++stats.hrtfRenders;
     }
 }
 
+const AudioMixerSlave::SourceFrame& AudioMixerSlave::getSourceFrame(const PositionalAudioStream& stream) {
+    auto it = _sharedData.sourceFramesByStream.find(&stream);
+    if (it != _sharedData.sourceFramesByStream.end()) {
+        ++stats.sharedSourceFrames;
+        return *it->second;
+    }
+
+    // the stream was not around when the frame's sources were prepared, read it for this listener only
+    prepareSourceFrame(_uncachedSourceFrame, stream);
+    ++stats.uncachedSourceFrames;
+    return _uncachedSourceFrame;
+}
+
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                            AvatarAudioStream& listeningNodeStream,
                                            float masterAvatarGain,
@@ -797,6 +966,27 @@ float computeGain(float masterAvatarGain,
     return gain;
 }
 
+float computeAudibleDistance(float attenuationPerDoublingInDistance, float inaudibleLevel) {
+    if (attenuationPerDoublingInDistance < 0.0f) {
+        // linear attenuation is silent past the distance limit
+        const float MIN_DISTANCE_LIMIT = ATTN_DISTANCE_REF + 1.0f;
+        return std::max(-attenuationPerDoublingInDistance, MIN_DISTANCE_LIMIT);
+    }
+
+    // logarithmic attenuation never reaches silence, stop where it drops below the inaudible level
+    // (at the default -48dB and 0.5 attenuation, that is 500m; at -90dB it would be 65km)
+    const float MIN_ATTENUATION_COEFFICIENT = 0.001f;
+    float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, MIN_ATTENUATION_COEFFICIENT, 1.0f);
+    if (g >= 1.0f || inaudibleLevel >= 0.0f) {
+        return std::numeric_limits<float>::infinity();
+    }
+    const float DB_PER_DOUBLING = 6.02059991f;
+    float log2InaudibleGain = inaudibleLevel / DB_PER_DOUBLING;
+
+    // exp2 overflows to infinity for very gentle attenuations
+    return ATTN_DISTANCE_REF * exp2f(log2InaudibleGain / log2f(g));
+}
+
 float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
                      const PositionalAudioStream& streamToAdd,
                      const glm::vec3& relativePosition) {
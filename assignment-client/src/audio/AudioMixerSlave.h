@@ -12,6 +12,8 @@
 #ifndef hifi_AudioMixerSlave_h
 #define hifi_AudioMixerSlave_h
 
+#include <unordered_map>
+
 #include <tbb/concurrent_vector.h>
 
 #include <AABox.h>
@@ -24,6 +26,7 @@
 
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
+#include "AudioSourceGrid.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
@@ -32,10 +35,25 @@ class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
     
+    // a source's audio for this frame, read out of its ring buffer once and shared by every listener
+    struct SourceFrame {
+        const PositionalAudioStream* stream { nullptr };
+        Node::LocalID nodeLocalID { 0 };
+        StreamID streamID;
+        bool isSilent { true }; // nothing to mix, the listeners only flush their HRTF
+        float fadeGain { 1.0f }; // fade out of a repeated frame after a failed pop
+        int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    };
+
     struct SharedData {
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+
+        // filled by the slaves while processing packets, indexed once before mixing
+        tbb::concurrent_vector<SourceFrame> sourceFrames;
+        std::unordered_map<const PositionalAudioStream*, const SourceFrame*> sourceFramesByStream;
+        AudioSourceGrid sourceGrid; // indexes into sourceFrames
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -43,13 +61,16 @@ public:
     // process packets for a given node (requires no configuration)
     void processPackets(const SharedNodePointer& node);
 
-    // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain);
+    // configure a round of mixing, optionally holding back this thread's sends until finishMix
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain, bool batchSends);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
     void mix(const SharedNodePointer& node);
 
+    // flush any sends batched during this round of mixing
+    void finishMix();
+
     AudioMixerStats stats;
 
 private:
@@ -65,18 +86,30 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    const SourceFrame& getSourceFrame(const PositionalAudioStream& stream);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
+    void cullStreams(Node& listener, AudioMixerClientData& listenerData, const AvatarAudioStream& listenerAudioStream,
+                     bool isSoloing);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    SourceFrame _uncachedSourceFrame;
+
+    // source zones whose audible distance is overridden for the current listener
+    struct AudibleZone {
+        AABox sourceArea;
+        float distance;
+    };
+    std::vector<AudibleZone> _audibleZones;
 
     // frame state
     ConstIter _begin;
     ConstIter _end;
     unsigned int _frame { 0 };
     int _numToRetain { -1 };
+    bool _batchSends { false };
 
     SharedData& _sharedData;
 };
@@ -18,10 +18,13 @@ void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        // run nodes until there are none left, here or on the other threads
+        _pool._scheduler.run(_index, [&](int job) {
+            (this->*_function)(_pool._nodes[job]);
+        });
+
+        if (_pool._finalize) {
+            _pool._finalize(*this);
         }
 
         bool stopping = _stop;
@@ -60,33 +63,38 @@ void AudioMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
-
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    _finalize = [](AudioMixerSlave& slave) {};
+    run(begin, end, _packetCosts);
 }
 
-void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
+void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain, bool batchSends) {
     _function = &AudioMixerSlave::mix;
     _configure = [=](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, frame, numToRetain);
+        slave.configureMix(_begin, _end, frame, numToRetain, batchSends);
+    };
+    _finalize = [](AudioMixerSlave& slave) {
+        slave.finishMix();
     };
 
-    run(begin, end);
+    run(begin, end, _mixCosts);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, Costs& costs) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
+    // deal the nodes out to the slaves, weighted by how long each took last frame
+    _nodes.clear();
+    _nodeCosts.clear();
     std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+        auto cost = costs.find(node->getLocalID());
+        _nodes.push_back(node);
+        _nodeCosts.push_back(cost != costs.end() ? cost->second : 0.0f);
     });
+    _scheduler.schedule(_nodeCosts);
 
     {
         Lock lock(_mutex);
@@ -104,7 +112,13 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    _scheduler.finish();
+
+    costs.clear();
+    for (int i = 0; i < (int)_nodes.size(); ++i) {
+        costs[_nodes[i]->getLocalID()] = _scheduler.getJobCost(i);
+    }
+    _nodes.clear();
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -156,7 +170,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData, (int)_slaves.size());
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -196,4 +210,6 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
     _numThreads = _numStarted = _numFinished = numThreads;
     assert(_numThreads == (int)_slaves.size());
+
+    _scheduler.setNumWorkers(numThreads);
 }
@@ -14,11 +14,12 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <WorkStealingScheduler.h>
 
 #include "AudioMixerSlave.h"
 
@@ -31,8 +32,8 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData, int index)
+        : AudioMixerSlave(sharedData), _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -41,9 +42,9 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
 
     AudioMixerSlavePool& _pool;
+    const int _index; // worker index in the pool's scheduler
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
 };
@@ -51,7 +52,7 @@ private:
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
+    using Costs = std::unordered_map<Node::LocalID, float>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -66,8 +67,8 @@ public:
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
 
-    // mix on slave threads
-    void mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain);
+    // mix on slave threads, batching each slave's sends for the frame if requested
+    void mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain, bool batchSends = false);
 
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
@@ -79,15 +80,19 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
+    // load balance of the slave threads since the last reset
+    std::vector<WorkStealingScheduler::WorkerStats> getWorkerStats() const { return _scheduler.getWorkerStats(); }
+    void resetWorkerStats() { _scheduler.resetWorkerStats(); }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, Costs& costs);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend void AudioMixerSlaveThread::run();
 
     // synchronization state
     Mutex _mutex;
@@ -95,16 +100,23 @@ private:
     ConditionVariable _poolCondition;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
     std::function<void(AudioMixerSlave&)> _configure;
+    std::function<void(AudioMixerSlave&)> _finalize;
     int _numThreads { 0 };
     int _numStarted { 0 }; // guarded by _mutex
     int _numFinished { 0 }; // guarded by _mutex
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    WorkStealingScheduler _scheduler;
+    std::vector<SharedNodePointer> _nodes;
+    std::vector<float> _nodeCosts;
     ConstIter _begin;
     ConstIter _end;
 
+    // time each node took last frame, the cost estimate for the next
+    Costs _packetCosts;
+    Costs _mixCosts;
+
     AudioMixerSlave::SharedData& _workerSharedData;
 };
 
@@ -35,6 +35,12 @@ void AudioMixerStats::reset() {
     skipped = 0;
     inactive = 0;
     active = 0;
+    culled = 0;
+
+    sharedSourceFrames = 0;
+    uncachedSourceFrames = 0;
+
+    listenerMixTime = 0;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
@@ -65,6 +71,12 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    culled += otherStats.culled;
+
+    sharedSourceFrames += otherStats.sharedSourceFrames;
+    uncachedSourceFrames += otherStats.uncachedSourceFrames;
+
+    listenerMixTime += otherStats.listenerMixTime;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
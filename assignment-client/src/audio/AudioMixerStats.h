@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -40,6 +38,12 @@ struct AudioMixerStats {
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int culled { 0 };
+
+    int sharedSourceFrames { 0 };
+    int uncachedSourceFrames { 0 };
+
+    uint64_t listenerMixTime { 0 }; // ns spent preparing listener mixes
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
@@ -0,0 +1,65 @@
+//
+//  AudioSourceGrid.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSourceGrid.h"
+
+#include <algorithm>
+
+// cell coordinates are packed in 21 bits each
+static const int CELL_BITS = 21;
+static const int CELL_MIN = -(1 << (CELL_BITS - 1));
+static const int CELL_MAX = (1 << (CELL_BITS - 1)) - 1;
+static const uint64_t CELL_MASK = (1ULL << CELL_BITS) - 1;
+
+constexpr float AudioSourceGrid::CELL_SIZE;
+
+void AudioSourceGrid::clear() {
+    // keep the allocations around for the next frame
+    _entries.clear();
+    _cells.clear();
+}
+
+void AudioSourceGrid::insert(const glm::vec3& position, int source) {
+    _entries.emplace_back(keyFor(cellFor(position)), source);
+}
+
+void AudioSourceGrid::build() {
+    std::sort(_entries.begin(), _entries.end());
+
+    int begin = 0;
+    for (int i = 1; i <= (int)_entries.size(); ++i) {
+        if (i == (int)_entries.size() || _entries[i].first != _entries[begin].first) {
+            _cells[_entries[begin].first] = { begin, i };
+            begin = i;
+        }
+    }
+}
+
+AudioSourceGrid::Cell AudioSourceGrid::cellFor(const glm::vec3& position) {
+    glm::vec3 cell = glm::floor(position * (1.0f / CELL_SIZE));
+    if (glm::any(glm::isnan(cell))) {
+        return Cell(0);
+    }
+
+    // clamp in float, positions far outside of the grid must not overflow the conversion
+    return Cell(glm::clamp(cell, glm::vec3((float)CELL_MIN), glm::vec3((float)CELL_MAX)));
+}
+
+AudioSourceGrid::CellKey AudioSourceGrid::keyFor(const Cell& cell) {
+    return ((uint64_t)(cell.x - CELL_MIN) << (2 * CELL_BITS)) |
+           ((uint64_t)(cell.y - CELL_MIN) << CELL_BITS) |
+           (uint64_t)(cell.z - CELL_MIN);
+}
+
+AudioSourceGrid::Cell AudioSourceGrid::cellForKey(CellKey key) {
+    return Cell((int)((key >> (2 * CELL_BITS)) & CELL_MASK) + CELL_MIN,
+                (int)((key >> CELL_BITS) & CELL_MASK) + CELL_MIN,
+                (int)(key & CELL_MASK) + CELL_MIN);
+}
@@ -0,0 +1,94 @@
+//
+//  AudioSourceGrid.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSourceGrid_h
+#define hifi_AudioSourceGrid_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// Uniform spatial hash of the audio sources of a frame, so that a listener only has to look at the sources in the
+/// cells around it. It is rebuilt once per frame on the mixer thread and then only read by the slaves.
+class AudioSourceGrid {
+public:
+    static constexpr float CELL_SIZE = 16.0f; // meters
+
+    void clear();
+
+    // sources are identified by their index in the frame's source list
+    void insert(const glm::vec3& position, int source);
+
+    // sort the sources into their cells, call once after all the sources are inserted
+    void build();
+
+    // calls functor(source) for every source in the cells touching the box, and possibly some more
+    template <typename F>
+    void query(const glm::vec3& minimum, const glm::vec3& maximum, F functor) const;
+
+    int getNumSources() const { return (int)_entries.size(); }
+
+private:
+    using CellKey = uint64_t;
+    using Cell = glm::ivec3;
+
+    static Cell cellFor(const glm::vec3& position);
+    static CellKey keyFor(const Cell& cell);
+    static Cell cellForKey(CellKey key);
+
+    template <typename F>
+    void visitCell(CellKey key, F& functor) const;
+
+    std::vector<std::pair<CellKey, int>> _entries; // sorted by cell after build()
+    std::unordered_map<CellKey, std::pair<int, int>> _cells; // range of _entries in each cell
+};
+
+template <typename F>
+void AudioSourceGrid::visitCell(CellKey key, F& functor) const {
+    auto it = _cells.find(key);
+    if (it != _cells.end()) {
+        for (int i = it->second.first; i < it->second.second; ++i) {
+            functor(_entries[i].second);
+        }
+    }
+}
+
+template <typename F>
+void AudioSourceGrid::query(const glm::vec3& minimum, const glm::vec3& maximum, F functor) const {
+    Cell minCell = cellFor(minimum);
+    Cell maxCell = cellFor(maximum);
+    double numCells = (double)(maxCell.x - minCell.x + 1) * (maxCell.y - minCell.y + 1) * (maxCell.z - minCell.z + 1);
+
+    if (numCells > (double)_cells.size()) {
+        // the box covers more cells than there are occupied ones, walk those instead
+        for (const auto& cell : _cells) {
+            Cell coordinates = cellForKey(cell.first);
+            if (glm::all(glm::greaterThanEqual(coordinates, minCell)) && glm::all(glm::lessThanEqual(coordinates, maxCell))) {
+                for (int i = cell.second.first; i < cell.second.second; ++i) {
+                    functor(_entries[i].second);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
+                visitCell(keyFor(Cell(x, y, z)), functor);
+            }
+        }
+    }
+}
+
+#endif // hifi_AudioSourceGrid_h
@@ -0,0 +1,47 @@
+//
+//  AvatarEncodeCache.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEncodeCache.h"
+
+#include <cassert>
+
+void AvatarEncodeCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _encodings.clear();
+}
+
+AvatarEncodeCache::Encoding AvatarEncodeCache::get(NetworkPeer::LocalID sourceID, const AvatarData& avatar,
+                                                   AvatarData::AvatarDataDetail detail, bool dropFaceTracking,
+                                                   bool& wasCached) {
+    assert(isListenerIndependent(detail));
+    uint32_t key = ((uint32_t)sourceID << 16) | ((uint32_t)detail << 1) | (dropFaceTracking ? 1 : 0);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _encodings.find(key);
+        if (found != _encodings.end()) {
+            wasCached = true;
+            // the copies share the data with the cached encoding
+            return found->second;
+        }
+    }
+    wasCached = false;
+
+    // encode outside of the lock, two slaves may encode the same avatar at once but they get the same bytes -
+    // the joints baseline is never read at these details, and is resized to the avatar's joints before it is written
+    Encoding encoding;
+    AvatarDataPacket::SendStatus sendStatus;
+    sendStatus.sendUUID = true;
+    encoding.bytes = avatar.toByteArray(detail, 0, encoding.sentJoints, sendStatus, dropFaceTracking, false, glm::vec3(0),
+                                        &encoding.sentJoints, 0, nullptr, &encoding.keyframe);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _encodings.emplace(key, encoding);
+    return encoding;
+}
@@ -0,0 +1,53 @@
+//
+//  AvatarEncodeCache.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEncodeCache_h
+#define hifi_AvatarEncodeCache_h
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <QByteArray>
+#include <QVector>
+
+#include <AvatarData.h>
+#include <NetworkPeer.h>
+
+/// The avatar data of a frame encoded once per avatar and detail, for the details whose encoding does not depend on
+/// what the listener was sent before, so that the slaves copy the same bytes to every listener instead of packing
+/// the avatar's joints again for each of them.
+///
+/// It is cleared once per frame on the mixer thread, and then shared by the slaves.
+class AvatarEncodeCache {
+public:
+    struct Encoding {
+        QByteArray bytes; // the whole encoding, starting with the session UUID
+        QVector<JointData> sentJoints; // what a listener was sent of the joints, for the next joint deltas
+        JointDeltas::Keyframe keyframe; // of the joint deltas that follow, if the encoding holds all of the joints
+    };
+
+    // encodings at other details are culled against the listener's last sent joints and encode time
+    static bool isListenerIndependent(AvatarData::AvatarDataDetail detail) {
+        return detail == AvatarData::SendAllData || detail == AvatarData::PALMinimum;
+    }
+
+    void clear();
+
+    // the avatar's encoding at a listener independent detail, encoded by the first slave that asks for it this frame
+    Encoding get(NetworkPeer::LocalID sourceID, const AvatarData& avatar, AvatarData::AvatarDataDetail detail,
+                 bool dropFaceTracking, bool& wasCached);
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<uint32_t, Encoding> _encodings;
+};
+
+#endif // hifi_AvatarEncodeCache_h
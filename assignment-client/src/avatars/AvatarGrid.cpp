@@ -0,0 +1,89 @@
+//
+//  AvatarGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarGrid.h"
+
+constexpr float AvatarGrid::MIN_CELL_SIZE;
+
+// listeners far outside of the grid are clamped to this many cells away, which keeps the conversion safe
+static const float MAX_CELL_DISTANCE = 1.0e6f;
+
+void AvatarGrid::clear() {
+    // keep the allocations around for the next frame
+    _inserted.clear();
+    _avatars.clear();
+    _cellStarts.clear();
+    _heroes.clear();
+    _numCellsX = _numCellsZ = 0;
+}
+
+void AvatarGrid::insert(const Node* node, const glm::vec3& position, bool isHero) {
+    if (isHero) {
+        _heroes.push_back(node);
+    } else if (glm::any(glm::isnan(position)) || glm::any(glm::isinf(position))) {
+        _inserted.emplace_back(node, glm::vec3(0.0f));
+    } else {
+        _inserted.emplace_back(node, position);
+    }
+}
+
+void AvatarGrid::build() {
+    ++_generation;
+    if (_inserted.empty()) {
+        return;
+    }
+
+    glm::vec2 minimum(_inserted.front().second.x, _inserted.front().second.z);
+    glm::vec2 maximum = minimum;
+    for (const auto& avatar : _inserted) {
+        glm::vec2 position(avatar.second.x, avatar.second.z);
+        minimum = glm::min(minimum, position);
+        maximum = glm::max(maximum, position);
+    }
+
+    // grow the cells with the occupied bounds, so that there is never more than a bounded number of them to walk
+    glm::vec2 extent = maximum - minimum;
+    _origin = minimum;
+    _cellSize = std::max(MIN_CELL_SIZE, std::max(extent.x, extent.y) / (float)MAX_CELLS_PER_SIDE);
+    _numCellsX = std::min((int)(extent.x / _cellSize) + 1, MAX_CELLS_PER_SIDE);
+    _numCellsZ = std::min((int)(extent.y / _cellSize) + 1, MAX_CELLS_PER_SIDE);
+
+    // counting sort of the avatars into their cells
+    int numCells = _numCellsX * _numCellsZ;
+    _cellStarts.assign(numCells + 1, 0);
+    _avatars.resize(_inserted.size());
+
+    std::vector<Cell> cells;
+    cells.reserve(_inserted.size());
+    for (const auto& avatar : _inserted) {
+        Cell cell = cellFor(avatar.second);
+        cell.x = std::min(std::max(cell.x, 0), _numCellsX - 1);
+        cell.z = std::min(std::max(cell.z, 0), _numCellsZ - 1);
+        cells.push_back(cell);
+        ++_cellStarts[indexFor(cell.x, cell.z) + 1];
+    }
+    for (int i = 0; i < numCells; ++i) {
+        _cellStarts[i + 1] += _cellStarts[i];
+    }
+
+    std::vector<int> next(_cellStarts.begin(), _cellStarts.end() - 1);
+    for (int i = 0; i < (int)_inserted.size(); ++i) {
+        _avatars[next[indexFor(cells[i].x, cells[i].z)]++] = { _inserted[i].first, cells[i] };
+    }
+}
+
+AvatarGrid::Cell AvatarGrid::cellFor(const glm::vec3& position) const {
+    glm::vec2 cell = glm::floor((glm::vec2(position.x, position.z) - _origin) / _cellSize);
+    if (glm::any(glm::isnan(cell))) {
+        return { 0, 0 };
+    }
+    cell = glm::clamp(cell, glm::vec2(-MAX_CELL_DISTANCE), glm::vec2(MAX_CELL_DISTANCE));
+    return { (int)cell.x, (int)cell.y };
+}
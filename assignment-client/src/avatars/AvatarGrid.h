@@ -0,0 +1,158 @@
+//
+//  AvatarGrid.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarGrid_h
+#define hifi_AvatarGrid_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class Node;
+
+/// Grid of the avatars of a frame over the horizontal plane, so that a listener can gather the other avatars in
+/// near-to-far order and stop once it has enough, instead of sorting every avatar in the domain.
+///
+/// The grid only covers the occupied bounds of the domain, and its cells grow with the bounds so that walking the
+/// whole grid stays cheap. Heroes are kept aside, they are considered by every listener regardless of distance.
+///
+/// It is rebuilt once per frame on the mixer thread and then only read by the slaves.
+class AvatarGrid {
+public:
+    static constexpr float MIN_CELL_SIZE = 16.0f; // meters
+    static const int MAX_CELLS_PER_SIDE = 64;
+
+    void clear();
+    void insert(const Node* node, const glm::vec3& position, bool isHero);
+
+    // sort the avatars into their cells, call once after all the avatars are inserted
+    void build();
+
+    const std::vector<const Node*>& getHeroes() const { return _heroes; }
+    int getNumAvatars() const { return (int)_avatars.size(); } // not counting heroes
+    uint32_t getGeneration() const { return _generation; }
+
+    // number of rings around a cell that cover at least the given distance
+    int ringsFor(float distance) const { return (int)std::ceil(distance / _cellSize); }
+
+    // calls functor(node) for every avatar, ring of cells after ring of cells outward from the position, checking
+    // shouldStop(ring) after each ring past minRings - returns the last ring visited
+    template <typename F, typename S>
+    int queryNearToFar(const glm::vec3& position, int minRings, F functor, S shouldStop) const;
+
+    // calls functor(node) for count avatars from first on, wrapping around, that lie beyond rings of the position
+    template <typename F>
+    void queryBeyond(const glm::vec3& position, int rings, uint32_t first, int count, F functor) const;
+
+private:
+    struct Cell {
+        int x;
+        int z;
+    };
+
+    struct Avatar {
+        const Node* node;
+        Cell cell;
+    };
+
+    Cell cellFor(const glm::vec3& position) const;
+    int indexFor(int x, int z) const { return z * _numCellsX + x; }
+
+    template <typename F>
+    void visitCell(int x, int z, F& functor) const;
+
+    std::vector<std::pair<const Node*, glm::vec3>> _inserted;
+    std::vector<Avatar> _avatars; // sorted by cell after build()
+    std::vector<int> _cellStarts; // range of _avatars in each cell, numCells + 1 entries
+    std::vector<const Node*> _heroes;
+
+    glm::vec2 _origin { 0.0f };
+    float _cellSize { MIN_CELL_SIZE };
+    int _numCellsX { 0 };
+    int _numCellsZ { 0 };
+    uint32_t _generation { 0 };
+};
+
+template <typename F>
+void AvatarGrid::visitCell(int x, int z, F& functor) const {
+    int cell = indexFor(x, z);
+    for (int i = _cellStarts[cell]; i < _cellStarts[cell + 1]; ++i) {
+        functor(_avatars[i].node);
+    }
+}
+
+template <typename F, typename S>
+int AvatarGrid::queryNearToFar(const glm::vec3& position, int minRings, F functor, S shouldStop) const {
+    if (_avatars.empty()) {
+        return 0;
+    }
+
+    // the position may lie outside of the grid, start at the first ring that reaches it
+    Cell center = cellFor(position);
+    int firstRing = std::max({ -center.x, center.x - (_numCellsX - 1), -center.z, center.z - (_numCellsZ - 1), 0 });
+    int lastRing = std::max({ center.x, _numCellsX - 1 - center.x, center.z, _numCellsZ - 1 - center.z });
+
+    int ring = firstRing;
+    for (; ring <= lastRing; ++ring) {
+        int minX = std::max(center.x - ring, 0);
+        int maxX = std::min(center.x + ring, _numCellsX - 1);
+        int minZ = std::max(center.z - ring + 1, 0);
+        int maxZ = std::min(center.z + ring - 1, _numCellsZ - 1);
+
+        // top and bottom rows, then the left and right columns in between
+        if (center.z - ring >= 0) {
+            for (int x = minX; x <= maxX; ++x) {
+                visitCell(x, center.z - ring, functor);
+            }
+        }
+        if (ring > 0 && center.z + ring < _numCellsZ) {
+            for (int x = minX; x <= maxX; ++x) {
+                visitCell(x, center.z + ring, functor);
+            }
+        }
+        if (ring > 0 && center.x - ring >= 0) {
+            for (int z = minZ; z <= maxZ; ++z) {
+                visitCell(center.x - ring, z, functor);
+            }
+        }
+        if (ring > 0 && center.x + ring < _numCellsX) {
+            for (int z = minZ; z <= maxZ; ++z) {
+                visitCell(center.x + ring, z, functor);
+            }
+        }
+
+        if (ring >= minRings && shouldStop(ring)) {
+            break;
+        }
+    }
+    return std::min(ring, lastRing);
+}
+
+template <typename F>
+void AvatarGrid::queryBeyond(const glm::vec3& position, int rings, uint32_t first, int count, F functor) const {
+    int numAvatars = (int)_avatars.size();
+    if (numAvatars == 0) {
+        return;
+    }
+
+    Cell center = cellFor(position);
+    count = std::min(count, numAvatars);
+    for (int i = 0; i < count; ++i) {
+        const Avatar& avatar = _avatars[(first + (uint32_t)i) % (uint32_t)numAvatars];
+        if (std::max(std::abs(avatar.cell.x - center.x), std::abs(avatar.cell.z - center.z)) > rings) {
+            functor(avatar.node);
+        }
+    }
+}
+
+#endif // hifi_AvatarGrid_h
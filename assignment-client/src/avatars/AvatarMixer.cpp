@@ -322,7 +322,21 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
-                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+
+                // index the avatars by position, the slaves share the grid to find the avatars near each listener
+                _slaveSharedData.avatarGrid.clear();
+                std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+                    if (node->getType() == NodeType::Agent && node->getLinkedData()) {
+                        const auto& avatar = static_cast<AvatarMixerClientData*>(node->getLinkedData())->getAvatar();
+                        _slaveSharedData.avatarGrid.insert(node.data(), avatar.getClientGlobalPosition(),
+                                                           avatar.getHasPriority());
+                    }
+                });
+                _slaveSharedData.avatarGrid.build();
+                _slaveSharedData.encodeCache.clear();
+
+                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio,
+                                               _batchSends);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
@@ -753,6 +767,20 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["broadcast_loop_rate"] = _loopRate.rate();
     statsObject["threads"] = _slavePool.numThreads();
+
+    // load balance of the slave threads, averaged per tight loop frame
+    QJsonObject slaveThreadStats;
+    auto workerStats = _slavePool.getWorkerStats();
+    for (int i = 0; i < (int)workerStats.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["us_busy_per_frame"] = (qint64)(workerStats[i].busyUsecs / _numTightLoopFrames);
+        threadStats["us_idle_per_frame"] = (qint64)(workerStats[i].idleUsecs / _numTightLoopFrames);
+        threadStats["jobs_per_frame"] = (float)workerStats[i].numJobs / (float)_numTightLoopFrames;
+        threadStats["steals_per_frame"] = (float)workerStats[i].numSteals / (float)_numTightLoopFrames;
+        slaveThreadStats[QString("thread_%1").arg(i)] = threadStats;
+    }
+    statsObject["slave_threads"] = slaveThreadStats;
+    _slavePool.resetWorkerStats();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
@@ -838,6 +866,11 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    float averageOthersCulled = averageNodes ? aggregateStats.numOthersCulled / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageOthersCulled"] = TIGHT_LOOP_STAT(averageOthersCulled);
+    int numEncodes = aggregateStats.numEncodeCacheHits + aggregateStats.numEncodeCacheMisses;
+    slavesAggregatObject["sent_9_encodeCacheHitRate"] = numEncodes ?
+        (float)aggregateStats.numEncodeCacheHits / (float)numEncodes : 0.0f;
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -1020,6 +1053,19 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {
+        const QString BATCH_SENDS = "batch_sends";
+        _batchSends = avatarMixerGroupObject[BATCH_SENDS].toBool();
+        qCDebug(avatars) << "Avatar mixer batched sends:" << (_batchSends ? "enabled" : "disabled");
+    }
+
+    {
+        const QString JOINT_DELTAS = "joint_deltas";
+        _slaveSharedData.jointDeltas = !avatarMixerGroupObject.contains(JOINT_DELTAS) ||
+            avatarMixerGroupObject[JOINT_DELTAS].toBool();
+        qCDebug(avatars) << "Avatar mixer joint deltas:" << (_slaveSharedData.jointDeltas ? "enabled" : "disabled");
+    }
+
     {   // Fraction of downstream bandwidth reserved for 'hero' avatars:
         static const QString PRIORITY_FRACTION_KEY = "priority_fraction";
         if (avatarMixerGroupObject.contains(PRIORITY_FRACTION_KEY)) {
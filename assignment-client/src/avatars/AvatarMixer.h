@@ -97,6 +97,7 @@ private:
     int _sumIdentityPackets { 0 };
 
     float _maxKbpsPerNode = 0.0f;
+    bool _batchSends { false };
 
     float _domainMinimumHeight { MIN_AVATAR_HEIGHT };
     float _domainMaximumHeight { MAX_AVATAR_HEIGHT };
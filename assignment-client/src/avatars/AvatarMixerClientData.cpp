@@ -16,6 +16,7 @@
 
 #include <DependencyManager.h>
 #include <NodeList.h>
+#include <UUID.h>
 #include <EntityTree.h>
 #include <ZoneEntityItem.h>
 
@@ -449,6 +450,26 @@ void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
 
         _currentViewFrustums.push_back(frustum);
     }
+
+    // then the avatars to send whole, see AvatarHashMap::packJointKeyframeRequests()
+    auto sourceEnd = reinterpret_cast<const unsigned char*>(message.constData()) + message.size();
+    if (sourceEnd - sourceBuffer < (int)sizeof(uint8_t)) {
+        return;
+    }
+    uint8_t numRequests = *sourceBuffer;
+    sourceBuffer += sizeof(numRequests);
+
+    std::lock_guard<std::mutex> lock(_jointKeyframeRequestsMutex);
+    for (uint8_t i = 0; i < numRequests && sourceEnd - sourceBuffer >= NUM_BYTES_RFC4122_UUID; ++i) {
+        _jointKeyframeRequests.insert(QUuid::fromRfc4122(QByteArray::fromRawData(
+            reinterpret_cast<const char*>(sourceBuffer), NUM_BYTES_RFC4122_UUID)));
+        sourceBuffer += NUM_BYTES_RFC4122_UUID;
+    }
+}
+
+bool AvatarMixerClientData::takeJointKeyframeRequest(const QUuid& otherAvatar) {
+    std::lock_guard<std::mutex> lock(_jointKeyframeRequestsMutex);
+    return !_jointKeyframeRequests.isEmpty() && _jointKeyframeRequests.remove(otherAvatar);
 }
 
 bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
@@ -484,9 +505,14 @@ AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherA
     }
 }
 
-void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLocalID) {
+void AvatarMixerClientData::cleanupKilledNode(const QUuid& nodeUUID, Node::LocalID nodeLocalID) {
+    {
+        std::lock_guard<std::mutex> lock(_jointKeyframeRequestsMutex);
+        _jointKeyframeRequests.remove(nodeUUID);
+    }
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
+    _lastOtherAvatarKeyframes.erase(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
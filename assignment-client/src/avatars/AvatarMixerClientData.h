@@ -14,11 +14,13 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <queue>
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 
 #include "MixerAvatar.h"
@@ -101,6 +103,7 @@ public:
     void loadJSONStats(QJsonObject& jsonObject) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getClientGlobalPosition() : glm::vec3(0); }
+    const std::vector<QUuid>& getRadiusIgnoredOthers() const { return _radiusIgnoredOthers; }
     bool isRadiusIgnoring(const QUuid& other) const;
     void addToRadiusIgnoringSet(const QUuid& other);
     void removeFromRadiusIgnoringSet(const QUuid& other);
@@ -108,6 +111,8 @@ public:
     void ignoreOther(const Node* self, const Node* other);
 
     void readViewFrustumPacket(const QByteArray& message);
+    // true once for each other avatar this node asked to be sent whole, because it missed its joint deltas' keyframe
+    bool takeJointKeyframeRequest(const QUuid& otherAvatar);
 
     bool otherAvatarInView(const AABox& otherAvatarBox);
 
@@ -127,6 +132,8 @@ public:
     void setLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar, uint64_t time);
 
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
+    // the last complete joint data of the other avatar sent to this one, that the joint deltas apply to
+    JointDeltas::Keyframe& getLastOtherAvatarKeyframe(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarKeyframes[otherAvatar]; }
 
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
@@ -174,6 +181,9 @@ private:
     // sending to "this" node
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<NLPacket::LocalID, JointDeltas::Keyframe> _lastOtherAvatarKeyframes;
+    std::mutex _jointKeyframeRequestsMutex; // the requests come with the view frustums, while the slaves send
+    QSet<QUuid> _jointKeyframeRequests;
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
@@ -44,13 +44,27 @@ void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
 void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end, 
                                 p_high_resolution_clock::time_point lastFrameTimestamp,
                                 float maxKbpsPerNode, float throttlingRatio,
-                                float priorityReservedFraction) {
+                                float priorityReservedFraction, bool batchSends) {
     _begin = begin;
     _end = end;
     _lastFrameTimestamp = lastFrameTimestamp;
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
     _avatarHeroFraction = priorityReservedFraction;
+    _batchSends = batchSends;
+
+    if (_batchSends) {
+        DependencyManager::get<NodeList>()->beginSendBatch();
+    }
+}
+
+void AvatarMixerSlave::finishBroadcast() {
+    if (_batchSends) {
+        quint64 start = usecTimestampNow();
+        DependencyManager::get<NodeList>()->flushSendBatch();
+        _stats.packetSendingElapsedTime += (usecTimestampNow() - start);
+        _batchSends = false;
+    }
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
@@ -262,6 +276,10 @@ int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const
 
 static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
+// share of the expected number of avatars to send that is spent refreshing far away avatars each frame
+static const int FAR_REFRESH_DIVISOR = 4;
+static const int MIN_FAR_REFRESH = 8;
+
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     quint64 start = usecTimestampNow();
 
@@ -384,18 +402,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
     };
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
-
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
-        if (otherNodeRaw->getType() != NodeType::Agent
-            || !otherNodeRaw->getLinkedData()
-            || otherNodeRaw == destinationNode) {
-            continue;
-        }
-
-        auto sourceAvatarNode = otherNodeRaw;
-
+    // consider an other avatar for sending, sorting it in with the others
+    auto considerAvatar = [&](const Node* sourceAvatarNode) {
         bool sendAvatar = true;  // We will consider this source avatar for sending.
         // We ignore other nodes for a couple of reasons:
         //   1) ignore bubbles and ignore specific node
@@ -491,6 +499,68 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         }
 
         destinationNodeData->setPrevRequestsDomainListData(PALIsOpen);
+    };
+
+    const auto& avatarGrid = _sharedData->avatarGrid;
+
+    // The grid only helps when the listener is an avatar that cares about its surroundings - with the PAL open (or
+    // just closed) every avatar in the domain has to be looked at, as do scripted agents.
+    bool useGrid = destinationNode->getType() == NodeType::Agent && !PALIsOpen && !PALWasOpen;
+    if (!useGrid) {
+        avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+
+        for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
+            Node* otherNodeRaw = (*listedNode).data();
+            if (otherNodeRaw->getType() != NodeType::Agent
+                || !otherNodeRaw->getLinkedData()
+                || otherNodeRaw == destinationNode) {
+                continue;
+            }
+
+            considerAvatar(otherNodeRaw);
+        }
+    } else {
+        // radius ignored avatars that we don't get to are out of the bubble, and get dropped from the set below
+        auto staleRadiusIgnored = destinationNodeData->getRadiusIgnoredOthers();
+        int numConsidered = 0;
+        auto considerGridAvatar = [&](const Node* otherNode) {
+            if (otherNode == destinationNode) {
+                return;
+            }
+            if (!staleRadiusIgnored.empty()) {
+                auto ignored = std::find(staleRadiusIgnored.begin(), staleRadiusIgnored.end(), otherNode->getUUID());
+                if (ignored != staleRadiusIgnored.end()) {
+                    staleRadiusIgnored.erase(ignored);
+                }
+            }
+            ++numConsidered;
+            considerAvatar(otherNode);
+        };
+
+        // heroes are always in the running
+        for (auto hero : avatarGrid.getHeroes()) {
+            considerGridAvatar(hero);
+        }
+
+        // gather the others near to far, until there are as many candidates as we expect to fit in the budget -
+        // always covering our bubble
+        avatarPriorityQueues[kNonhero].reserve(numToSendEst);
+        glm::vec3 bubbleScale = destinationNodeBox.getScale();
+        int bubbleRings = avatarGrid.ringsFor(glm::max(bubbleScale.x, bubbleScale.z)) + 1;
+        int rings = avatarGrid.queryNearToFar(destinationPosition, bubbleRings, considerGridAvatar, [&](int ring) {
+            return (int)avatarPriorityQueues[kNonhero].size() >= numToSendEst;
+        });
+
+        // and round-robin through the rest, so that far away avatars still get refreshed once in a while
+        int numFarRefresh = std::max(numToSendEst / FAR_REFRESH_DIVISOR, MIN_FAR_REFRESH);
+        avatarGrid.queryBeyond(destinationPosition, rings, avatarGrid.getGeneration() * (uint32_t)numFarRefresh,
+                               numFarRefresh, considerGridAvatar);
+
+        for (const auto& ignored : staleRadiusIgnored) {
+            destinationNodeData->removeFromRadiusIgnoringSet(ignored);
+        }
+
+        _stats.numOthersCulled += std::max(avatarGrid.getNumAvatars() + (int)avatarGrid.getHeroes().size() - numConsidered - 1, 0);
     }
 
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
@@ -548,7 +618,12 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::MinimumData;
                 destinationNodeData->incrementAvatarOutOfView();
             } else if (!overBudget) {
-                detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO ? AvatarData::SendAllData : AvatarData::CullSmallData;
+                detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO ? AvatarData::SendAllData :
+                    (_sharedData->jointDeltas ? AvatarData::JointDeltaData : AvatarData::CullSmallData);
+                // a listener that missed the keyframe of the joint deltas asks for a new one, rather than wait for chance
+                if (destinationNodeData->takeJointKeyframeRequest(sourceNode->getUUID())) {
+                    detail = AvatarData::SendAllData;
+                }
                 destinationNodeData->incrementAvatarInView();
 
                 // If the time that the mixer sent AVATAR DATA about Avatar B to Node A is BEFORE OR EQUAL TO
@@ -563,32 +638,73 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             }
 
             QVector<JointData>& lastSentJointsForOther = destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
+            JointDeltas::Keyframe& keyframeForOther = destinationNodeData->getLastOtherAvatarKeyframe(sourceNode->getLocalID());
 
             const bool distanceAdjust = true;
             const bool dropFaceTracking = false;
-            AvatarDataPacket::SendStatus sendStatus;
-            sendStatus.sendUUID = true;
 
-            do {
+            // full and PAL updates are the same for every listener, copy this frame's encoding if it fits the packet
+            bool wasCopied = false;
+            if (AvatarEncodeCache::isListenerIndependent(detail)) {
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+                bool wasCached;
+                auto encoding = _sharedData->encodeCache.get(sourceNode->getLocalID(), *sourceAvatar, detail,
+                                                             dropFaceTracking, wasCached);
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+                if (wasCached) {
+                    _stats.numEncodeCacheHits++;
+                } else {
+                    _stats.numEncodeCacheMisses++;
+                }
 
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
-                    ++numPacketsSent;
-                    avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
-                    avatarSpaceAvailable = avatarPacketCapacity;
+                if (encoding.bytes.size() <= avatarSpaceAvailable) {
+                    avatarPacket->write(encoding.bytes);
+                    avatarSpaceAvailable -= encoding.bytes.size();
+                    numAvatarDataBytes += encoding.bytes.size();
+                    if (detail == AvatarData::SendAllData) {
+                        lastSentJointsForOther = encoding.sentJoints;
+                    }
+                    if (encoding.keyframe.isValid()) {
+                        keyframeForOther = encoding.keyframe;
+                    }
+                    if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                    wasCopied = true;
                 }
-            } while (!sendStatus);
+            }
+
+            // otherwise encode for this listener, across as many packets as it takes
+            if (!wasCopied) {
+                AvatarDataPacket::SendStatus sendStatus;
+                sendStatus.sendUUID = true;
+
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable, nullptr, &keyframeForOther);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } while (!sendStatus);
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -708,8 +824,15 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
 
             QVector<JointData> emptyLastJointSendData { otherAvatar->getJointCount() };
 
-            QByteArray avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
-                sendStatus, false, false, glm::vec3(0), nullptr, 0);
+            // the agents are sent the same full update, less the UUID that the packet list has already
+            bool wasCached;
+            QByteArray avatarByteArray = _sharedData->encodeCache.get(agentNode->getLocalID(), *otherAvatar,
+                AvatarData::SendAllData, false, wasCached).bytes.mid(NUM_BYTES_RFC4122_UUID);
+            if (wasCached) {
+                _stats.numEncodeCacheHits++;
+            } else {
+                _stats.numEncodeCacheMisses++;
+            }
             quint64 end = usecTimestampNow();
             _stats.toByteArrayElapsedTime += (end - start);
 
@@ -14,6 +14,9 @@
 
 #include <NodeList.h>
 
+#include "AvatarEncodeCache.h"
+#include "AvatarGrid.h"
+
 class AvatarMixerClientData;
 
 class AvatarMixerSlaveStats {
@@ -33,6 +36,9 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numOthersCulled { 0 };
+    int numEncodeCacheHits { 0 };
+    int numEncodeCacheMisses { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +65,9 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numOthersCulled = 0;
+        numEncodeCacheHits = 0;
+        numEncodeCacheMisses = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +92,9 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numOthersCulled += rhs.numOthersCulled;
+        numEncodeCacheHits += rhs.numEncodeCacheHits;
+        numEncodeCacheMisses += rhs.numEncodeCacheMisses;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +112,9 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    AvatarGrid avatarGrid; // this frame's avatars, by position
+    AvatarEncodeCache encodeCache; // this frame's avatar data that is the same for every listener
+    bool jointDeltas { true }; // send the joints as deltas from the last complete joint data each listener was sent
 };
 
 class AvatarMixerSlave {
@@ -111,7 +126,10 @@ public:
     void configureBroadcast(ConstIter begin, ConstIter end, 
                     p_high_resolution_clock::time_point lastFrameTimestamp, 
                     float maxKbpsPerNode, float throttlingRatio,
-                    float priorityReservedFraction);
+                    float priorityReservedFraction, bool batchSends);
+
+    // flush any sends batched during this broadcast
+    void finishBroadcast();
 
     void processIncomingPackets(const SharedNodePointer& node);
     void broadcastAvatarData(const SharedNodePointer& node);
@@ -142,6 +160,7 @@ private:
     float _maxKbpsPerNode { 0.0f };
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
+    bool _batchSends { false };
 
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
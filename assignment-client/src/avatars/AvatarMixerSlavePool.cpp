@@ -18,10 +18,13 @@ void AvatarMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        // run nodes until there are none left, here or on the other threads
+        _pool._scheduler.run(_index, [&](int job) {
+            (this->*_function)(_pool._nodes[job]);
+        });
+
+        if (_pool._finalize) {
+            _pool._finalize(*this);
         }
 
         bool stopping = _stop;
@@ -59,37 +62,42 @@ void AvatarMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
-
 void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
     _function = &AvatarMixerSlave::processIncomingPackets;
     _configure = [=](AvatarMixerSlave& slave) { 
         slave.configure(begin, end);
     };
-    run(begin, end);
+    _finalize = [](AvatarMixerSlave& slave) {};
+    run(begin, end, _packetCosts);
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
                                                p_high_resolution_clock::time_point lastFrameTimestamp,
-                                               float maxKbpsPerNode, float throttlingRatio) {
+                                               float maxKbpsPerNode, float throttlingRatio, bool batchSends) {
     _function = &AvatarMixerSlave::broadcastAvatarData;
     _configure = [=](AvatarMixerSlave& slave) { 
         slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
-            _priorityReservedFraction);
+            _priorityReservedFraction, batchSends);
    };
-    run(begin, end);
+    _finalize = [](AvatarMixerSlave& slave) {
+        slave.finishBroadcast();
+    };
+    run(begin, end, _broadcastCosts);
 }
 
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end, Costs& costs) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
+    // deal the nodes out to the slaves, weighted by how long each took last frame
+    _nodes.clear();
+    _nodeCosts.clear();
     std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+        auto cost = costs.find(node->getLocalID());
+        _nodes.push_back(node);
+        _nodeCosts.push_back(cost != costs.end() ? cost->second : 0.0f);
     });
+    _scheduler.schedule(_nodeCosts);
 
     {
         Lock lock(_mutex);
@@ -107,7 +115,13 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    _scheduler.finish();
+
+    costs.clear();
+    for (int i = 0; i < (int)_nodes.size(); ++i) {
+        costs[_nodes[i]->getLocalID()] = _scheduler.getJobCost(i);
+    }
+    _nodes.clear();
 }
 
 
@@ -160,7 +174,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData);
+            auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData, (int)_slaves.size());
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -200,4 +214,6 @@ void AvatarMixerSlavePool::resize(int numThreads) {
 
     _numThreads = _numStarted = _numFinished = numThreads;
     assert(_numThreads == (int)_slaves.size());
+
+    _scheduler.setNumWorkers(numThreads);
 }
@@ -14,13 +14,14 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
 
-#include <TBBHelpers.h>
 #include <NodeList.h>
 #include <shared/QtHelpers.h>
+#include <WorkStealingScheduler.h>
 
 #include "AvatarMixerSlave.h"
 
@@ -34,8 +35,8 @@ class AvatarMixerSlaveThread : public QThread, public AvatarMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, SlaveSharedData* slaveSharedData) :
-        AvatarMixerSlave(slaveSharedData), _pool(pool) {};
+    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, SlaveSharedData* slaveSharedData, int index) :
+        AvatarMixerSlave(slaveSharedData), _pool(pool), _index(index) {};
 
     void run() override final;
 
@@ -44,9 +45,9 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
 
     AvatarMixerSlavePool& _pool;
+    const int _index; // worker index in the pool's scheduler
     void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
 };
@@ -54,7 +55,7 @@ private:
 // Slave pool for avatar mixers
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
+    using Costs = std::unordered_map<Node::LocalID, float>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -69,7 +70,8 @@ public:
     // Jobs the slave pool can do...
     void processIncomingPackets(ConstIter begin, ConstIter end);
     void broadcastAvatarData(ConstIter begin, ConstIter end, 
-                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio);
+                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio,
+                    bool batchSends = false);
 
     // iterate over all slaves
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
@@ -84,15 +86,19 @@ public:
     void setPriorityReservedFraction(float fraction) { _priorityReservedFraction = fraction; }
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
+    // load balance of the slave threads since the last reset
+    std::vector<WorkStealingScheduler::WorkerStats> getWorkerStats() const { return _scheduler.getWorkerStats(); }
+    void resetWorkerStats() { _scheduler.resetWorkerStats(); }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, Costs& costs);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AvatarMixerSlaveThread>> _slaves;
 
     friend void AvatarMixerSlaveThread::wait();
     friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend void AvatarMixerSlaveThread::run();
 
     // synchronization state
     Mutex _mutex;
@@ -100,6 +106,7 @@ private:
     ConditionVariable _poolCondition;
     void (AvatarMixerSlave::*_function)(const SharedNodePointer& node);
     std::function<void(AvatarMixerSlave&)> _configure;
+    std::function<void(AvatarMixerSlave&)> _finalize;
 
     // Set from Domain Settings:
     float _priorityReservedFraction { 0.4f };
@@ -110,10 +117,16 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    WorkStealingScheduler _scheduler;
+    std::vector<SharedNodePointer> _nodes;
+    std::vector<float> _nodeCosts;
     ConstIter _begin;
     ConstIter _end;
 
+    // time each node took last frame, the cost estimate for the next
+    Costs _packetCosts;
+    Costs _broadcastCosts;
+
     SlaveSharedData* _slaveSharedData;
 };
 
@@ -456,6 +456,30 @@ QString EntityServer::serverSubclassStats() {
     }
     statsString += "\r\n\r\n";
 
+    statsString += "<b>Entity Server Send Backlog</b>\r\n";
+    statsString += "----- Viewer Node ID -----------------    ---- Queued Entities ---    ------- Send Budget ------\r\n";
+
+    int clients = 0;
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = dynamic_cast<OctreeQueryNode*>(node->getLinkedData());
+        if (nodeData) {
+            statsString += node->getUUID().toString();
+            statsString += "    ";
+            statsString += QString("%1 entities")
+                .arg(locale.toString(nodeData->getSendBacklog()).rightJustified(COLUMN_WIDTH - 9, ' '));
+            statsString += "    ";
+            statsString += QString("%1 kbps")
+                .arg(locale.toString(nodeData->getSendBytesPerSecond() / BYTES_PER_KILOBIT)
+                    .rightJustified(COLUMN_WIDTH - 5, ' '));
+            statsString += "\r\n";
+            clients++;
+        }
+    });
+    if (clients < 1) {
+        statsString += "    no clients... \r\n";
+    }
+    statsString += "\r\n\r\n";
+
     return statsString;
 }
 
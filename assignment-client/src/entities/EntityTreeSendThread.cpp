@@ -102,8 +102,9 @@ void EntityTreeSendThread::preDistributionProcessing() {
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
     if (viewFrustumChanged || _traversal.finished()) {
-        EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
-
+        // traverse a snapshot of the tree rather than the tree itself, so that edits don't wait on the traversal
+        auto tree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+        EntityTreeSnapshotPointer snapshot = tree->getSnapshot();
 
         DiffTraversal::View newView;
         newView.viewFrustums = nodeData->getCurrentViews();
@@ -111,35 +112,21 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
         int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
         newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
         
-        startNewTraversal(newView, root, isFullScene);
+        startNewTraversal(newView, snapshot, isFullScene);
 
-        // When the viewFrustum changed the sort order may be incorrect, so we re-sort
+        // When the viewFrustum changed the sort order may be incorrect, so we re-prioritize the queue in place
         // and also use the opportunity to cull anything no longer in view
         if (viewFrustumChanged && !_sendQueue.empty()) {
-            EntityPriorityQueue prevSendQueue;
-            std::swap(_sendQueue, prevSendQueue);
-            assert(_sendQueue.empty());
-
-            // Re-add elements from previous traversal if they still need to be sent
-            while (!prevSendQueue.empty()) {
-                EntityItemPointer entity = prevSendQueue.top().getEntity();
-                bool forceRemove = prevSendQueue.top().shouldForceRemove();
-                prevSendQueue.pop();
-                if (entity) {
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
-
-                    if (forceRemove) {
-                        priority = PrioritizedEntity::FORCE_REMOVE;
-                    } else {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
-                    }
-
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority, forceRemove);
-                    }
+            const auto& view = _traversal.getCurrentView();
+            _sendQueue.reprioritize([&](const PrioritizedEntity& queuedItem) -> float {
+                EntityItemPointer entity = queuedItem.getEntity();
+                if (!entity) {
+                    return PrioritizedEntity::DO_NOT_SEND;
+                } else if (queuedItem.shouldForceRemove()) {
+                    return PrioritizedEntity::FORCE_REMOVE;
                 }
-            }
+                return view.computePriority(entity);
+            });
         }
     }
 
@@ -156,6 +143,7 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
     }
 
     bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
+    nodeData->setSendBacklog((int)_sendQueue.size());
 
     if (sendComplete && nodeData->wantReportInitialCompletion() && _traversal.finished()) {
         // Dealt with all nearby entities.
@@ -225,10 +213,10 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
     return hasNewChild || hasNewDescendants;
 }
 
-void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
+void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeSnapshotPointer snapshot,
                                              bool forceFirstPass) {
 
-    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, forceFirstPass);
+    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, snapshot, forceFirstPass);
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -242,7 +230,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
             // When we get to a First traversal, clear the _knownState
             _knownState.clear();
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
-                next.element->forEachEntity([&](EntityItemPointer entity) {
+                next.forEachEntity([&](EntityItemPointer entity) {
                     // Bail early if we've already checked this entity this frame
                     if (_sendQueue.contains(entity.get())) {
                         return;
@@ -259,8 +247,8 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
         case DiffTraversal::Repeat:
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 uint64_t startOfCompletedTraversal = _traversal.getStartOfCompletedTraversal();
-                if (next.element->getLastChangedContent() > startOfCompletedTraversal) {
-                    next.element->forEachEntity([&](EntityItemPointer entity) {
+                if (next.element->lastChangedContent > startOfCompletedTraversal) {
+                    next.forEachEntity([&](EntityItemPointer entity) {
                         // Bail early if we've already checked this entity this frame
                         if (_sendQueue.contains(entity.get())) {
                             return;
@@ -289,7 +277,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
         case DiffTraversal::Differential:
             assert(view.usesViewFrustums());
             _traversal.setScanCallback([this] (DiffTraversal::VisibleElement& next) {
-                next.element->forEachEntity([&](EntityItemPointer entity) {
+                next.forEachEntity([&](EntityItemPointer entity) {
                     // Bail early if we've already checked this entity this frame
                     if (_sendQueue.contains(entity.get())) {
                         return;
@@ -338,9 +326,9 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         _packetData.appendValue(zeroByte); // colors
         if (params.includeExistsBits) {
             uint8_t childrenExistBits = 0;
-            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
+            const EntityTreeSnapshot* snapshot = _traversal.getSnapshot().get();
             for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
-                if (root->getChildAtIndex(i)) {
+                if (snapshot && snapshot->getChild(snapshot->getRoot(), i)) {
                     childrenExistBits += (1 << i);
                 }
             }
@@ -365,7 +353,10 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     while(!_sendQueue.empty()) {
         PrioritizedEntity queuedItem = _sendQueue.top();
         EntityItemPointer entity = queuedItem.getEntity();
-        if (entity) {
+        // the tree isn't locked while sending, the entity may have been deleted since it was queued
+        if (entity && entity->isDead()) {
+            _knownState.erase(entity.get());
+        } else if (entity) {
             const QUuid& entityID = entity->getID();
             // Only send entities that match the jsonFilters, but keep track of everything we've tried to send so we don't try to send it again;
             // also send if we previously matched since this represents change to a matched item.
@@ -419,17 +410,19 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 }
 
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
-    if (entity) {
-        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
-            const auto& view = _traversal.getCurrentView();
-            float priority = view.computePriority(entity);
-
-            // We can force a removal from _knownState if the current view is used and entity is out of view
-            if (priority == PrioritizedEntity::DO_NOT_SEND) {
-                _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
-            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
-                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
-            }
+    if (entity && _knownState.find(entity.get()) != _knownState.end()) {
+        // the change is queued right away rather than on the next traversal, or the priority it is queued with is
+        // updated, so that the most important changes are sent first
+        const auto& view = _traversal.getCurrentView();
+        float priority = view.computePriority(entity);
+
+        // We can force a removal from _knownState if the current view is used and entity is out of view
+        if (priority == PrioritizedEntity::DO_NOT_SEND) {
+            _sendQueue.update(entity, PrioritizedEntity::FORCE_REMOVE, true);
+        } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
+            _sendQueue.update(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
+        } else {
+            _sendQueue.update(entity, priority);
         }
     }
 }
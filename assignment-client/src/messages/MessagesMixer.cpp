@@ -11,16 +11,24 @@
 
 #include "MessagesMixer.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 
+const int DEFAULT_COALESCE_WINDOW_MSECS = 10;
+const float DEFAULT_MAX_SENDER_MESSAGES_PER_SECOND = 0.0f; // unlimited, as script agents can't be told from clients
+const float DEFAULT_NODE_SEND_BANDWIDTH = 2.0f; // megabits per second
+
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
@@ -30,41 +38,139 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
     packetReceiver.registerListener(PacketType::MessagesUnsubscribe, this, "handleMessagesUnsubscribe");
 }
 
+void MessagesMixer::aboutToFinish() {
+    if (_sendThread) {
+        _sendThread->terminate();
+    }
+    ThreadedAssignment::aboutToFinish();
+}
+
+void MessagesMixer::handleSettings() {
+    auto& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+    const QString MESSAGES_MIXER_SETTINGS_KEY = "messages_mixer";
+    QJsonObject messagesMixerGroupObject = domainHandler.getSettingsObject()[MESSAGES_MIXER_SETTINGS_KEY].toObject();
+
+    const QString COALESCE_WINDOW = "coalesce_window_ms";
+    int coalesceWindow = std::max(0, messagesMixerGroupObject[COALESCE_WINDOW].toInt(DEFAULT_COALESCE_WINDOW_MSECS));
+    _sendThread->setCoalesceWindow(coalesceWindow);
+    qDebug() << "Messages mixer will collect each node's messages for" << coalesceWindow << "ms.";
+
+    const QString MAX_SENDER_MESSAGES_PER_SECOND = "max_sender_messages_per_second";
+    _maxSenderMessagesPerSecond = std::max(0.0f, (float)messagesMixerGroupObject[MAX_SENDER_MESSAGES_PER_SECOND]
+        .toDouble(DEFAULT_MAX_SENDER_MESSAGES_PER_SECOND));
+    _senders.clear();
+    qDebug() << "The maximum messages per second from each node is" << _maxSenderMessagesPerSecond;
+
+    const QString NODE_SEND_BANDWIDTH = "max_node_send_bandwidth";
+    float maxKbpsPerNode = std::max(0.0f, (float)messagesMixerGroupObject[NODE_SEND_BANDWIDTH]
+        .toDouble(DEFAULT_NODE_SEND_BANDWIDTH)) * KILO_PER_MEGA;
+    _sendThread->setMaxNodeBandwidth(maxKbpsPerNode);
+    qDebug() << "The maximum send bandwidth per node is" << maxKbpsPerNode << "kbps.";
+}
+
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    _senders.remove(killedNode->getUUID());
+
+    auto channels = _nodeChannels.take(killedNode->getUUID());
+    for (const auto& channelName : channels) {
+        unsubscribe(channelName, killedNode->getUUID());
+    }
+}
+
+void MessagesMixer::subscribe(const QString& channelName, const SharedNodePointer& node) {
+    auto& nodeChannels = _nodeChannels[node->getUUID()];
+    if (nodeChannels.contains(channelName)) {
+        return;
+    }
+    nodeChannels << channelName;
+
+    Channel& channel = _channels[channelName];
+    auto subscribers = std::make_shared<MessageSubscribers>(*channel.subscribers);
+    subscribers->push_back(node);
+    channel.subscribers = subscribers;
+}
+
+void MessagesMixer::unsubscribe(const QString& channelName, const QUuid& nodeID) {
+    auto found = _channels.find(channelName);
+    if (found == _channels.end()) {
+        return;
+    }
+    auto subscribers = std::make_shared<MessageSubscribers>(*found->subscribers);
+    subscribers->erase(std::remove_if(subscribers->begin(), subscribers->end(), [&](const SharedNodePointer& node) {
+        return node->getUUID() == nodeID;
+    }), subscribers->end());
+    found->subscribers = subscribers;
+}
+
+bool MessagesMixer::isUnderSenderRate(const Node& senderNode) {
+    // the entity script server sends the messages of every entity script, at any rate
+    if (_maxSenderMessagesPerSecond <= 0.0f || senderNode.getType() == NodeType::EntityScriptServer) {
+        return true;
+    }
+    quint64 now = usecTimestampNow();
+    auto found = _senders.find(senderNode.getUUID());
+    if (found == _senders.end()) {
+        found = _senders.insert(senderNode.getUUID(), { _maxSenderMessagesPerSecond, now });
+    }
+
+    // a sender can send up to a second's worth of messages at once
+    Sender& sender = found.value();
+    float elapsedSeconds = (float)(now - sender.lastMessageTime) / USECS_PER_SECOND;
+    sender.allowance = std::min(sender.allowance + elapsedSeconds * _maxSenderMessagesPerSecond, _maxSenderMessagesPerSecond);
+    sender.lastMessageTime = now;
+    if (sender.allowance < 1.0f) {
+        sender.numMessagesDropped++;
+        return false;
     }
+    sender.allowance -= 1.0f;
+    return true;
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
+    QString channelName, message;
     QByteArray data;
     QUuid senderID;
     bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    if (!MessagesClient::decodeMessagesPacket(receivedMessage, channelName, isText, message, data, senderID)) {
+        return;
+    }
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto found = _channels.find(channelName);
+    if (found == _channels.end()) {
+        return;
+    }
+    Channel& channel = found.value();
+    channel.numMessagesIn++;
+    channel.numBytesIn += receivedMessage->getSize();
+    if (channel.subscribers->empty()) {
+        return;
+    }
+    if (!isUnderSenderRate(*senderNode)) {
+        channel.numMessagesDropped++;
+        return;
+    }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    // encoded once, for every subscriber
+    auto packetList = isText ? MessagesClient::encodeMessagesPacket(channelName, message, senderID) :
+                               MessagesClient::encodeMessagesDataPacket(channelName, data, senderID);
+    packetList->closeCurrentPacket();
+    QByteArray payload = packetList->getMessage();
+
+    channel.numMessagesOut += (int)channel.subscribers->size();
+    channel.numBytesOut += (qint64)channel.subscribers->size() * payload.size();
+    _sendThread->queueItem({ payload, channel.subscribers });
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    subscribe(channel, senderNode);
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    auto nodeChannels = _nodeChannels.find(senderNode->getUUID());
+    if (nodeChannels != _nodeChannels.end() && nodeChannels->remove(channel)) {
+        unsubscribe(channel, senderNode->getUUID());
     }
 }
 
@@ -77,10 +183,52 @@ void MessagesMixer::sendStatsPacket() {
         clientStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidStringWithoutCurlyBraces(node->getUUID());
         clientStats["outbound_kbps"] = node->getOutboundKbps();
         clientStats["inbound_kbps"] = node->getInboundKbps();
+        auto sender = _senders.find(node->getUUID());
+        if (sender != _senders.end()) {
+            clientStats["dropped_messages"] = sender->numMessagesDropped;
+            sender->numMessagesDropped = 0;
+        }
         messagesMixerObject[uuidStringWithoutCurlyBraces(node->getUUID())] = clientStats;
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add stats for each channel
+    quint64 now = usecTimestampNow();
+    float elapsedSeconds = (float)(now - _lastStatsTime) / USECS_PER_SECOND;
+    _lastStatsTime = now;
+
+    QJsonObject channelsObject;
+    for (auto it = _channels.begin(); it != _channels.end();) {
+        Channel& channel = it.value();
+        if (channel.subscribers->empty() && channel.numMessagesIn == 0) {
+            it = _channels.erase(it);
+            continue;
+        }
+        QJsonObject channelStats;
+        channelStats["subscribers"] = (int)channel.subscribers->size();
+        if (elapsedSeconds > 0.0f) {
+            channelStats["inbound_messages_per_second"] = channel.numMessagesIn / elapsedSeconds;
+            channelStats["inbound_kbps"] = channel.numBytesIn / (float)BYTES_PER_KILOBIT / elapsedSeconds;
+            channelStats["dropped_messages_per_second"] = channel.numMessagesDropped / elapsedSeconds;
+            channelStats["outbound_messages_per_second"] = channel.numMessagesOut / elapsedSeconds;
+            channelStats["outbound_kbps"] = channel.numBytesOut / (float)BYTES_PER_KILOBIT / elapsedSeconds;
+        }
+        channelsObject[it.key()] = channelStats;
+
+        channel.numMessagesIn = 0;
+        channel.numBytesIn = 0;
+        channel.numMessagesDropped = 0;
+        channel.numMessagesOut = 0;
+        channel.numBytesOut = 0;
+        ++it;
+    }
+    statsObject["messages_channels"] = channelsObject;
+
+    QJsonObject sendStats;
+    sendStats["held_bytes"] = _sendThread->getNumHeldBytes();
+    sendStats["dropped_messages"] = _sendThread->takeNumDroppedMessages();
+    statsObject["messages_send"] = sendStats;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -88,4 +236,15 @@ void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
+
+    _lastStatsTime = usecTimestampNow();
+    _sendThread.reset(new MessagesSendThread());
+    _sendThread->setCoalesceWindow(DEFAULT_COALESCE_WINDOW_MSECS);
+    _sendThread->setMaxNodeBandwidth(DEFAULT_NODE_SEND_BANDWIDTH * KILO_PER_MEGA);
+    _maxSenderMessagesPerSecond = DEFAULT_MAX_SENDER_MESSAGES_PER_SECOND;
+    _sendThread->initialize(true);
+
+    // the defaults apply until the domain-server's settings arrive
+    DomainHandler& domainHandler = nodeList->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::settingsReceived, this, &MessagesMixer::handleSettings);
 }
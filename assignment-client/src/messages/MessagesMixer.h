@@ -15,26 +15,60 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <memory>
+
 #include <ThreadedAssignment.h>
 
+#include "MessagesSendThread.h"
+
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
 class MessagesMixer : public ThreadedAssignment {
     Q_OBJECT
 public:
     MessagesMixer(ReceivedMessage& message);
 
+    void aboutToFinish() override;
+
 public slots:
     void run() override;
     void nodeKilled(SharedNodePointer killedNode);
     void sendStatsPacket() override;
 
 private slots:
+    void handleSettings();
     void handleMessages(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
-    QHash<QString,QSet<QUuid>> _channelSubscribers;
+    struct Channel {
+        // replaced, not changed, when a node subscribes or unsubscribes, as the queued messages share it
+        std::shared_ptr<const MessageSubscribers> subscribers { std::make_shared<MessageSubscribers>() };
+
+        // since the last stats packet
+        int numMessagesIn { 0 };
+        qint64 numBytesIn { 0 };
+        int numMessagesDropped { 0 }; // over their sender's rate
+        int numMessagesOut { 0 };
+        qint64 numBytesOut { 0 };
+    };
+
+    struct Sender {
+        float allowance; // messages
+        quint64 lastMessageTime;
+        int numMessagesDropped { 0 }; // over the rate, since the last stats packet
+    };
+
+    void subscribe(const QString& channelName, const SharedNodePointer& node);
+    void unsubscribe(const QString& channelName, const QUuid& nodeID);
+    bool isUnderSenderRate(const Node& senderNode);
+
+    QHash<QString, Channel> _channels;
+    QHash<QUuid, QSet<QString>> _nodeChannels; // the channels of each subscriber
+    QHash<QUuid, Sender> _senders;
+    float _maxSenderMessagesPerSecond { 0.0f }; // unlimited when zero
+    std::unique_ptr<MessagesSendThread> _sendThread;
+    quint64 _lastStatsTime { 0 };
 };
 
 #endif // hifi_MessagesMixer_h
@@ -0,0 +1,109 @@
+//
+//  MessagesSendThread.cpp
+//  assignment-client/src/messages
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MessagesSendThread.h"
+
+#include <algorithm>
+
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+// how often the held messages are sent, without a coalescing window
+const int HELD_MESSAGES_INTERVAL_MSECS = 1;
+
+MessagesSendThread::MessagesSendThread() {
+    setObjectName("MessagesSendThread");
+}
+
+void MessagesSendThread::terminating() {
+    // don't wait for the next message to exit
+    _hasItems.wakeAll();
+}
+
+bool MessagesSendThread::process() {
+    // wait for a message, unless some are held for their nodes' bandwidth
+    if (_numHeldBytes == 0) {
+        lock();
+        bool isEmpty = _items.isEmpty();
+        unlock();
+        if (isEmpty) {
+            _hasItemsMutex.lock();
+            _hasItems.wait(&_hasItemsMutex, getMaxWait());
+            _hasItemsMutex.unlock();
+        }
+    }
+
+    // then send no sooner than a window after the last send, for the messages that follow it to go out together
+    int window = _numHeldBytes > 0 ? std::max((int)_coalesceWindowMsecs, HELD_MESSAGES_INTERVAL_MSECS) : _coalesceWindowMsecs;
+    if (window > 0) {
+        quint64 sendTime = _lastSendTime + (quint64)window * USECS_PER_MSEC;
+        _hasItemsMutex.lock();
+        for (quint64 now = usecTimestampNow(); now < sendTime && isStillRunning(); now = usecTimestampNow()) {
+            // the messages that arrive wake it too, only terminating() ends the wait early
+            _hasItems.wait(&_hasItemsMutex, (unsigned long)((sendTime - now + USECS_PER_MSEC - 1) / USECS_PER_MSEC));
+        }
+        _hasItemsMutex.unlock();
+    }
+
+    Queue messages;
+    lock();
+    messages.swap(_items);
+    unlock();
+    return processQueueItems(messages);
+}
+
+bool MessagesSendThread::processQueueItems(const Queue& messages) {
+    _pacer.setMaxNodeBandwidth(_maxNodeKbps);
+
+    int numDroppedMessages = 0;
+    for (const auto& message : messages) {
+        for (const auto& node : *message.subscribers) {
+            if (_pacer.queueMessage(node->getUUID(), message.payload)) {
+                _nodes[node->getUUID()] = node;
+            } else {
+                ++numDroppedMessages;
+            }
+        }
+    }
+
+    quint64 now = usecTimestampNow();
+    float elapsedSeconds = _lastSendTime > 0 ? (float)(now - _lastSendTime) / USECS_PER_SECOND : 0.0f;
+    _lastSendTime = now;
+
+    for (auto it = _nodes.begin(); it != _nodes.end(); ++it) {
+        if (!it.value()->getActiveSocket()) {
+            numDroppedMessages += _pacer.removeNode(it.key());
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto batches = _pacer.takeMessages(elapsedSeconds);
+    for (auto it = batches.begin(); it != batches.end(); ++it) {
+        auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+        for (const auto& payload : it.value()) {
+            packetList->write(payload);
+        }
+        nodeList->sendPacketList(std::move(packetList), *_nodes[it.key()]);
+    }
+
+    for (auto it = _nodes.begin(); it != _nodes.end();) {
+        if (_pacer.hasNode(it.key())) {
+            ++it;
+        } else {
+            it = _nodes.erase(it);
+        }
+    }
+
+    _numHeldBytes = _pacer.getNumHeldBytes();
+    _numDroppedMessages += numDroppedMessages;
+    return isStillRunning();
+}
@@ -0,0 +1,65 @@
+//
+//  MessagesSendThread.h
+//  assignment-client/src/messages
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MessagesSendThread_h
+#define hifi_MessagesSendThread_h
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include <GenericQueueThread.h>
+#include <MessagesPacer.h>
+#include <Node.h>
+
+using MessageSubscribers = std::vector<SharedNodePointer>;
+
+/// A message to fan out to the subscribers of its channel
+struct QueuedMessage {
+    QByteArray payload; // the encoded message, the same for every subscriber
+    std::shared_ptr<const MessageSubscribers> subscribers; // the channel's subscribers when the message was received
+};
+
+/// Sends the messages mixer's messages to their subscribers, off of the mixer's thread. Messages are sent at most once
+/// per coalescing window, those for a node that arrive within one are sent to it together, in one packet list, and a
+/// message after a quiet window goes out at once. No more than the node's bandwidth allows is sent; the rest are held
+/// for the next windows, up to a second's worth, and past that dropped.
+class MessagesSendThread : public GenericQueueThread<QueuedMessage> {
+    Q_OBJECT
+public:
+    MessagesSendThread();
+
+    void setCoalesceWindow(int msecs) { _coalesceWindowMsecs = msecs; }
+    void setMaxNodeBandwidth(float kbps) { _maxNodeKbps = kbps; } // unlimited when zero
+
+    int getNumHeldBytes() const { return _numHeldBytes; }
+    int takeNumDroppedMessages() { return _numDroppedMessages.exchange(0); }
+
+protected:
+    void terminating() override;
+    bool process() override;
+    bool processQueueItems(const Queue& messages) override;
+
+private:
+    MessagesPacer _pacer;
+    QHash<QUuid, SharedNodePointer> _nodes; // the nodes the pacer has
+    quint64 _lastSendTime { 0 };
+
+    std::atomic<int> _coalesceWindowMsecs { 0 };
+    std::atomic<float> _maxNodeKbps { 0.0f };
+    std::atomic<int> _numHeldBytes { 0 };
+    std::atomic<int> _numDroppedMessages { 0 };
+};
+
+#endif // hifi_MessagesSendThread_h
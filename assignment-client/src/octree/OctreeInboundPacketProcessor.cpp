@@ -11,8 +11,13 @@
 
 #include "OctreeInboundPacketProcessor.h"
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
@@ -22,6 +27,7 @@
 
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+const int MIN_PACKETS_PER_DECODE_THREAD = 8;
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -42,6 +48,13 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalBatches = 0;
+    _totalBatchedEdits = 0;
+    _totalEditsMerged = 0;
+    _totalBatchDecodeTime = 0;
+    _totalBatchPrepareTime = 0;
+    _totalBatchLockWaitTime = 0;
+    _totalBatchApplyTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -153,6 +166,12 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
         }
         
+        if (_myServer->getOctree()->handlesBatchedEdits()) {
+            // decoded and applied along with the other edit packets of this pass, see postProcess()
+            _batch.push_back({ message, sendingNode, sequence, transitTime });
+            return;
+        }
+
         const unsigned char* editData = nullptr;
         
         while (message->getBytesLeftToRead() > 0) {
@@ -225,6 +244,116 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    if (_shuttingDown) {
+        _batch.clear();
+    } else if (!_batch.empty()) {
+        processBatch();
+    }
+}
+
+void OctreeInboundPacketProcessor::processBatch() {
+    OctreePointer tree = _myServer->getOctree();
+    int numPackets = (int)_batch.size();
+
+    // decode the packets without the tree lock, spread over threads when there are enough of them - the edits of a
+    // packet can only be found one after the other, so a packet is decoded by a single thread
+    quint64 startDecode = usecTimestampNow();
+    std::vector<OctreeEdits> packetEdits(numPackets);
+    std::vector<quint64> packetDecodeTimes(numPackets);
+    auto decodePackets = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            quint64 start = usecTimestampNow();
+            decodeBatchedPacket(*tree, _batch[i], packetEdits[i]);
+            packetDecodeTimes[i] = usecTimestampNow() - start;
+        }
+    };
+
+    int numThreads = std::min(std::max(QThread::idealThreadCount(), 1),
+                              (numPackets + MIN_PACKETS_PER_DECODE_THREAD - 1) / MIN_PACKETS_PER_DECODE_THREAD);
+    if (numThreads > 1) {
+        int packetsPerThread = (numPackets + numThreads - 1) / numThreads;
+        std::vector<QFuture<void>> decodes;
+        for (int begin = packetsPerThread; begin < numPackets; begin += packetsPerThread) {
+            int end = std::min(begin + packetsPerThread, numPackets);
+            decodes.push_back(QtConcurrent::run([&decodePackets, begin, end] { decodePackets(begin, end); }));
+        }
+        decodePackets(0, packetsPerThread);
+        for (auto& decode : decodes) {
+            decode.waitForFinished();
+        }
+    } else {
+        decodePackets(0, numPackets);
+    }
+
+    OctreeEdits edits;
+    std::vector<int> packetNumEdits(numPackets);
+    for (int i = 0; i < numPackets; ++i) {
+        packetNumEdits[i] = (int)packetEdits[i].size();
+        std::move(packetEdits[i].begin(), packetEdits[i].end(), std::back_inserter(edits));
+    }
+    int numEdits = (int)edits.size();
+    quint64 decodeTime = usecTimestampNow() - startDecode;
+
+    // prepare them in order, still without the lock
+    quint64 startPrepare = usecTimestampNow();
+    int numMerged = tree->prepareEdits(edits);
+    quint64 prepareTime = usecTimestampNow() - startPrepare;
+
+    // and apply them all at once
+    quint64 startApply, startLock = usecTimestampNow();
+    tree->withWriteLock([&] {
+        startApply = usecTimestampNow();
+        tree->applyEdits(edits);
+    });
+    quint64 applyTime = usecTimestampNow() - startApply;
+    quint64 lockWaitTime = startApply - startLock;
+
+    _totalBatches++;
+    _totalBatchedEdits += numEdits;
+    _totalEditsMerged += numMerged;
+    _totalBatchDecodeTime += decodeTime;
+    _totalBatchPrepareTime += prepareTime;
+    _totalBatchLockWaitTime += lockWaitTime;
+    _totalBatchApplyTime += applyTime;
+
+    // each packet gets its own decode time, and its share of the rest
+    for (int i = 0; i < numPackets; ++i) {
+        const BatchedPacket& packet = _batch[i];
+        quint64 processTime = packetDecodeTimes[i];
+        quint64 packetLockWaitTime = 0;
+        if (numEdits > 0) {
+            processTime += (prepareTime + applyTime) * packetNumEdits[i] / numEdits;
+            packetLockWaitTime = lockWaitTime * packetNumEdits[i] / numEdits;
+        }
+        QUuid nodeUUID = packet.sendingNode ? packet.sendingNode->getUUID() : QUuid();
+        trackInboundPacket(nodeUUID, packet.sequence, packet.transitTime, packetNumEdits[i], processTime, packetLockWaitTime);
+    }
+
+    // the edits point into the packets
+    edits.clear();
+    _batch.clear();
+}
+
+void OctreeInboundPacketProcessor::decodeBatchedPacket(Octree& tree, const BatchedPacket& packet, OctreeEdits& edits) {
+    ReceivedMessage& message = *packet.message;
+    const unsigned char* editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+    int bytesLeft = (int)message.getBytesLeftToRead();
+
+    while (bytesLeft > 0) {
+        int bytesRead = 0;
+        OctreeEditPointer edit = tree.decodeEditPacketData(message, editData, bytesLeft, packet.sendingNode, bytesRead);
+        if (edit) {
+            edits.push_back(std::move(edit));
+        }
+        if (bytesRead <= 0) {
+            break;
+        }
+        editData += bytesRead;
+        bytesLeft -= bytesRead;
+    }
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
@@ -14,6 +14,9 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <vector>
+
+#include <Octree.h>
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -70,6 +73,15 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    // batched edits, see Octree::handlesBatchedEdits()
+    quint64 getTotalBatchesProcessed() const { return _totalBatches; }
+    quint64 getTotalEditsMerged() const { return _totalEditsMerged; }
+    float getAverageEditsPerBatch() const { return _totalBatches == 0 ? 0.0f : (float)_totalBatchedEdits / _totalBatches; }
+    quint64 getAverageDecodeTimePerBatch() const { return _totalBatches == 0 ? 0 : _totalBatchDecodeTime / _totalBatches; }
+    quint64 getAveragePrepareTimePerBatch() const { return _totalBatches == 0 ? 0 : _totalBatchPrepareTime / _totalBatches; }
+    quint64 getAverageLockWaitTimePerBatch() const { return _totalBatches == 0 ? 0 : _totalBatchLockWaitTime / _totalBatches; }
+    quint64 getAverageApplyTimePerBatch() const { return _totalBatches == 0 ? 0 : _totalBatchApplyTime / _totalBatches; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,10 +95,22 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
 
+    struct BatchedPacket {
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer sendingNode;
+        unsigned short int sequence;
+        quint64 transitTime;
+    };
+
+    // decodes the edit packets queued this pass, and applies their edits under a single write lock
+    void processBatch();
+    void decodeBatchedPacket(Octree& tree, const BatchedPacket& packet, OctreeEdits& edits);
+
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
@@ -99,6 +123,15 @@ private:
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+
+    std::vector<BatchedPacket> _batch;
+    std::atomic<uint64_t> _totalBatches { 0 };
+    std::atomic<uint64_t> _totalBatchedEdits { 0 };
+    std::atomic<uint64_t> _totalEditsMerged { 0 };
+    std::atomic<uint64_t> _totalBatchDecodeTime { 0 };
+    std::atomic<uint64_t> _totalBatchPrepareTime { 0 };
+    std::atomic<uint64_t> _totalBatchLockWaitTime { 0 };
+    std::atomic<uint64_t> _totalBatchApplyTime { 0 };
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
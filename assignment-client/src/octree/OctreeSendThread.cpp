@@ -26,6 +26,11 @@
 quint64 startSceneSleepTime = 0;
 quint64 endSceneSleepTime = 0;
 
+// the least a client is sent when its connection is congested, so that it doesn't starve
+const int64_t MIN_SEND_BYTES_PER_SECOND = 8 * udt::MAX_PACKET_SIZE;
+// how much unspent send budget a client can accumulate
+const int64_t MAX_SEND_TOKENS_USECS = 4 * OCTREE_SEND_INTERVAL_USECS;
+
 OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     _node(node),
     _myServer(myServer),
@@ -321,6 +326,11 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     _trueBytesSent = 0;
     _packetsSentThisInterval = 0;
 
+    // calculate max number of packets that can be sent during this interval
+    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
+    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
+    refillSendTokens(node, nodeData, maxPacketsPerInterval);
+
     bool isFullScene = nodeData->shouldForceFullScene();
     if (isFullScene) {
         // we're forcing a full scene, clear the force in OctreeQueryNode so we don't force it next time again
@@ -363,9 +373,13 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     quint64 start = usecTimestampNow();
 
-    _myServer->getOctree()->withReadLock([&]{
+    if (traversesTreeSnapshot()) {
         traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
-    });
+    } else {
+        _myServer->getOctree()->withReadLock([&]{
+            traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
+        });
+    }
 
     // Here's where we can/should allow the server to send other data...
     // send the environment packet
@@ -385,12 +399,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         _totalSpecialBytes += specialBytesSent;
     }
 
-    // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
-
     // Re-send packets that were nacked by the client
-    while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < maxPacketsPerInterval) {
+    while (nodeData->hasNextNackedPacket() && hasSendBudget(maxPacketsPerInterval)) {
         const NLPacket* packet = nodeData->getNextNackedPacket();
         if (packet) {
             DependencyManager::get<NodeList>()->sendUnreliablePacket(*packet, *node);
@@ -422,9 +432,34 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         }
     }
 
+    _sendTokens -= _trueBytesSent;
+
     return _truePacketsSent;
 }
 
+void OctreeSendThread::refillSendTokens(const SharedNodePointer& node, OctreeQueryNode* nodeData, int maxPacketsPerInterval) {
+    // the configured packet rates are the most a client is sent
+    int64_t bytesPerSecond = (int64_t)maxPacketsPerInterval * INTERVALS_PER_SECOND * udt::MAX_PACKET_SIZE;
+
+    // the congestion control of the client's connection lets a window of packets be in flight per round trip, which
+    // is as much as the client can actually be sent - the stats only hold them for a sample that saw any ACK
+    Node::Stats stats = node->getConnectionStats();
+    if (stats.congestionWindowSize > 0 && stats.rtt > 0) {
+        int64_t connectionBytesPerSecond = (int64_t)stats.congestionWindowSize * udt::MAX_PACKET_SIZE *
+            (int64_t)USECS_PER_SECOND / stats.rtt;
+        bytesPerSecond = std::min(bytesPerSecond, std::max(connectionBytesPerSecond, MIN_SEND_BYTES_PER_SECOND));
+    }
+    nodeData->setSendBytesPerSecond((int)bytesPerSecond);
+
+    quint64 now = usecTimestampNow();
+    quint64 elapsed = _lastSendTokensRefill > 0 ? now - _lastSendTokensRefill : OCTREE_SEND_INTERVAL_USECS;
+    _lastSendTokensRefill = now;
+
+    // tokens left unspent don't pile up past a short burst, but there is always room for a whole packet
+    int64_t maxSendTokens = std::max((int64_t)udt::MAX_PACKET_SIZE, bytesPerSecond * MAX_SEND_TOKENS_USECS / (int64_t)USECS_PER_SECOND);
+    _sendTokens = std::min(maxSendTokens, _sendTokens + bytesPerSecond * (int64_t)elapsed / (int64_t)USECS_PER_SECOND);
+}
+
 bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
     // calculate max number of packets that can be sent during this interval
     int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
@@ -438,10 +473,12 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
     params.trackSend = [this](const QUuid& dataID, quint64 dataEdited) {
         _myServer->trackSend(dataID, dataEdited, _nodeUuid);
     };
+    // every client is sent the same encoding of an item, it only has to be made once
+    params.useEncodedDataCache = true;
 
     bool somethingToSend = true; // assume we have something
     bool hadSomething = hasSomethingToSend(nodeData);
-    while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
+    while (somethingToSend && hasSendBudget(maxPacketsPerInterval) && !nodeData->isShuttingDown()) {
         float compressAndWriteElapsedUsec = OctreeServer::SKIP_TIME;
         float packetSendingElapsedUsec = OctreeServer::SKIP_TIME;
 
@@ -506,7 +543,8 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
     if (somethingToSend && _myServer->wantsVerboseDebug()) {
         qCDebug(octree) << "Hit PPS Limit, packetsSentThisInterval =" << _packetsSentThisInterval
                         << "  maxPacketsPerInterval = " << maxPacketsPerInterval
-                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval;
+                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval
+                        << "  bytesSentThisInterval = " << _trueBytesSent << "  sendTokens = " << _sendTokens;
     }
 
     return params.stopReason == EncodeBitstreamParams::FINISHED;
@@ -56,6 +56,9 @@ protected:
             bool viewFrustumChanged, bool isFullScene);
     virtual bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) = 0;
 
+    /// True if the traversal works on its own snapshot of the tree, so the tree doesn't need to stay read-locked
+    virtual bool traversesTreeSnapshot() const { return false; }
+
     OctreePacketData _packetData;
     QWeakPointer<Node> _node;
     OctreeServer* _myServer { nullptr };
@@ -66,6 +69,10 @@ private:
     virtual void preDistributionProcessing() = 0;
     int handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, bool dontSuppressDuplicate = false);
     int packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged);
+    void refillSendTokens(const SharedNodePointer& node, OctreeQueryNode* nodeData, int maxPacketsPerInterval);
+    bool hasSendBudget(int maxPacketsPerInterval) const {
+        return _packetsSentThisInterval < maxPacketsPerInterval && _trueBytesSent < _sendTokens;
+    }
 
     virtual bool hasSomethingToSend(OctreeQueryNode* nodeData) = 0;
     virtual bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) = 0;
@@ -73,6 +80,10 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
+
+    // token bucket of the bytes the client can be sent, refilled at the rate its connection can take - see refillSendTokens()
+    int64_t _sendTokens { 0 };
+    quint64 _lastSendTokensRefill { 0 };
     bool _isShuttingDown { false };
 };
 
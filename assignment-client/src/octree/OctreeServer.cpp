@@ -368,6 +368,14 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             statsString += getFileLoadTime();
             statsString += "\r\n";
 
+            Octree::LoadStats loadStats = _tree->getLoadStats();
+            statsString += QString("    %1 items loaded: parse %2 msecs, decode %3 msecs, sort %4 msecs, insert %5 msecs\r\n")
+                .arg(loadStats.numItems)
+                .arg(loadStats.parseTime / USECS_PER_MSEC)
+                .arg(loadStats.decodeTime / USECS_PER_MSEC)
+                .arg(loadStats.sortTime / USECS_PER_MSEC)
+                .arg(loadStats.insertTime / USECS_PER_MSEC);
+
             if (_persistFileDownload) {
                 statsString += QString("Persist file: <a href='%1'>Click to Download</a>\r\n").arg(PERSIST_FILE_DOWNLOAD_PATH);
             } else {
@@ -704,6 +712,30 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("            Average Filter Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageFilterTime).rightJustified(COLUMN_WIDTH, ' '));
 
+        if (_tree->handlesBatchedEdits()) {
+            statsString += QString("              Total Edit Batches: %1 batches\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getTotalBatchesProcessed())
+                    .rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("             Average Edits/Batch: %1 edits\r\n")
+                .arg(locale.toString(_octreeInboundPacketProcessor->getAverageEditsPerBatch(), 'f', FLOAT_PRECISION)
+                    .rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("              Total Merged Edits: %1 edits\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getTotalEditsMerged())
+                    .rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("       Average Decode Time/Batch: %1 usecs\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageDecodeTimePerBatch())
+                    .rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("      Average Prepare Time/Batch: %1 usecs\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAveragePrepareTimePerBatch())
+                    .rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("    Average Wait Lock Time/Batch: %1 usecs\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageLockWaitTimePerBatch())
+                    .rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("        Average Apply Time/Batch: %1 usecs\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageApplyTimePerBatch())
+                    .rightJustified(COLUMN_WIDTH, ' '));
+        }
+
 
         int senderNumber = 0;
         NodeToSenderStatsMap allSenderStats = _octreeInboundPacketProcessor->getSingleSenderStats();
@@ -1047,7 +1079,11 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
-        _persistAsFileType = "json.gz";
+        if (!readOptionString("persistFileType", settingsSectionObject, _persistAsFileType)
+            || !PERSIST_EXTENSIONS.contains(_persistAsFileType)) {
+            _persistAsFileType = "ents";
+        }
+        qDebug() << "persistFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1422,6 +1458,17 @@ void OctreeServer::sendStatsPacket() {
     statsArray1["5. clients"] = getCurrentClientCount();
     statsArray1["6. threads"] = threadsStats;
 
+    if (_tree && isInitialLoadComplete()) {
+        Octree::LoadStats loadStats = _tree->getLoadStats();
+        QJsonObject loadPhases;
+        loadPhases["1. items"] = loadStats.numItems;
+        loadPhases["2. parseTime"] = (double)loadStats.parseTime;
+        loadPhases["3. decodeTime"] = (double)loadStats.decodeTime;
+        loadPhases["4. sortTime"] = (double)loadStats.sortTime;
+        loadPhases["5. insertTime"] = (double)loadStats.insertTime;
+        statsArray1["7. persistFileLoadPhases"] = loadPhases;
+    }
+
     // Octree Stats
     QJsonObject octreeStats;
     octreeStats["1. elementCount"] = (double)OctreeElement::getNodeCount();
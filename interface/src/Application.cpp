@@ -6830,6 +6830,8 @@ void Application::queryAvatars() {
             destinationBuffer += view.serialize(destinationBuffer);
         }
 
+        destinationBuffer += DependencyManager::get<AvatarHashMap>()->packJointKeyframeRequests(destinationBuffer);
+
         avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
 
         DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
@@ -16,6 +16,7 @@
 #include <assert.h>
 
 #include "AudioHRTFData.h"
+#include "AudioMixKernels.h"
 
 #if defined(_MSC_VER)
 #define ALIGN32 __declspec(align(32))
@@ -750,43 +751,6 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 
 #endif
 
-// apply gain crossfade with accumulation (interleaved)
-static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
-
-    gain0 *= (1/32768.0f);  // int16_t to float
-    gain1 *= (1/32768.0f);
-
-    for (int i = 0; i < numFrames; i++) {
-
-        float frac = win[i];
-        float gain = gain1 + frac * (gain0 - gain1);
-
-        float x0 = (float)src[i] * gain;
-
-        dst[2*i+0] += x0;
-        dst[2*i+1] += x0;
-    }
-}
-
-// apply gain crossfade with accumulation (interleaved)
-static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
-
-    gain0 *= (1/32768.0f);  // int16_t to float
-    gain1 *= (1/32768.0f);
-
-    for (int i = 0; i < numFrames; i++) {
-
-        float frac = win[i];
-        float gain = gain1 + frac * (gain0 - gain1);
-
-        float x0 = (float)src[2*i+0] * gain;
-        float x1 = (float)src[2*i+1] * gain;
-
-        dst[2*i+0] += x0;
-        dst[2*i+1] += x1;
-    }
-}
-
 // design a 2nd order Thiran allpass
 static void ThiranBiquad(float f, float& b0, float& b1, float& b2, float& a1, float& a2) {
 
@@ -1125,7 +1089,7 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
     }
 }
 
-void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+void AudioHRTF::render(const int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
 
     assert(index >= 0);
     assert(index < HRTF_TABLES);
@@ -1220,7 +1184,7 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _resetState = false;
 }
 
-void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames) {
+void AudioHRTF::mixMono(const int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
 
@@ -1233,7 +1197,7 @@ void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames
     }
 
     // crossfade gain and accumulate
-    gainfade_1x2(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
+    gainfadeMonoToStereo(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
 
     // new parameters become old
     _gainState = gain;
@@ -1241,7 +1205,7 @@ void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames
     _resetState = false;
 }
 
-void AudioHRTF::mixStereo(int16_t* input, float* output, float gain, int numFrames) {
+void AudioHRTF::mixStereo(const int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
 
@@ -1254,7 +1218,7 @@ void AudioHRTF::mixStereo(int16_t* input, float* output, float gain, int numFram
     }
 
     // crossfade gain and accumulate
-    gainfade_2x2(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
+    gainfadeStereoToStereo(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
 
     // new parameters become old
     _gainState = gain;
@@ -11,6 +11,7 @@
 #include <assert.h>
 
 #include "AudioDynamics.h"
+#include "AudioMixKernels.h"
 
 //
 // Limiter (common)
@@ -248,6 +249,9 @@ void LimiterMono<N>::process(float* input, int16_t* output, int numFrames) {
 template<int N>
 class LimiterStereo : public LimiterImpl {
 
+    // frames per pass of the vectorized output stage
+    static const int BLOCK_FRAMES = 256;
+
     MinFilter<N> _filter;
     StereoDelay<N> _delay;
 
@@ -261,41 +265,46 @@ public:
 template<int N>
 void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    float delayed[2*BLOCK_FRAMES];
+    float gains[BLOCK_FRAMES];
+    float dithers[BLOCK_FRAMES];
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
+    for (int offset = 0; offset < numFrames; offset += BLOCK_FRAMES) {
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        int blockFrames = MIN(numFrames - offset, BLOCK_FRAMES);
+        float* in = &input[2*offset];
 
-        // apply envelope
-        attn = envelope(attn);
+        // the envelope is serial, compute the gain for each frame first
+        for (int n = 0; n < blockFrames; n++) {
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // peak detect and convert to log2 domain
+            int32_t peak = peaklog2(&in[2*n+0], &in[2*n+1]);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // compute limiter attenuation
+            int32_t attn = MAX(_threshold - peak, 0);
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
+            // apply envelope
+            attn = envelope(attn);
 
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
+            // convert from log2 domain
+            attn = fixexp2(attn);
 
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
+            // lowpass filter
+            attn = _filter.process(attn);
+            gains[n] = attn * _outGain;
 
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
+            // delay audio
+            float x0 = in[2*n+0];
+            float x1 = in[2*n+1];
+            _delay.process(x0, x1);
+            delayed[2*n+0] = x0;
+            delayed[2*n+1] = x1;
+
+            dithers[n] = dither();
+        }
+
+        // apply gain and dither, store 16-bit output
+        gainDitherPackStereo(delayed, gains, dithers, &output[2*offset], blockFrames);
     }
 }
 
@@ -0,0 +1,314 @@
+//
+//  AudioMixKernels.cpp
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixKernels.h"
+
+#include <assert.h>
+
+#include "CPUDetect.h"
+
+// the SIMD kernels process blocks of this many frames, the rest is finished by the reference code
+static const int SIMD_BLOCK_FRAMES = 16;
+
+//
+// portable reference code
+//
+
+static void gainfade_1x2_ref(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float frac = win[i];
+        float gain = gain1 + frac * (gain0 - gain1);
+
+        float x0 = (float)src[i] * gain;
+
+        dst[2*i+0] += x0;
+        dst[2*i+1] += x0;
+    }
+}
+
+static void gainfade_2x2_ref(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float frac = win[i];
+        float gain = gain1 + frac * (gain0 - gain1);
+
+        float x0 = (float)src[2*i+0] * gain;
+        float x1 = (float)src[2*i+1] * gain;
+
+        dst[2*i+0] += x0;
+        dst[2*i+1] += x1;
+    }
+}
+
+static bool nonzero_ref(const float* src, int numSamples) {
+
+    for (int i = 0; i < numSamples; i++) {
+        if (src[i] != 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(ARCH_X86)
+
+#include <emmintrin.h>
+
+// round to nearest even, the same as the SIMD conversions in the default rounding mode
+static inline int32_t roundToInt(float x) {
+    return _mm_cvt_ss2si(_mm_set_ss(x));
+}
+
+#else
+
+// round to nearest
+static inline int32_t roundToInt(float x) {
+    x += (x < 0.0f ? -0.5f : 0.5f);
+    return (int32_t)x;
+}
+
+#endif
+
+static inline int16_t saturateToInt16(int32_t x) {
+    return (int16_t)(x < -32768 ? -32768 : (x > 32767 ? 32767 : x));
+}
+
+static void gainDitherPack_2x2_ref(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float x0 = src[2*i+0] * gain[i];
+        float x1 = src[2*i+1] * gain[i];
+
+        x0 += dither[i];
+        x1 += dither[i];
+
+        dst[2*i+0] = saturateToInt16(roundToInt(x0));
+        dst[2*i+1] = saturateToInt16(roundToInt(x1));
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(ARCH_X86)
+
+static void gainfade_1x2_SSE(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m128 g1 = _mm_set1_ps(gain1);
+    __m128 gd = _mm_set1_ps(gain0 - gain1);
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 gain = _mm_add_ps(g1, _mm_mul_ps(_mm_loadu_ps(&win[i]), gd));
+
+        // sign extend 4 samples to int32, then convert
+        __m128i s = _mm_loadl_epi64((const __m128i*)&src[i]);
+        __m128 x0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+
+        x0 = _mm_mul_ps(x0, gain);
+
+        // mono to both channels
+        __m128 d0 = _mm_add_ps(_mm_loadu_ps(&dst[2*i+0]), _mm_unpacklo_ps(x0, x0));
+        __m128 d1 = _mm_add_ps(_mm_loadu_ps(&dst[2*i+4]), _mm_unpackhi_ps(x0, x0));
+
+        _mm_storeu_ps(&dst[2*i+0], d0);
+        _mm_storeu_ps(&dst[2*i+4], d1);
+    }
+}
+
+static void gainfade_2x2_SSE(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m128 g1 = _mm_set1_ps(gain1);
+    __m128 gd = _mm_set1_ps(gain0 - gain1);
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 gain = _mm_add_ps(g1, _mm_mul_ps(_mm_loadu_ps(&win[i]), gd));
+
+        // sign extend 8 samples to int32, then convert
+        __m128i s = _mm_loadu_si128((const __m128i*)&src[2*i]);
+        __m128 x0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+        __m128 x1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+
+        // per-frame gain to both channels
+        x0 = _mm_mul_ps(x0, _mm_unpacklo_ps(gain, gain));
+        x1 = _mm_mul_ps(x1, _mm_unpackhi_ps(gain, gain));
+
+        _mm_storeu_ps(&dst[2*i+0], _mm_add_ps(_mm_loadu_ps(&dst[2*i+0]), x0));
+        _mm_storeu_ps(&dst[2*i+4], _mm_add_ps(_mm_loadu_ps(&dst[2*i+4]), x1));
+    }
+}
+
+static bool nonzero_SSE(const float* src, int numSamples) {
+
+    __m128 zero = _mm_setzero_ps();
+
+    assert(numSamples % 8 == 0);
+
+    for (int i = 0; i < numSamples; i += 8) {
+
+        __m128 x0 = _mm_cmpneq_ps(_mm_loadu_ps(&src[i+0]), zero);
+        __m128 x1 = _mm_cmpneq_ps(_mm_loadu_ps(&src[i+4]), zero);
+
+        if (_mm_movemask_ps(_mm_or_ps(x0, x1))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void gainDitherPack_2x2_SSE(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 g = _mm_loadu_ps(&gain[i]);
+        __m128 d = _mm_loadu_ps(&dither[i]);
+
+        __m128 x0 = _mm_mul_ps(_mm_loadu_ps(&src[2*i+0]), _mm_unpacklo_ps(g, g));
+        __m128 x1 = _mm_mul_ps(_mm_loadu_ps(&src[2*i+4]), _mm_unpackhi_ps(g, g));
+
+        x0 = _mm_add_ps(x0, _mm_unpacklo_ps(d, d));
+        x1 = _mm_add_ps(x1, _mm_unpackhi_ps(d, d));
+
+        // round to int32, then pack to int16 with saturation
+        __m128i y = _mm_packs_epi32(_mm_cvtps_epi32(x0), _mm_cvtps_epi32(x1));
+
+        _mm_storeu_si128((__m128i*)&dst[2*i], y);
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+void gainfade_1x2_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfade_2x2_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+bool nonzero_AVX2(const float* src, int numSamples);
+void gainDitherPack_2x2_AVX2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames);
+
+void gainfade_1x2_AVX512(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfade_2x2_AVX512(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+bool nonzero_AVX512(const float* src, int numSamples);
+void gainDitherPack_2x2_AVX512(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames);
+
+static void gainfade_1x2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX512() ? gainfade_1x2_AVX512 : (cpuSupportsAVX2() ? gainfade_1x2_AVX2 : gainfade_1x2_SSE);
+    (*f)(src, dst, win, gain0, gain1, numFrames); // dispatch
+}
+
+static void gainfade_2x2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX512() ? gainfade_2x2_AVX512 : (cpuSupportsAVX2() ? gainfade_2x2_AVX2 : gainfade_2x2_SSE);
+    (*f)(src, dst, win, gain0, gain1, numFrames); // dispatch
+}
+
+static bool nonzero(const float* src, int numSamples) {
+    static auto f = cpuSupportsAVX512() ? nonzero_AVX512 : (cpuSupportsAVX2() ? nonzero_AVX2 : nonzero_SSE);
+    return (*f)(src, numSamples); // dispatch
+}
+
+static void gainDitherPack_2x2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+    static auto f = cpuSupportsAVX512() ? gainDitherPack_2x2_AVX512
+                                        : (cpuSupportsAVX2() ? gainDitherPack_2x2_AVX2 : gainDitherPack_2x2_SSE);
+    (*f)(src, gain, dither, dst, numFrames); // dispatch
+}
+
+#else   // portable reference code
+
+static void gainfade_1x2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    gainfade_1x2_ref(src, dst, win, gain0, gain1, numFrames);
+}
+
+static void gainfade_2x2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    gainfade_2x2_ref(src, dst, win, gain0, gain1, numFrames);
+}
+
+static bool nonzero(const float* src, int numSamples) {
+    return nonzero_ref(src, numSamples);
+}
+
+static void gainDitherPack_2x2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+    gainDitherPack_2x2_ref(src, gain, dither, dst, numFrames);
+}
+
+#endif
+
+void gainfadeMonoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    int numBlockFrames = numFrames - (numFrames % SIMD_BLOCK_FRAMES);
+
+    gainfade_1x2(src, dst, win, gain0, gain1, numBlockFrames);
+    gainfade_1x2_ref(&src[numBlockFrames], &dst[2*numBlockFrames], &win[numBlockFrames], gain0, gain1,
+                     numFrames - numBlockFrames);
+}
+
+void gainfadeStereoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    int numBlockFrames = numFrames - (numFrames % SIMD_BLOCK_FRAMES);
+
+    gainfade_2x2(src, dst, win, gain0, gain1, numBlockFrames);
+    gainfade_2x2_ref(&src[2*numBlockFrames], &dst[2*numBlockFrames], &win[numBlockFrames], gain0, gain1,
+                     numFrames - numBlockFrames);
+}
+
+bool hasNonZeroSamples(const float* src, int numSamples) {
+
+    int numBlockSamples = numSamples - (numSamples % SIMD_BLOCK_FRAMES);
+
+    return nonzero(src, numBlockSamples) || nonzero_ref(&src[numBlockSamples], numSamples - numBlockSamples);
+}
+
+void gainDitherPackStereo(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    int numBlockFrames = numFrames - (numFrames % SIMD_BLOCK_FRAMES);
+
+    gainDitherPack_2x2(src, gain, dither, dst, numBlockFrames);
+    gainDitherPack_2x2_ref(&src[2*numBlockFrames], &gain[numBlockFrames], &dither[numBlockFrames], &dst[2*numBlockFrames],
+                           numFrames - numBlockFrames);
+}
+
+void gainfadeMonoToStereoReference(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    gainfade_1x2_ref(src, dst, win, gain0, gain1, numFrames);
+}
+
+void gainfadeStereoToStereoReference(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    gainfade_2x2_ref(src, dst, win, gain0, gain1, numFrames);
+}
+
+bool hasNonZeroSamplesReference(const float* src, int numSamples) {
+    return nonzero_ref(src, numSamples);
+}
+
+void gainDitherPackStereoReference(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+    gainDitherPack_2x2_ref(src, gain, dither, dst, numFrames);
+}
@@ -0,0 +1,39 @@
+//
+//  AudioMixKernels.h
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixKernels_h
+#define hifi_AudioMixKernels_h
+
+#include <stdint.h>
+
+//
+// Inner loops of the audio mix, dispatched at runtime to SSE2/AVX2/AVX512 on x86.
+// Results are bit-exact with the portable reference code.
+//
+
+// Gain crossfade (gain0 to gain1, following win) of int16_t input, accumulated into interleaved stereo float output.
+// Mono input is mixed to both output channels, stereo input is interleaved.
+void gainfadeMonoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfadeStereoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+
+// Returns true if any sample is not 0.0f
+bool hasNonZeroSamples(const float* src, int numSamples);
+
+// Applies a per-frame gain and dither to interleaved stereo float input, rounds to nearest and packs
+// to 16-bit with saturation
+void gainDitherPackStereo(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames);
+
+// The same, using only the portable reference code, to test the dispatched kernels against
+void gainfadeMonoToStereoReference(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfadeStereoToStereoReference(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+bool hasNonZeroSamplesReference(const float* src, int numSamples);
+void gainDitherPackStereoReference(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames);
+
+#endif // hifi_AudioMixKernels_h
@@ -0,0 +1,133 @@
+//
+//  AudioMixKernels_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// don't fuse the multiplies and adds, the results must match the reference code exactly
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+void gainfade_1x2_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m256 g1 = _mm256_set1_ps(gain1);
+    __m256 gd = _mm256_set1_ps(gain0 - gain1);
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 gain = _mm256_add_ps(g1, _mm256_mul_ps(_mm256_loadu_ps(&win[i]), gd));
+
+        __m256 x0 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)&src[i])));
+        x0 = _mm256_mul_ps(x0, gain);
+
+        // mono to both channels
+        __m256 lo = _mm256_unpacklo_ps(x0, x0);
+        __m256 hi = _mm256_unpackhi_ps(x0, x0);
+
+        __m256 d0 = _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+0]), _mm256_permute2f128_ps(lo, hi, 0x20));
+        __m256 d1 = _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+8]), _mm256_permute2f128_ps(lo, hi, 0x31));
+
+        _mm256_storeu_ps(&dst[2*i+0], d0);
+        _mm256_storeu_ps(&dst[2*i+8], d1);
+    }
+
+    _mm256_zeroupper();
+}
+
+void gainfade_2x2_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m256 g1 = _mm256_set1_ps(gain1);
+    __m256 gd = _mm256_set1_ps(gain0 - gain1);
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 gain = _mm256_add_ps(g1, _mm256_mul_ps(_mm256_loadu_ps(&win[i]), gd));
+
+        // per-frame gain to both channels
+        __m256 lo = _mm256_unpacklo_ps(gain, gain);
+        __m256 hi = _mm256_unpackhi_ps(gain, gain);
+        __m256 g0 = _mm256_permute2f128_ps(lo, hi, 0x20);
+        __m256 g8 = _mm256_permute2f128_ps(lo, hi, 0x31);
+
+        __m256 x0 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)&src[2*i+0])));
+        __m256 x1 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)&src[2*i+8])));
+
+        x0 = _mm256_mul_ps(x0, g0);
+        x1 = _mm256_mul_ps(x1, g8);
+
+        _mm256_storeu_ps(&dst[2*i+0], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+0]), x0));
+        _mm256_storeu_ps(&dst[2*i+8], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+8]), x1));
+    }
+
+    _mm256_zeroupper();
+}
+
+bool nonzero_AVX2(const float* src, int numSamples) {
+
+    __m256 zero = _mm256_setzero_ps();
+    bool result = false;
+
+    assert(numSamples % 16 == 0);
+
+    for (int i = 0; i < numSamples; i += 16) {
+
+        __m256 x0 = _mm256_cmp_ps(_mm256_loadu_ps(&src[i+0]), zero, _CMP_NEQ_UQ);
+        __m256 x1 = _mm256_cmp_ps(_mm256_loadu_ps(&src[i+8]), zero, _CMP_NEQ_UQ);
+
+        if (_mm256_movemask_ps(_mm256_or_ps(x0, x1))) {
+            result = true;
+            break;
+        }
+    }
+
+    _mm256_zeroupper();
+    return result;
+}
+
+void gainDitherPack_2x2_AVX2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 g = _mm256_loadu_ps(&gain[i]);
+        __m256 d = _mm256_loadu_ps(&dither[i]);
+
+        // per-frame gain and dither to both channels
+        __m256 gl = _mm256_unpacklo_ps(g, g);
+        __m256 gh = _mm256_unpackhi_ps(g, g);
+        __m256 dl = _mm256_unpacklo_ps(d, d);
+        __m256 dh = _mm256_unpackhi_ps(d, d);
+
+        __m256 x0 = _mm256_mul_ps(_mm256_loadu_ps(&src[2*i+0]), _mm256_permute2f128_ps(gl, gh, 0x20));
+        __m256 x1 = _mm256_mul_ps(_mm256_loadu_ps(&src[2*i+8]), _mm256_permute2f128_ps(gl, gh, 0x31));
+
+        x0 = _mm256_add_ps(x0, _mm256_permute2f128_ps(dl, dh, 0x20));
+        x1 = _mm256_add_ps(x1, _mm256_permute2f128_ps(dl, dh, 0x31));
+
+        // round to int32, pack to int16 with saturation (per 128-bit lane), then restore the sample order
+        __m256i y = _mm256_packs_epi32(_mm256_cvtps_epi32(x0), _mm256_cvtps_epi32(x1));
+        y = _mm256_permute4x64_epi64(y, 0xd8);
+
+        _mm256_storeu_si256((__m256i*)&dst[2*i], y);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
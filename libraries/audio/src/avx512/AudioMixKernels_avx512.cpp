@@ -0,0 +1,129 @@
+//
+//  AudioMixKernels_avx512.cpp
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX512F__
+
+#include <assert.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// don't fuse the multiplies and adds, the results must match the reference code exactly
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// duplicate each of the low or high 8 elements, to spread per-frame values over interleaved stereo
+static inline __m512i duplicateLow() {
+    return _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+}
+
+static inline __m512i duplicateHigh() {
+    return _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+}
+
+void gainfade_1x2_AVX512(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m512 g1 = _mm512_set1_ps(gain1);
+    __m512 gd = _mm512_set1_ps(gain0 - gain1);
+    __m512i lo = duplicateLow();
+    __m512i hi = duplicateHigh();
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 gain = _mm512_add_ps(g1, _mm512_mul_ps(_mm512_loadu_ps(&win[i]), gd));
+
+        __m512 x0 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)&src[i])));
+        x0 = _mm512_mul_ps(x0, gain);
+
+        // mono to both channels
+        __m512 d0 = _mm512_add_ps(_mm512_loadu_ps(&dst[2*i+0]), _mm512_permutexvar_ps(lo, x0));
+        __m512 d1 = _mm512_add_ps(_mm512_loadu_ps(&dst[2*i+16]), _mm512_permutexvar_ps(hi, x0));
+
+        _mm512_storeu_ps(&dst[2*i+0], d0);
+        _mm512_storeu_ps(&dst[2*i+16], d1);
+    }
+
+    _mm256_zeroupper();
+}
+
+void gainfade_2x2_AVX512(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m512 g1 = _mm512_set1_ps(gain1);
+    __m512 gd = _mm512_set1_ps(gain0 - gain1);
+    __m512i lo = duplicateLow();
+    __m512i hi = duplicateHigh();
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 gain = _mm512_add_ps(g1, _mm512_mul_ps(_mm512_loadu_ps(&win[i]), gd));
+
+        __m512 x0 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)&src[2*i+0])));
+        __m512 x1 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)&src[2*i+16])));
+
+        // per-frame gain to both channels
+        x0 = _mm512_mul_ps(x0, _mm512_permutexvar_ps(lo, gain));
+        x1 = _mm512_mul_ps(x1, _mm512_permutexvar_ps(hi, gain));
+
+        _mm512_storeu_ps(&dst[2*i+0], _mm512_add_ps(_mm512_loadu_ps(&dst[2*i+0]), x0));
+        _mm512_storeu_ps(&dst[2*i+16], _mm512_add_ps(_mm512_loadu_ps(&dst[2*i+16]), x1));
+    }
+
+    _mm256_zeroupper();
+}
+
+bool nonzero_AVX512(const float* src, int numSamples) {
+
+    __m512 zero = _mm512_setzero_ps();
+    bool result = false;
+
+    assert(numSamples % 16 == 0);
+
+    for (int i = 0; i < numSamples; i += 16) {
+        if (_mm512_cmp_ps_mask(_mm512_loadu_ps(&src[i]), zero, _CMP_NEQ_UQ)) {
+            result = true;
+            break;
+        }
+    }
+
+    _mm256_zeroupper();
+    return result;
+}
+
+void gainDitherPack_2x2_AVX512(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    __m512i lo = duplicateLow();
+    __m512i hi = duplicateHigh();
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 g = _mm512_loadu_ps(&gain[i]);
+        __m512 d = _mm512_loadu_ps(&dither[i]);
+
+        __m512 x0 = _mm512_mul_ps(_mm512_loadu_ps(&src[2*i+0]), _mm512_permutexvar_ps(lo, g));
+        __m512 x1 = _mm512_mul_ps(_mm512_loadu_ps(&src[2*i+16]), _mm512_permutexvar_ps(hi, g));
+
+        x0 = _mm512_add_ps(x0, _mm512_permutexvar_ps(lo, d));
+        x1 = _mm512_add_ps(x1, _mm512_permutexvar_ps(hi, d));
+
+        // round to int32, then narrow to int16 with saturation
+        _mm256_storeu_si256((__m256i*)&dst[2*i+0], _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(x0)));
+        _mm256_storeu_si256((__m256i*)&dst[2*i+16], _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(x1)));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
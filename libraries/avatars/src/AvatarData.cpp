@@ -19,6 +19,7 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QThread>
 #include <QtCore/QUuid>
+#include <QtCore/QVarLengthArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
@@ -54,9 +55,9 @@ using namespace std;
 
 const QString AvatarData::FRAME_NAME = "com.highfidelity.recording.AvatarData";
 
-static const int TRANSLATION_COMPRESSION_RADIX = 14;
 static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
 static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
+static const int MAX_STACK_JOINTS = 256; // joints are counted in a byte, the batches of their components fit the stack
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
 static const float DEFAULT_AVATAR_DENSITY = 1000.0f; // density of water
 
@@ -271,6 +272,21 @@ float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPositio
     return AVATAR_MIN_TRANSLATION; // Eventually make this distance sensitive as well
 }
 
+int AvatarData::getDistanceBasedJointDeltaPrecision(glm::vec3 viewerPosition) const {
+    auto distance = glm::distance(_globalPosition, viewerPosition);
+    int result = JointDeltas::MAX_PRECISION;
+    if (distance < AVATAR_DISTANCE_LEVEL_1) {
+        result = 0;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_2) {
+        result = 1;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_3) {
+        result = 2;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_4) {
+        result = 3;
+    }
+    return result;
+}
+
 
 // we want to track outbound data in this case...
 QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
@@ -286,9 +302,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
                                    const QVector<JointData>& lastSentJointData, AvatarDataPacket::SendStatus& sendStatus,
                                    bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
                                    QVector<JointData>* sentJointDataOut,
-                                   int maxDataSize, AvatarDataRate* outboundDataRateOut) const {
+                                   int maxDataSize, AvatarDataRate* outboundDataRateOut,
+                                   JointDeltas::Keyframe* keyframe) const {
 
-    bool cullSmallChanges = (dataDetail == CullSmallData);
+    bool cullSmallChanges = (dataDetail == CullSmallData || dataDetail == JointDeltaData);
     bool sendAll = (dataDetail == SendAllData);
     bool sendMinimum = (dataDetail == MinimumData);
     bool sendPALMinimum = (dataDetail == PALMinimum);
@@ -349,6 +366,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         bool hasAudioLoudness = false;
         bool hasSensorToWorldMatrix = false;
         bool hasJointData = false;
+        bool hasJointDeltas = false;
         bool hasJointDefaultPoseFlags = false;
         bool hasAdditionalFlags = false;
 
@@ -378,8 +396,9 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
             hasFaceTrackerInfo = !dropFaceTracking && getHasScriptedBlendshapes() &&
                 (sendAll || faceTrackerInfoChangedSince(lastSentTime));
-            hasJointData = !sendMinimum;
-            hasJointDefaultPoseFlags = hasJointData;
+            hasJointDeltas = dataDetail == JointDeltaData && keyframe && keyframe->isValid();
+            hasJointData = !sendMinimum && !hasJointDeltas;
+            hasJointDefaultPoseFlags = !sendMinimum;
         }
 
         wantedFlags =
@@ -396,15 +415,16 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
             | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
             | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+            | (hasJointDeltas ? AvatarDataPacket::PACKET_HAS_JOINT_DELTAS : 0)
             | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+            | ((hasJointData || hasJointDeltas) ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
 
             sendStatus.itemFlags = wantedFlags;
             sendStatus.rotationsSent = 0;
             sendStatus.translationsSent = 0;
     } else {  // Continuing avatar ...
         wantedFlags = sendStatus.itemFlags;
-        if (wantedFlags & AvatarDataPacket::PACKET_HAS_GRAB_JOINTS) {
+        if ((wantedFlags & AvatarDataPacket::PACKET_HAS_GRAB_JOINTS) && !(wantedFlags & AvatarDataPacket::PACKET_HAS_JOINT_DELTAS)) {
             // Must send joints for grab joints -
             wantedFlags |= AvatarDataPacket::PACKET_HAS_JOINT_DATA;
         }
@@ -679,7 +699,8 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     }
 
     QVector<JointData> jointData;
-    if (wantedFlags & (AvatarDataPacket::PACKET_HAS_JOINT_DATA | AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
+    if (wantedFlags & (AvatarDataPacket::PACKET_HAS_JOINT_DATA | AvatarDataPacket::PACKET_HAS_JOINT_DELTAS |
+                       AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
         QReadLocker readLock(&_jointDataLock);
         jointData = _jointData;
     }
@@ -687,6 +708,90 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     assert(numJoints <= 255);
     const int jointBitVectorSize = calcBitVectorSize(numJoints);
 
+    // the deltas are coded first, as the joint data is sent instead if they would not be smaller, or not fit a packet
+    QByteArray codedJointDeltas;
+    QVector<JointData> decodedJoints;
+    int jointDeltaPrecision = 0;
+    if (wantedFlags & AvatarDataPacket::PACKET_HAS_JOINT_DELTAS) {
+        bool sendDeltas = false;
+        if (keyframe && keyframe->joints.size() == numJoints) {
+            jointDeltaPrecision = distanceAdjust ? getDistanceBasedJointDeltaPrecision(viewerPosition) : 0;
+            decodedJoints = jointData;
+            JointDeltas::encode(jointData.constData(), numJoints, *keyframe, jointDeltaPrecision, codedJointDeltas,
+                                decodedJoints.data());
+            // unlike the joint data, the deltas can't be split across packets: they must fit in an empty one, after
+            // the record's header, or the mixer would never get them out
+            static const int MAX_JOINT_DELTAS_SIZE = NLPacket::maxPayloadSize(PacketType::BulkAvatarData) -
+                (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE;
+            const int jointDeltasSize = (int)AvatarDataPacket::JOINT_DELTAS_HEADER_SIZE + codedJointDeltas.size();
+            sendDeltas = jointDeltasSize <= (int)AvatarDataPacket::maxJointDataSize(numJoints) &&
+                jointDeltasSize <= MAX_JOINT_DELTAS_SIZE;
+        }
+        if (!sendDeltas) {
+            wantedFlags = (wantedFlags & ~AvatarDataPacket::PACKET_HAS_JOINT_DELTAS) | AvatarDataPacket::PACKET_HAS_JOINT_DATA;
+        }
+    }
+
+    auto packFarGrabJoints = [&] {
+        IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
+            // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
+            auto startSection = destinationBuffer;
+
+            glm::vec3 leftFarGrabPosition = extractTranslation(leftFarGrabMatrix);
+            glm::quat leftFarGrabRotation = extractRotation(leftFarGrabMatrix);
+            glm::vec3 rightFarGrabPosition = extractTranslation(rightFarGrabMatrix);
+            glm::quat rightFarGrabRotation = extractRotation(rightFarGrabMatrix);
+            glm::vec3 mouseFarGrabPosition = extractTranslation(mouseFarGrabMatrix);
+            glm::quat mouseFarGrabRotation = extractRotation(mouseFarGrabMatrix);
+
+            AvatarDataPacket::FarGrabJoints farGrabJoints = {
+                { leftFarGrabPosition.x, leftFarGrabPosition.y, leftFarGrabPosition.z },
+                { leftFarGrabRotation.w, leftFarGrabRotation.x, leftFarGrabRotation.y, leftFarGrabRotation.z },
+                { rightFarGrabPosition.x, rightFarGrabPosition.y, rightFarGrabPosition.z },
+                { rightFarGrabRotation.w, rightFarGrabRotation.x, rightFarGrabRotation.y, rightFarGrabRotation.z },
+                { mouseFarGrabPosition.x, mouseFarGrabPosition.y, mouseFarGrabPosition.z },
+                { mouseFarGrabRotation.w, mouseFarGrabRotation.x, mouseFarGrabRotation.y, mouseFarGrabRotation.z }
+            };
+
+            memcpy(destinationBuffer, &farGrabJoints, sizeof(farGrabJoints));
+            destinationBuffer += sizeof(AvatarDataPacket::FarGrabJoints);
+            int numBytes = destinationBuffer - startSection;
+
+            if (outboundDataRateOut) {
+                outboundDataRateOut->farGrabJointRate.increment(numBytes);
+            }
+        }
+    };
+
+    IF_AVATAR_SPACE(PACKET_HAS_JOINT_DELTAS, AvatarDataPacket::JOINT_DELTAS_HEADER_SIZE + codedJointDeltas.size()) {
+        auto startSection = destinationBuffer;
+
+        AvatarDataPacket::JointDeltasHeader header;
+        header.numJoints = (uint8_t)numJoints;
+        header.keyframeHash = keyframe->hash;
+        header.precision = (uint8_t)jointDeltaPrecision;
+        header.codedSize = (uint16_t)codedJointDeltas.size();
+        AVATAR_MEMCPY(header);
+        memcpy(destinationBuffer, codedJointDeltas.constData(), codedJointDeltas.size());
+        destinationBuffer += codedJointDeltas.size();
+
+        if (sentJointDataOut) {
+            *sentJointDataOut = decodedJoints;
+        }
+
+        packFarGrabJoints();
+
+        int numBytes = destinationBuffer - startSection;
+        if (outboundDataRateOut) {
+            outboundDataRateOut->jointDataRate.increment(numBytes);
+        }
+    }
+
+    // where the sections a keyframe is made of are, if they are included
+    const unsigned char* jointDataSectionStart = nullptr;
+    const unsigned char* jointDataSectionEnd = nullptr;
+    const unsigned char* defaultPoseFlagsSectionStart = nullptr;
+
     // include jointData if there is room for the most minimal section. i.e. no translations or rotations.
     IF_AVATAR_SPACE(PACKET_HAS_JOINT_DATA, AvatarDataPacket::minJointDataSize(numJoints)) {
         // Minimum space required for another rotation joint -
@@ -728,12 +833,20 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
+        // the joints to send are picked first, and then packed all at once
+        QVarLengthArray<float, 4 * MAX_STACK_JOINTS> rotations(4 * numJoints);
+        float* const rotationComponents[4] = {
+            rotations.data(), rotations.data() + numJoints, rotations.data() + 2 * numJoints, rotations.data() + 3 * numJoints
+        };
+        int numRotations = 0;
+        const ptrdiff_t ROTATION_SIZE = sizeof(AvatarDataPacket::SixByteQuat);
+
         int i = sendStatus.rotationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
+            if (packetEnd - destinationBuffer - numRotations * ROTATION_SIZE >= minSizeForJoint) {
                 if (!data.rotationIsDefaultPose) {
                     // The dot product for larger rotations is a lower number,
                     // so if the dot() is less than the value, then the rotation is a larger angle of rotation
@@ -743,7 +856,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        for (int component = 0; component < 4; ++component) {
+                            rotationComponents[component][numRotations] = data.rotation[component];
+                        }
+                        ++numRotations;
 
                         if (sentJoints) {
                             sentJoints[i].rotation = data.rotation;
@@ -759,6 +875,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             }
 
         }
+        destinationBuffer += packOrientationQuatsToSixBytes(destinationBuffer, rotationComponents, numRotations);
         sendStatus.rotationsSent = i;
 
         // joint translation data
@@ -777,13 +894,20 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
+        QVarLengthArray<float, 3 * MAX_STACK_JOINTS> translations(3 * numJoints);
+        float* const translationComponents[3] = {
+            translations.data(), translations.data() + numJoints, translations.data() + 2 * numJoints
+        };
+        int numTranslations = 0;
+        const ptrdiff_t TRANSLATION_SIZE = 3 * sizeof(int16_t);
+
         i = sendStatus.translationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
             // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
+            if (packetEnd - destinationBuffer - numTranslations * TRANSLATION_SIZE >= minSizeForJoint) {
                 if (!data.translationIsDefaultPose) {
                     if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
                         || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
@@ -791,8 +915,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        glm::vec3 translation = data.translation / maxTranslationDimension;
+                        for (int component = 0; component < 3; ++component) {
+                            translationComponents[component][numTranslations] = translation[component];
+                        }
+                        ++numTranslations;
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -808,36 +935,13 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             }
 
         }
+        destinationBuffer += packFloatVec3sToSignedTwoByteFixed(destinationBuffer, translationComponents, numTranslations,
+                                                                TRANSLATION_COMPRESSION_RADIX);
         sendStatus.translationsSent = i;
+        jointDataSectionStart = startSection;
+        jointDataSectionEnd = destinationBuffer;
 
-        IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
-            // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
-            auto startSection = destinationBuffer;
-
-            glm::vec3 leftFarGrabPosition = extractTranslation(leftFarGrabMatrix);
-            glm::quat leftFarGrabRotation = extractRotation(leftFarGrabMatrix);
-            glm::vec3 rightFarGrabPosition = extractTranslation(rightFarGrabMatrix);
-            glm::quat rightFarGrabRotation = extractRotation(rightFarGrabMatrix);
-            glm::vec3 mouseFarGrabPosition = extractTranslation(mouseFarGrabMatrix);
-            glm::quat mouseFarGrabRotation = extractRotation(mouseFarGrabMatrix);
-
-            AvatarDataPacket::FarGrabJoints farGrabJoints = {
-                { leftFarGrabPosition.x, leftFarGrabPosition.y, leftFarGrabPosition.z },
-                { leftFarGrabRotation.w, leftFarGrabRotation.x, leftFarGrabRotation.y, leftFarGrabRotation.z },
-                { rightFarGrabPosition.x, rightFarGrabPosition.y, rightFarGrabPosition.z },
-                { rightFarGrabRotation.w, rightFarGrabRotation.x, rightFarGrabRotation.y, rightFarGrabRotation.z },
-                { mouseFarGrabPosition.x, mouseFarGrabPosition.y, mouseFarGrabPosition.z },
-                { mouseFarGrabRotation.w, mouseFarGrabRotation.x, mouseFarGrabRotation.y, mouseFarGrabRotation.z }
-            };
-
-            memcpy(destinationBuffer, &farGrabJoints, sizeof(farGrabJoints));
-            destinationBuffer += sizeof(AvatarDataPacket::FarGrabJoints);
-            int numBytes = destinationBuffer - startSection;
-
-            if (outboundDataRateOut) {
-                outboundDataRateOut->farGrabJointRate.increment(numBytes);
-            }
-        }
+        packFarGrabJoints();
 
 #ifdef WANT_DEBUG
         if (sendAll) {
@@ -864,6 +968,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     IF_AVATAR_SPACE(PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS, 1 + 2 * jointBitVectorSize) {
         auto startSection = destinationBuffer;
+        defaultPoseFlagsSectionStart = startSection;
 
         // write numJoints
         *destinationBuffer++ = (uint8_t)numJoints;
@@ -884,6 +989,16 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         }
     }
 
+    // the receiver makes the same keyframe out of the same bytes
+    if (keyframe && jointDataSectionStart && defaultPoseFlagsSectionStart) {
+        JointDeltas::Keyframe newKeyframe = JointDeltas::keyframeFromSections(
+            jointDataSectionStart, (int)(jointDataSectionEnd - jointDataSectionStart),
+            defaultPoseFlagsSectionStart, (int)(destinationBuffer - defaultPoseFlagsSectionStart));
+        if (newKeyframe.isValid()) {
+            *keyframe = newKeyframe;
+        }
+    }
+
     memcpy(packetFlagsLocation, &includedFlags, sizeof(includedFlags));
     // Return dropped items.
     sendStatus.itemFlags = (wantedFlags & ~includedFlags) | extraReturnedFlags;
@@ -977,6 +1092,9 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     const unsigned char* sourceBuffer = startPosition;
 
     // read the packet flags
+    if (buffer.size() < (int)sizeof(packetStateFlags)) {
+        return buffer.size();
+    }
     memcpy(&packetStateFlags, sourceBuffer, sizeof(packetStateFlags));
     sourceBuffer += sizeof(packetStateFlags);
 
@@ -997,6 +1115,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasJointData             = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
     bool hasJointDefaultPoseFlags = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS);
     bool hasGrabJoints            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_GRAB_JOINTS);
+    bool hasJointDeltas           = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DELTAS);
 
     quint64 now = usecTimestampNow();
 
@@ -1320,6 +1439,12 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         _faceTrackerUpdateRate.increment();
     }
 
+    // where the sections a keyframe is made of are, if they are included
+    const unsigned char* jointDataSectionStart = nullptr;
+    const unsigned char* jointDataSectionEnd = nullptr;
+    const unsigned char* defaultPoseFlagsSectionStart = nullptr;
+    const unsigned char* defaultPoseFlagsSectionEnd = nullptr;
+
     if (hasJointData) {
         auto startSection = sourceBuffer;
 
@@ -1353,10 +1478,21 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
 
         const int COMPRESSED_QUATERNION_SIZE = 6;
         PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
+
+        // unpack them all at once, then hand them to their joints
+        QVarLengthArray<float, 4 * MAX_STACK_JOINTS> rotations(4 * numValidJointRotations);
+        float* const rotationComponents[4] = {
+            rotations.data(), rotations.data() + numValidJointRotations,
+            rotations.data() + 2 * numValidJointRotations, rotations.data() + 3 * numValidJointRotations
+        };
+        sourceBuffer += unpackOrientationQuatsFromSixBytes(sourceBuffer, rotationComponents, numValidJointRotations);
+        for (int i = 0, j = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                for (int component = 0; component < 4; ++component) {
+                    data.rotation[component] = rotationComponents[component][j];
+                }
+                ++j;
                 _hasNewJointData = true;
                 data.rotationIsDefaultPose = false;
             }
@@ -1394,10 +1530,19 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         const int COMPRESSED_TRANSLATION_SIZE = 6;
         PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
 
-        for (int i = 0; i < numJoints; i++) {
+        QVarLengthArray<float, 3 * MAX_STACK_JOINTS> translations(3 * numValidJointTranslations);
+        float* const translationComponents[3] = {
+            translations.data(), translations.data() + numValidJointTranslations,
+            translations.data() + 2 * numValidJointTranslations
+        };
+        sourceBuffer += unpackFloatVec3sFromSignedTwoByteFixed(sourceBuffer, translationComponents, numValidJointTranslations,
+                                                               TRANSLATION_COMPRESSION_RADIX);
+        for (int i = 0, j = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                data.translation = glm::vec3(translationComponents[0][j], translationComponents[1][j],
+                                             translationComponents[2][j]);
+                ++j;
                 data.translation *= maxTranslationDimension;
                 _hasNewJointData = true;
                 data.translationIsDefaultPose = false;
@@ -1411,49 +1556,81 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
                 << "size:" << (int)(sourceBuffer - startPosition);
         }
 #endif
+        jointDataSectionStart = startSection;
+        jointDataSectionEnd = sourceBuffer;
+
         int numBytesRead = sourceBuffer - startSection;
         _jointDataRate.increment(numBytesRead);
         _jointDataUpdateRate.increment();
 
-        if (hasGrabJoints) {
-            auto startSection = sourceBuffer;
-
-            PACKET_READ_CHECK(FarGrabJoints, sizeof(AvatarDataPacket::FarGrabJoints));
-
-            AvatarDataPacket::FarGrabJoints farGrabJoints;
-            memcpy(&farGrabJoints, sourceBuffer, sizeof(farGrabJoints)); // to avoid misaligned floats
-
-            glm::vec3 leftFarGrabPosition = glm::vec3(farGrabJoints.leftFarGrabPosition[0],
-                                                      farGrabJoints.leftFarGrabPosition[1],
-                                                      farGrabJoints.leftFarGrabPosition[2]);
-            glm::quat leftFarGrabRotation = glm::quat(farGrabJoints.leftFarGrabRotation[0],
-                                                      farGrabJoints.leftFarGrabRotation[1],
-                                                      farGrabJoints.leftFarGrabRotation[2],
-                                                      farGrabJoints.leftFarGrabRotation[3]);
-            glm::vec3 rightFarGrabPosition = glm::vec3(farGrabJoints.rightFarGrabPosition[0],
-                                                       farGrabJoints.rightFarGrabPosition[1],
-                                                       farGrabJoints.rightFarGrabPosition[2]);
-            glm::quat rightFarGrabRotation = glm::quat(farGrabJoints.rightFarGrabRotation[0],
-                                                       farGrabJoints.rightFarGrabRotation[1],
-                                                       farGrabJoints.rightFarGrabRotation[2],
-                                                       farGrabJoints.rightFarGrabRotation[3]);
-            glm::vec3 mouseFarGrabPosition = glm::vec3(farGrabJoints.mouseFarGrabPosition[0],
-                                                       farGrabJoints.mouseFarGrabPosition[1],
-                                                       farGrabJoints.mouseFarGrabPosition[2]);
-            glm::quat mouseFarGrabRotation = glm::quat(farGrabJoints.mouseFarGrabRotation[0],
-                                                       farGrabJoints.mouseFarGrabRotation[1],
-                                                       farGrabJoints.mouseFarGrabRotation[2],
-                                                       farGrabJoints.mouseFarGrabRotation[3]);
-
-            _farGrabLeftMatrixCache.set(createMatFromQuatAndPos(leftFarGrabRotation, leftFarGrabPosition));
-            _farGrabRightMatrixCache.set(createMatFromQuatAndPos(rightFarGrabRotation, rightFarGrabPosition));
-            _farGrabMouseMatrixCache.set(createMatFromQuatAndPos(mouseFarGrabRotation, mouseFarGrabPosition));
-
-            sourceBuffer += sizeof(AvatarDataPacket::FarGrabJoints);
-            int numBytesRead = sourceBuffer - startSection;
-            _farGrabJointRate.increment(numBytesRead);
-            _farGrabJointUpdateRate.increment();
+    }
+
+    if (hasJointDeltas) {
+        auto startSection = sourceBuffer;
+
+        PACKET_READ_CHECK(JointDeltasHeader, sizeof(AvatarDataPacket::JointDeltasHeader));
+        AvatarDataPacket::JointDeltasHeader header;
+        memcpy(&header, sourceBuffer, sizeof(header));
+        sourceBuffer += sizeof(header);
+        PACKET_READ_CHECK(JointDeltas, header.codedSize);
+
+        QWriteLocker writeLock(&_jointDataLock);
+        // deltas from a keyframe this avatar didn't get are dropped, until the next complete joint data
+        if (_jointDeltaKeyframe.isValid() && _jointDeltaKeyframe.hash == header.keyframeHash &&
+            _jointDeltaKeyframe.joints.size() == header.numJoints) {
+            _jointData.resize(header.numJoints);
+            JointDeltas::decode(sourceBuffer, header.codedSize, _jointDeltaKeyframe, header.precision, _jointData.data(),
+                                header.numJoints);
+            _hasNewJointData = true;
+        } else {
+            _isMissingJointKeyframe = true;
         }
+        sourceBuffer += header.codedSize;
+
+        int numBytesRead = sourceBuffer - startSection;
+        _jointDataRate.increment(numBytesRead);
+        _jointDataUpdateRate.increment();
+    }
+
+    // the far grab joints follow the joints, whichever way they are sent
+    if (hasGrabJoints && (hasJointData || hasJointDeltas)) {
+        auto startSection = sourceBuffer;
+
+        PACKET_READ_CHECK(FarGrabJoints, sizeof(AvatarDataPacket::FarGrabJoints));
+
+        AvatarDataPacket::FarGrabJoints farGrabJoints;
+        memcpy(&farGrabJoints, sourceBuffer, sizeof(farGrabJoints)); // to avoid misaligned floats
+
+        glm::vec3 leftFarGrabPosition = glm::vec3(farGrabJoints.leftFarGrabPosition[0],
+                                                  farGrabJoints.leftFarGrabPosition[1],
+                                                  farGrabJoints.leftFarGrabPosition[2]);
+        glm::quat leftFarGrabRotation = glm::quat(farGrabJoints.leftFarGrabRotation[0],
+                                                  farGrabJoints.leftFarGrabRotation[1],
+                                                  farGrabJoints.leftFarGrabRotation[2],
+                                                  farGrabJoints.leftFarGrabRotation[3]);
+        glm::vec3 rightFarGrabPosition = glm::vec3(farGrabJoints.rightFarGrabPosition[0],
+                                                   farGrabJoints.rightFarGrabPosition[1],
+                                                   farGrabJoints.rightFarGrabPosition[2]);
+        glm::quat rightFarGrabRotation = glm::quat(farGrabJoints.rightFarGrabRotation[0],
+                                                   farGrabJoints.rightFarGrabRotation[1],
+                                                   farGrabJoints.rightFarGrabRotation[2],
+                                                   farGrabJoints.rightFarGrabRotation[3]);
+        glm::vec3 mouseFarGrabPosition = glm::vec3(farGrabJoints.mouseFarGrabPosition[0],
+                                                   farGrabJoints.mouseFarGrabPosition[1],
+                                                   farGrabJoints.mouseFarGrabPosition[2]);
+        glm::quat mouseFarGrabRotation = glm::quat(farGrabJoints.mouseFarGrabRotation[0],
+                                                   farGrabJoints.mouseFarGrabRotation[1],
+                                                   farGrabJoints.mouseFarGrabRotation[2],
+                                                   farGrabJoints.mouseFarGrabRotation[3]);
+
+        _farGrabLeftMatrixCache.set(createMatFromQuatAndPos(leftFarGrabRotation, leftFarGrabPosition));
+        _farGrabRightMatrixCache.set(createMatFromQuatAndPos(rightFarGrabRotation, rightFarGrabPosition));
+        _farGrabMouseMatrixCache.set(createMatFromQuatAndPos(mouseFarGrabRotation, mouseFarGrabPosition));
+
+        sourceBuffer += sizeof(AvatarDataPacket::FarGrabJoints);
+        int numBytesRead = sourceBuffer - startSection;
+        _farGrabJointRate.increment(numBytesRead);
+        _farGrabJointUpdateRate.increment();
     }
 
     if (hasJointDefaultPoseFlags) {
@@ -1477,11 +1654,26 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             _jointData[i].translationIsDefaultPose = value;
         });
 
+        defaultPoseFlagsSectionStart = startSection;
+        defaultPoseFlagsSectionEnd = sourceBuffer;
+
         int numBytesRead = sourceBuffer - startSection;
         _jointDefaultPoseFlagsRate.increment(numBytesRead);
         _jointDefaultPoseFlagsUpdateRate.increment();
     }
 
+    // a record with all of the joints is the keyframe of the joint deltas that follow it, as it is for the sender
+    if (jointDataSectionStart && defaultPoseFlagsSectionStart) {
+        JointDeltas::Keyframe keyframe = JointDeltas::keyframeFromSections(
+            jointDataSectionStart, (int)(jointDataSectionEnd - jointDataSectionStart),
+            defaultPoseFlagsSectionStart, (int)(defaultPoseFlagsSectionEnd - defaultPoseFlagsSectionStart));
+        if (keyframe.isValid()) {
+            QWriteLocker writeLock(&_jointDataLock);
+            _jointDeltaKeyframe = keyframe;
+            _isMissingJointKeyframe = false;
+        }
+    }
+
     int numBytesRead = sourceBuffer - startPosition;
     _averageBytesReceived.updateAverage(numBytesRead);
 
@@ -1702,6 +1894,17 @@ QVector<JointData> AvatarData::getJointData() const {
     return jointData;
 }
 
+bool AvatarData::shouldRequestJointKeyframe(quint64 now) {
+    // a request is answered by the mixer's next update, give it a round trip before asking again
+    const quint64 MIN_JOINT_KEYFRAME_REQUEST_INTERVAL = 250 * USECS_PER_MSEC;
+    QWriteLocker writeLock(&_jointDataLock);
+    if (!_isMissingJointKeyframe || now - _lastJointKeyframeRequest < MIN_JOINT_KEYFRAME_REQUEST_INTERVAL) {
+        return false;
+    }
+    _lastJointKeyframeRequest = now;
+    return true;
+}
+
 void AvatarData::clearJointData(int index) {
     if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
         return;
@@ -53,6 +53,7 @@
 #include "AABox.h"
 #include "AvatarTraits.h"
 #include "HeadData.h"
+#include "JointDeltas.h"
 #include "PathUtils.h"
 
 using AvatarSharedPointer = std::shared_ptr<AvatarData>;
@@ -205,6 +206,7 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_JOINT_DATA               = 1U << 12;
     const HasFlags PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS = 1U << 13;
     const HasFlags PACKET_HAS_GRAB_JOINTS              = 1U << 14;
+    const HasFlags PACKET_HAS_JOINT_DELTAS             = 1U << 15;
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
@@ -353,6 +355,17 @@ namespace AvatarDataPacket {
     size_t maxJointDataSize(size_t numJoints);
     size_t minJointDataSize(size_t numJoints);
 
+    // Instead of the joint data, the joints as differences from the last complete joint data the receiver was sent,
+    // which it knows by the hash of its bytes. See JointDeltas.h.
+    PACKED_BEGIN struct JointDeltasHeader {
+        uint8_t numJoints;
+        uint32_t keyframeHash;  // of the keyframe's joint data (without the far grab joints) and default pose flags
+        uint8_t precision;      // of the quantization, from 0, doubling the steps at every level
+        uint16_t codedSize;     // size of the range coded deltas that follow
+    } PACKED_END;
+    const size_t JOINT_DELTAS_HEADER_SIZE = 8;
+    static_assert(sizeof(JointDeltasHeader) == JOINT_DELTAS_HEADER_SIZE, "AvatarDataPacket::JointDeltasHeader size doesn't match.");
+
     /*
     struct JointDefaultPoseFlags {
        uint8_t numJoints;
@@ -398,6 +411,8 @@ const float AVATAR_SEND_FULL_UPDATE_RATIO = 0.02f;
 // this controls how large a change in joint-rotation must be before the interface sends it to the avatar mixer
 const float AVATAR_MIN_ROTATION_DOT = 0.9999999f;
 const float AVATAR_MIN_TRANSLATION = 0.0001f;
+// the joint translations are sent in fixed point, as fractions of their largest dimension
+const int TRANSLATION_COMPRESSION_RADIX = 14;
 
 // quaternion dot products
 const float ROTATION_CHANGE_2D = 0.99984770f; // 2 degrees
@@ -615,14 +630,18 @@ public:
         MinimumData,
         CullSmallData,
         IncludeSmallData,
-        SendAllData
+        SendAllData,
+        JointDeltaData // as CullSmallData, with the joints as deltas from a keyframe when there is one
     } AvatarDataDetail;
 
     virtual QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false);
 
+    // At JointDeltaData, the joints are sent as deltas from the keyframe if there is one. The keyframe, if not null, is
+    // replaced by the joints of any record that holds all of them.
     virtual QByteArray toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
         AvatarDataPacket::SendStatus& sendStatus, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
-        QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr) const;
+        QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr,
+        JointDeltas::Keyframe* keyframe = nullptr) const;
 
     virtual void doneEncoding(bool cullSmallChanges);
 
@@ -1506,6 +1525,9 @@ public:
     QVector<JointData> getJointData() const;
     glm::vec3 getHeadJointFrontVector() const;
 
+    // true, at most once per interval, while the joint deltas of this avatar are dropped for a keyframe it didn't get
+    bool shouldRequestJointKeyframe(quint64 now);
+
 signals:
 
     /**jsdoc
@@ -1671,6 +1693,7 @@ protected:
 
     float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
     float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
+    int getDistanceBasedJointDeltaPrecision(glm::vec3 viewerPosition) const;
 
     bool avatarBoundingBoxChangedSince(quint64 time) const { return _avatarBoundingBoxChanged >= time; }
     bool avatarScaleChangedSince(quint64 time) const { return _avatarScaleChanged >= time; }
@@ -1709,6 +1732,9 @@ protected:
     QVector<JointData> _jointData; ///< the state of the skeleton joints
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
+    JointDeltas::Keyframe _jointDeltaKeyframe; ///< the last complete joint data received, the joint deltas apply to it
+    bool _isMissingJointKeyframe { false }; ///< joint deltas were dropped since the last complete joint data
+    quint64 _lastJointKeyframeRequest { 0 };
 
     // key state
     KeyState _keyState;
@@ -183,6 +183,25 @@ void AvatarHashMap::setReplicaCount(int count) {
     }
 }
 
+int AvatarHashMap::packJointKeyframeRequests(unsigned char* destinationBuffer) {
+    unsigned char* bufferStart = destinationBuffer;
+    uint8_t* numRequests = destinationBuffer;
+    *numRequests = 0;
+    destinationBuffer += sizeof(uint8_t);
+
+    quint64 now = usecTimestampNow();
+    auto hashCopy = getHashCopy();
+    for (auto it = hashCopy.begin(); it != hashCopy.end() && *numRequests < MAX_JOINT_KEYFRAME_REQUESTS; ++it) {
+        if (!it.key().isNull() && it.value()->shouldRequestJointKeyframe(now)) {
+            QByteArray avatarID = it.key().toRfc4122();
+            memcpy(destinationBuffer, avatarID.constData(), NUM_BYTES_RFC4122_UUID);
+            destinationBuffer += NUM_BYTES_RFC4122_UUID;
+            ++*numRequests;
+        }
+    }
+    return (int)(destinationBuffer - bufferStart);
+}
+
 int AvatarHashMap::numberOfAvatarsInRange(const glm::vec3& position, float rangeMeters) {
     auto hashCopy = getHashCopy();
     auto rangeMeters2 = rangeMeters * rangeMeters;
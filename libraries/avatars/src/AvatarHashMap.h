@@ -26,6 +26,7 @@
 #include <DependencyManager.h>
 #include <NLPacket.h>
 #include <Node.h>
+#include <UUID.h>
 
 #include "ScriptAvatarData.h"
 
@@ -122,6 +123,12 @@ public:
     void setReplicaCount(int count);
     int getReplicaCount() { return _replicas.getReplicaCount(); };
 
+    // Appends to an avatar query the avatars whose joint deltas are dropped for lack of their keyframe, so that the
+    // mixer sends them whole; returns the number of bytes written, at most MAX_JOINT_KEYFRAME_REQUESTS_SIZE
+    int packJointKeyframeRequests(unsigned char* destinationBuffer);
+    static const int MAX_JOINT_KEYFRAME_REQUESTS = 32;
+    static const int MAX_JOINT_KEYFRAME_REQUESTS_SIZE = 1 + MAX_JOINT_KEYFRAME_REQUESTS * NUM_BYTES_RFC4122_UUID;
+
     virtual void clearOtherAvatars();
 
 signals:
@@ -0,0 +1,298 @@
+//
+//  JointDeltas.cpp
+//  libraries/avatars/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointDeltas.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QVarLengthArray>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <RangeCoder.h>
+
+namespace {
+
+const int MAX_STACK_JOINTS = 256;
+const int SIX_BYTES = 6;
+
+// The changed flags of a joint are coded in the context of the previous joint's, as the joints of a limb tend to move
+// together; the values of each component have their own model.
+struct Models {
+    BitModel rotationChanged[2];
+    BitModel translationChanged[2];
+    IntModel rotation[3];
+    IntModel rotationReal;
+    IntModel translation[3];
+};
+
+float stepAtPrecision(float step, int precision) {
+    return step * (float)(1 << std::max(0, std::min(precision, JointDeltas::MAX_PRECISION)));
+}
+
+int32_t quantize(float value, float step) {
+    float steps = value / step;
+    const float MAX_STEPS = (float)IntModel::MAX_MAGNITUDE;
+    if (!(fabsf(steps) <= MAX_STEPS)) {
+        // out of range, or not a number
+        return steps > 0.0f ? IntModel::MAX_MAGNITUDE : (steps < 0.0f ? -IntModel::MAX_MAGNITUDE : 0);
+    }
+    return (int32_t)roundf(steps);
+}
+
+glm::quat baseRotation(const JointData& joint) {
+    return joint.rotationIsDefaultPose ? Quaternions::IDENTITY : joint.rotation;
+}
+
+glm::vec3 baseTranslation(const JointData& joint) {
+    return joint.translationIsDefaultPose ? Vectors::ZERO : joint.translation;
+}
+
+// The rotation from the keyframe rotation is sent without its real part, which is positive, unless that is small enough
+// for the imaginary part's quantization to make it inaccurate. Decided on the integers, to be the same on every machine.
+bool hasRealPart(const int32_t delta[3], float step) {
+    int64_t stepsPerUnit = (int64_t)(1.0f / step);
+    int64_t squaredLength = (int64_t)delta[0] * delta[0] + (int64_t)delta[1] * delta[1] + (int64_t)delta[2] * delta[2];
+    return 2 * squaredLength > stepsPerUnit * stepsPerUnit;
+}
+
+glm::quat applyRotationDelta(const glm::quat& base, const int32_t delta[3], int32_t realDelta, float step) {
+    glm::vec3 imaginary = glm::vec3((float)delta[0], (float)delta[1], (float)delta[2]) * step;
+    float real = hasRealPart(delta, step) ? (float)realDelta * step :
+        sqrtf(std::max(0.0f, 1.0f - glm::dot(imaginary, imaginary)));
+    return glm::normalize(base * glm::quat(real, imaginary.x, imaginary.y, imaginary.z));
+}
+
+glm::vec3 applyTranslationDelta(const glm::vec3& base, const int32_t delta[3], float step) {
+    return base + glm::vec3((float)delta[0], (float)delta[1], (float)delta[2]) * step;
+}
+
+bool readBit(const unsigned char* bits, int index) {
+    return (bits[index / BITS_IN_BYTE] >> (index % BITS_IN_BYTE)) & 1;
+}
+
+uint32_t hashBytes(uint32_t hash, const unsigned char* bytes, int size) {
+    // FNV-1a
+    const uint32_t FNV_PRIME = 16777619U;
+    for (int i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+}
+
+void JointDeltas::encode(const JointData* joints, int numJoints, const Keyframe& keyframe, int precision,
+                         QByteArray& output, JointData* decodedJoints) {
+    assert(keyframe.joints.size() == numJoints);
+    const float rotationStep = stepAtPrecision(ROTATION_STEP, precision);
+    const float translationStep = stepAtPrecision(TRANSLATION_STEP, precision);
+
+    Models models;
+    RangeEncoder encoder(output);
+    int rotationContext = 0;
+    int translationContext = 0;
+    for (int i = 0; i < numJoints; ++i) {
+        const JointData& joint = joints[i];
+        const JointData& key = keyframe.joints[i];
+
+        // a joint in its default pose is left as it was in the keyframe, its flags say to ignore it
+        glm::quat rotation = baseRotation(key);
+        int32_t delta[3] = { 0, 0, 0 };
+        int32_t realDelta = 0;
+        if (!joint.rotationIsDefaultPose) {
+            glm::quat difference = glm::conjugate(rotation) * joint.rotation;
+            if (difference.w < 0.0f) {
+                difference = -difference;
+            }
+            delta[0] = quantize(difference.x, rotationStep);
+            delta[1] = quantize(difference.y, rotationStep);
+            delta[2] = quantize(difference.z, rotationStep);
+            realDelta = quantize(difference.w, rotationStep);
+        }
+        int changed = (delta[0] != 0 || delta[1] != 0 || delta[2] != 0) ? 1 : 0;
+        encoder.encodeBit(models.rotationChanged[rotationContext], changed);
+        if (changed) {
+            for (int component = 0; component < 3; ++component) {
+                delta[component] = models.rotation[component].encode(encoder, delta[component]);
+            }
+            if (hasRealPart(delta, rotationStep)) {
+                realDelta = models.rotationReal.encode(encoder, realDelta);
+            }
+            rotation = applyRotationDelta(rotation, delta, realDelta, rotationStep);
+        }
+        rotationContext = changed;
+
+        glm::vec3 translation = baseTranslation(key);
+        delta[0] = delta[1] = delta[2] = 0;
+        if (!joint.translationIsDefaultPose) {
+            glm::vec3 difference = joint.translation - translation;
+            delta[0] = quantize(difference.x, translationStep);
+            delta[1] = quantize(difference.y, translationStep);
+            delta[2] = quantize(difference.z, translationStep);
+        }
+        changed = (delta[0] != 0 || delta[1] != 0 || delta[2] != 0) ? 1 : 0;
+        encoder.encodeBit(models.translationChanged[translationContext], changed);
+        if (changed) {
+            for (int component = 0; component < 3; ++component) {
+                delta[component] = models.translation[component].encode(encoder, delta[component]);
+            }
+            translation = applyTranslationDelta(translation, delta, translationStep);
+        }
+        translationContext = changed;
+
+        if (decodedJoints) {
+            decodedJoints[i].rotation = rotation;
+            decodedJoints[i].translation = translation;
+        }
+    }
+    encoder.flush();
+}
+
+void JointDeltas::decode(const unsigned char* coded, int codedSize, const Keyframe& keyframe, int precision,
+                         JointData* joints, int numJoints) {
+    assert(keyframe.joints.size() == numJoints);
+    const float rotationStep = stepAtPrecision(ROTATION_STEP, precision);
+    const float translationStep = stepAtPrecision(TRANSLATION_STEP, precision);
+
+    Models models;
+    RangeDecoder decoder(coded, codedSize);
+    int rotationContext = 0;
+    int translationContext = 0;
+    for (int i = 0; i < numJoints; ++i) {
+        JointData& joint = joints[i];
+        const JointData& key = keyframe.joints[i];
+        int32_t delta[3];
+        int32_t realDelta = 0;
+
+        int changed = decoder.decodeBit(models.rotationChanged[rotationContext]);
+        joint.rotation = baseRotation(key);
+        joint.rotationIsDefaultPose = key.rotationIsDefaultPose && !changed;
+        if (changed) {
+            for (int component = 0; component < 3; ++component) {
+                delta[component] = models.rotation[component].decode(decoder);
+            }
+            if (hasRealPart(delta, rotationStep)) {
+                realDelta = models.rotationReal.decode(decoder);
+            }
+            joint.rotation = applyRotationDelta(joint.rotation, delta, realDelta, rotationStep);
+        }
+        rotationContext = changed;
+
+        changed = decoder.decodeBit(models.translationChanged[translationContext]);
+        joint.translation = baseTranslation(key);
+        joint.translationIsDefaultPose = key.translationIsDefaultPose && !changed;
+        if (changed) {
+            for (int component = 0; component < 3; ++component) {
+                delta[component] = models.translation[component].decode(decoder);
+            }
+            joint.translation = applyTranslationDelta(joint.translation, delta, translationStep);
+        }
+        translationContext = changed;
+    }
+}
+
+JointDeltas::Keyframe JointDeltas::keyframeFromSections(const unsigned char* jointData, int jointDataSize,
+                                                        const unsigned char* defaultPoseFlags, int defaultPoseFlagsSize) {
+    Keyframe keyframe;
+    if (jointDataSize < 1 || defaultPoseFlagsSize < 1) {
+        return keyframe;
+    }
+    const int numJoints = jointData[0];
+    const int bitVectorSize = (numJoints + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    if (numJoints == 0 || defaultPoseFlags[0] != numJoints || defaultPoseFlagsSize != 1 + 2 * bitVectorSize) {
+        return keyframe;
+    }
+    const unsigned char* rotationIsDefault = defaultPoseFlags + 1;
+    const unsigned char* translationIsDefault = rotationIsDefault + bitVectorSize;
+
+    const unsigned char* cursor = jointData + 1;
+    const unsigned char* const end = jointData + jointDataSize;
+
+    // every joint not in its default pose must be in the section
+    if (end - cursor < bitVectorSize) {
+        return keyframe;
+    }
+    const unsigned char* rotationIsValid = cursor;
+    cursor += bitVectorSize;
+    int numRotations = 0;
+    for (int i = 0; i < numJoints; ++i) {
+        if (readBit(rotationIsValid, i)) {
+            ++numRotations;
+        } else if (!readBit(rotationIsDefault, i)) {
+            return keyframe;
+        }
+    }
+    if (end - cursor < numRotations * SIX_BYTES) {
+        return keyframe;
+    }
+    QVarLengthArray<float, 4 * MAX_STACK_JOINTS> rotations(4 * numRotations);
+    float* const rotationComponents[4] = {
+        rotations.data(), rotations.data() + numRotations, rotations.data() + 2 * numRotations, rotations.data() + 3 * numRotations
+    };
+    cursor += unpackOrientationQuatsFromSixBytes(cursor, rotationComponents, numRotations);
+
+    if (end - cursor < bitVectorSize + (int)sizeof(float)) {
+        return keyframe;
+    }
+    const unsigned char* translationIsValid = cursor;
+    cursor += bitVectorSize;
+    int numTranslations = 0;
+    for (int i = 0; i < numJoints; ++i) {
+        if (readBit(translationIsValid, i)) {
+            ++numTranslations;
+        } else if (!readBit(translationIsDefault, i)) {
+            return keyframe;
+        }
+    }
+    float maxTranslationDimension;
+    memcpy(&maxTranslationDimension, cursor, sizeof(float));
+    cursor += sizeof(float);
+    if (end - cursor != numTranslations * SIX_BYTES) {
+        return keyframe;
+    }
+    QVarLengthArray<float, 3 * MAX_STACK_JOINTS> translations(3 * numTranslations);
+    float* const translationComponents[3] = {
+        translations.data(), translations.data() + numTranslations, translations.data() + 2 * numTranslations
+    };
+    unpackFloatVec3sFromSignedTwoByteFixed(cursor, translationComponents, numTranslations, TRANSLATION_COMPRESSION_RADIX);
+
+    keyframe.joints.resize(numJoints);
+    for (int i = 0, rotation = 0, translation = 0; i < numJoints; ++i) {
+        JointData& joint = keyframe.joints[i];
+        if (readBit(rotationIsValid, i)) {
+            for (int component = 0; component < 4; ++component) {
+                joint.rotation[component] = rotationComponents[component][rotation];
+            }
+            ++rotation;
+        }
+        joint.rotationIsDefaultPose = readBit(rotationIsDefault, i);
+        if (joint.rotationIsDefaultPose) {
+            joint.rotation = Quaternions::IDENTITY;
+        }
+
+        if (readBit(translationIsValid, i)) {
+            joint.translation = glm::vec3(translationComponents[0][translation], translationComponents[1][translation],
+                                          translationComponents[2][translation]) * maxTranslationDimension;
+            ++translation;
+        }
+        joint.translationIsDefaultPose = readBit(translationIsDefault, i);
+        if (joint.translationIsDefaultPose) {
+            joint.translation = Vectors::ZERO;
+        }
+    }
+
+    const uint32_t FNV_OFFSET_BASIS = 2166136261U;
+    keyframe.hash = hashBytes(hashBytes(FNV_OFFSET_BASIS, jointData, jointDataSize), defaultPoseFlags, defaultPoseFlagsSize);
+    return keyframe;
+}
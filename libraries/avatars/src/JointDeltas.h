@@ -0,0 +1,57 @@
+//
+//  JointDeltas.h
+//  libraries/avatars/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JointDeltas_h
+#define hifi_JointDeltas_h
+
+#include <cstdint>
+
+#include <QByteArray>
+#include <QVector>
+
+#include <JointData.h>
+
+/// The joints of an avatar coded as quantized differences from a keyframe, with an adaptive range coder.
+///
+/// The avatar mixer gets no acknowledgment of what a listener received, so the keyframe is not the last pose sent but
+/// the last complete joint update sent: a record with the rotation and translation of every joint that is not in its
+/// default pose, along with the default pose flags. The sender and the receiver both make the keyframe out of the bytes
+/// of that record, with keyframeFromSections(), and identify it by a hash of them. A receiver that lost the keyframe
+/// has another hash, and ignores the deltas until the next complete update.
+namespace JointDeltas {
+
+    // the quantization steps at precision 0, every precision level doubles them
+    const float ROTATION_STEP = 1.0f / 4096.0f; // of the components of the rotation from the keyframe rotation
+    const float TRANSLATION_STEP = 1.0f / 8192.0f; // meters
+    const int MAX_PRECISION = 4;
+
+    struct Keyframe {
+        QVector<JointData> joints;
+        uint32_t hash { 0 };
+
+        bool isValid() const { return !joints.isEmpty(); }
+    };
+
+    /// Appends the coded differences of the joints from the keyframe, which must have as many joints. The rotations
+    /// and translations the receiver will decode are written to decodedJoints, if not null.
+    void encode(const JointData* joints, int numJoints, const Keyframe& keyframe, int precision, QByteArray& output,
+                JointData* decodedJoints);
+
+    /// Sets the rotation and translation of every joint, from the keyframe and the coded differences.
+    void decode(const unsigned char* coded, int codedSize, const Keyframe& keyframe, int precision, JointData* joints,
+                int numJoints);
+
+    /// The keyframe of a record's joint data section, without the far grab joints, and default pose flags section.
+    /// Invalid unless the sections are well formed and hold every joint that is not in its default pose.
+    Keyframe keyframeFromSections(const unsigned char* jointData, int jointDataSize,
+                                  const unsigned char* defaultPoseFlags, int defaultPoseFlagsSize);
+}
+
+#endif // hifi_JointDeltas_h
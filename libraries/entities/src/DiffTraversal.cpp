@@ -15,9 +15,8 @@
 
 #include "EntityPriorityQueue.h"
 
-DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
+DiffTraversal::Waypoint::Waypoint(const EntityTreeSnapshot::Element* element) : _element(element), _nextIndex(0) {
     assert(element);
-    _weakElement = element;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::VisibleElement& next,
@@ -29,22 +28,19 @@ void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::Visi
         // we never bother checking for LOD culling, and
         // we can skip it if the content hasn't changed
         ++_nextIndex;
-        next.element = _weakElement.lock();
+        next.element = _element;
         return;
     } else if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::Element* nextElement = next.snapshot->getChild(*_element, _nextIndex);
+            ++_nextIndex;
+            if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                next.element = nextElement;
+                return;
             }
         }
     }
-    next.element.reset();
+    next.element = nullptr;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
@@ -52,29 +48,25 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
     if (_nextIndex == -1) {
         // root case is special
         ++_nextIndex;
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element->getLastChangedContent() > lastTime) {
-            next.element = element;
+        if (_element->lastChangedContent > lastTime) {
+            next.element = _element;
             return;
         }
     }
     if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement &&
-                    nextElement->getLastChanged() > lastTime &&
-                    view.shouldTraverseElement(*nextElement)) {
-
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::Element* nextElement = next.snapshot->getChild(*_element, _nextIndex);
+            ++_nextIndex;
+            if (nextElement &&
+                nextElement->lastChanged > lastTime &&
+                view.shouldTraverseElement(*nextElement)) {
+
+                next.element = nextElement;
+                return;
             }
         }
     }
-    next.element.reset();
+    next.element = nullptr;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::VisibleElement& next,
@@ -82,23 +74,19 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
     if (_nextIndex == -1) {
         // root case is special
         ++_nextIndex;
-        EntityTreeElementPointer element = _weakElement.lock();
-        next.element = element;
+        next.element = _element;
         return;
     } else if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::Element* nextElement = next.snapshot->getChild(*_element, _nextIndex);
+            ++_nextIndex;
+            if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                next.element = nextElement;
+                return;
             }
         }
     }
-    next.element.reset();
+    next.element = nullptr;
 }
 
 bool DiffTraversal::View::usesViewFrustums() const {
@@ -162,12 +150,12 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
     return priority;
 }
 
-bool DiffTraversal::View::shouldTraverseElement(const EntityTreeElement& element) const {
+bool DiffTraversal::View::shouldTraverseElement(const EntityTreeSnapshot::Element& element) const {
     if (!usesViewFrustums()) {
         return true;
     }
 
-    const auto& cube = element.getAACube();
+    const auto& cube = element.cube;
 
     auto center = cube.calcCenter(); // center of bounding sphere
     auto radius = 0.5f * SQRT_THREE * cube.getScale(); // radius of bounding sphere
@@ -193,9 +181,9 @@ DiffTraversal::DiffTraversal() {
     _path.reserve(MIN_PATH_DEPTH);
 }
 
-DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
+DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeSnapshotPointer snapshot,
                                                        bool forceFirstPass) {
-    assert(root);
+    assert(snapshot);
     // there are three types of traversal:
     //
     //   (1) First = fresh view --> find all elements in view
@@ -234,19 +222,22 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
         };
     }
 
+    _snapshot = snapshot;
     _path.clear();
-    _path.push_back(DiffTraversal::Waypoint(root));
+    _path.push_back(DiffTraversal::Waypoint(&_snapshot->getRoot()));
     // set root fork's index such that root element returned at getNextElement()
     _path.back().initRootNextIndex();
 
-    _currentView.startTime = usecTimestampNow();
+    // the snapshot holds the changes up to its timestamp, the next traversal has to look for the ones after it
+    _currentView.startTime = _snapshot->getTimestamp();
 
     return type;
 }
 
 void DiffTraversal::getNextVisibleElement(DiffTraversal::VisibleElement& next) {
+    next.snapshot = _snapshot.get();
     if (_path.empty()) {
-        next.element.reset();
+        next.element = nullptr;
         return;
     }
     _getNextVisibleElementCallback(next);
@@ -14,16 +14,21 @@
 
 #include <shared/ConicalViewFrustum.h>
 
-#include "EntityTreeElement.h"
+#include "EntityTreeSnapshot.h"
 
-// DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
+// DiffTraversal traverses a snapshot of the tree and applies _scanElementCallback on elements it finds.
+// A traversal spanning several calls to traverse() sticks to the snapshot it started on.
 class DiffTraversal {
 public:
     // VisibleElement is a struct identifying an element and how it intersected the view.
     // The intersection is used to optimize culling entities from the sendQueue.
     class VisibleElement {
     public:
-        EntityTreeElementPointer element;
+        const EntityTreeSnapshot* snapshot { nullptr };
+        const EntityTreeSnapshot::Element* element { nullptr };
+
+        template <typename F>
+        void forEachEntity(F f) const { snapshot->forEachEntity(*element, f); }
     };
 
     // View is a struct with a ViewFrustum and LOD parameters
@@ -32,7 +37,7 @@ public:
         bool usesViewFrustums() const;
         bool isVerySimilar(const View& view) const;
 
-        bool shouldTraverseElement(const EntityTreeElement& element) const;
+        bool shouldTraverseElement(const EntityTreeSnapshot::Element& element) const;
         float computePriority(const EntityItemPointer& entity) const;
 
         ConicalViewFrustums viewFrustums;
@@ -43,7 +48,7 @@ public:
     // Waypoint is an bookmark in a "path" of waypoints during a traversal.
     class Waypoint {
     public:
-        Waypoint(EntityTreeElementPointer& element);
+        Waypoint(const EntityTreeSnapshot::Element* element);
 
         void getNextVisibleElementFirstTime(VisibleElement& next, const View& view);
         void getNextVisibleElementRepeat(VisibleElement& next, const View& view, uint64_t lastTime);
@@ -53,7 +58,7 @@ public:
         void initRootNextIndex() { _nextIndex = -1; }
 
     protected:
-        EntityTreeElementWeakPointer _weakElement;
+        const EntityTreeSnapshot::Element* _element;
         int8_t _nextIndex;
     };
 
@@ -61,9 +66,10 @@ public:
 
     DiffTraversal();
 
-    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false);
+    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeSnapshotPointer snapshot, bool forceFirstPass = false);
 
     const View& getCurrentView() const { return _currentView; }
+    const EntityTreeSnapshotPointer& getSnapshot() const { return _snapshot; }
 
     uint64_t getStartOfCompletedTraversal() const { return _completedView.startTime; }
     bool finished() const { return _path.empty(); }
@@ -71,11 +77,13 @@ public:
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
-    void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
+    // resets our state to force a new "First" traversal
+    void reset() { _path.clear(); _completedView.startTime = 0; _snapshot.reset(); }
 
 private:
     void getNextVisibleElement(VisibleElement& next);
 
+    EntityTreeSnapshotPointer _snapshot;
     View _currentView;
     View _completedView;
     std::vector<Waypoint> _path;
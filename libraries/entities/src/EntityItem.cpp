@@ -169,6 +169,37 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     OctreeElement::AppendState appendState = OctreeElement::COMPLETED; // assume the best
 
+    bool isContinuation = entityTreeElementExtraEncodeData &&
+        entityTreeElementExtraEncodeData->entities.contains(getEntityItemID());
+    quint64 lastEdited = getLastEdited();
+
+    // Only complete encodings are shared: if the entity hasn't changed since it was last encoded for another client,
+    // and it all fits, copy that encoding.
+    bool useEncodedData = params.useEncodedDataCache && !isContinuation;
+    EncodedDataKey encodedDataKey;
+    if (useEncodedData) {
+        // read before anything is encoded, a change made while encoding leaves the cached encoding stale
+        encodedDataKey.encodingVersion = _encodingVersion;
+        encodedDataKey.lastEdited = lastEdited;
+        encodedDataKey.lastUpdated = getLastUpdated();
+        encodedDataKey.lastSimulated = getLastSimulated();
+        encodedDataKey.changedOnServer = getLastChangedOnServer();
+        encodedDataKey.queryAACube = getQueryAACube();
+        encodedDataKey.includesPrivateUserData = destinationNodeCanGetAndSetPrivateUserData;
+
+        QByteArray encodedData = getEncodedData(encodedDataKey);
+        if (!encodedData.isEmpty()) {
+            LevelDetails entityLevel = packetData->startLevel();
+            if (packetData->appendRawData(encodedData)) {
+                packetData->endLevel(entityLevel);
+                params.trackSend(getID(), lastEdited);
+                return OctreeElement::COMPLETED;
+            }
+            // doesn't fit, encode what does the usual way
+            packetData->discardLevel(entityLevel);
+        }
+    }
+
     // encode our ID as a byte count coded byte stream
     QByteArray encodedID = getID().toRfc4122();
 
@@ -197,7 +228,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
-    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
+    if (isContinuation) {
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
     }
 
@@ -209,8 +240,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
     LevelDetails entityLevel = packetData->startLevel();
-
-    quint64 lastEdited = getLastEdited();
+    int startOfEntity = packetData->getUncompressedByteOffset();
 
     #ifdef WANT_DEBUG
         float editedAgo = getEditedAgo();
@@ -379,6 +409,12 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
             assert(newPropertyFlagsLength == oldPropertyFlagsLength); // should not have grown
         }
 
+        if (useEncodedData && appendState == OctreeElement::COMPLETED) {
+            int endOfEntity = packetData->getUncompressedByteOffset();
+            setEncodedData(encodedDataKey, QByteArray((const char*)packetData->getUncompressedData(startOfEntity),
+                                                      endOfEntity - startOfEntity));
+        }
+
         packetData->endLevel(entityLevel);
     } else {
         packetData->discardLevel(entityLevel);
@@ -399,6 +435,17 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     return appendState;
 }
 
+QByteArray EntityItem::getEncodedData(const EncodedDataKey& key) const {
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+    return key == _encodedDataKey ? _encodedData : QByteArray();
+}
+
+void EntityItem::setEncodedData(const EncodedDataKey& key, const QByteArray& data) const {
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+    _encodedDataKey = key;
+    _encodedData = data;
+}
+
 // TODO: My goal is to get rid of this concept completely. The old code (and some of the current code) used this
 // result to calculate if a packet being sent to it was potentially bad or corrupt. I've adjusted this to now
 // only consider the minimum header bytes as being required. But it would be preferable to completely eliminate
@@ -1002,6 +1049,8 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
         element->getTree()->trackIncomingEntityLastEdited(lastEditedFromBufferAdjusted, bytesRead);
     }
 
+    // some of the properties were set without the write lock
+    markEncodingChanged();
 
     return bytesRead;
 }
@@ -1588,6 +1637,9 @@ bool EntityItem::setProperties(const EntityItemProperties& properties) {
         _created = timestamp;
     }
 
+    // some of the properties were set without the write lock
+    markEncodingChanged();
+
     return somethingChanged;
 }
 
@@ -12,7 +12,9 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -92,6 +94,15 @@ public:
     EntityItem(const EntityItemID& entityItemID);
     virtual ~EntityItem();
 
+    // Every change to an entity is made under its write lock, or by setProperties() or readEntityDataFromBuffer(), all
+    // of which move the encoding version on, after the change.
+    using ReadWriteLockable::withWriteLock;
+    template <typename F>
+    void withWriteLock(F&& f) const {
+        ReadWriteLockable::withWriteLock(std::forward<F>(f));
+        markEncodingChanged();
+    }
+
     inline EntityItemPointer getThisPointer() const {
         return std::static_pointer_cast<EntityItem>(std::const_pointer_cast<SpatiallyNestable>(shared_from_this()));
     }
@@ -769,6 +780,34 @@ protected:
     
     mutable bool _needsRenderUpdate { false };
 
+    // The last complete encoding of this entity, made for one client and copied as is to the others. The encoding
+    // is valid as long as neither the encoding version nor any of the times the entity changed at moved, and the
+    // query cube, which is updated without the write lock, is the same.
+    struct EncodedDataKey {
+        uint32_t encodingVersion { 0 };
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 changedOnServer { 0 };
+        AACube queryAACube;
+        bool includesPrivateUserData { false };
+
+        bool operator==(const EncodedDataKey& other) const {
+            return encodingVersion == other.encodingVersion && lastEdited == other.lastEdited &&
+                lastUpdated == other.lastUpdated && lastSimulated == other.lastSimulated &&
+                changedOnServer == other.changedOnServer && queryAACube == other.queryAACube &&
+                includesPrivateUserData == other.includesPrivateUserData;
+        }
+    };
+    QByteArray getEncodedData(const EncodedDataKey& key) const;
+    void setEncodedData(const EncodedDataKey& key, const QByteArray& data) const;
+    void markEncodingChanged() const { ++_encodingVersion; }
+
+    mutable std::atomic<uint32_t> _encodingVersion { 0 };
+    mutable std::mutex _encodedDataMutex;
+    mutable EncodedDataKey _encodedDataKey; // guarded by _encodedDataMutex
+    mutable QByteArray _encodedData; // guarded by _encodedDataMutex
+
 private:
     static std::function<glm::quat(const glm::vec3&, const glm::quat&, BillboardMode, const glm::vec3&)> _getBillboardRotationOperator;
     static std::function<glm::vec3()> _getPrimaryViewFrustumPositionOperator;
@@ -105,7 +105,7 @@ bool EntityItemProperties::constructFromBuffer(const unsigned char* data, int da
 }
 
 inline void addShapeType(QHash<QString, ShapeType>& lookup, ShapeType type) { lookup[ShapeInfo::getNameForShapeType(type)] = type; }
-QHash<QString, ShapeType> stringToShapeTypeLookup = [] {
+const QHash<QString, ShapeType> stringToShapeTypeLookup = [] {
     QHash<QString, ShapeType> toReturn;
     addShapeType(toReturn, SHAPE_TYPE_NONE);
     addShapeType(toReturn, SHAPE_TYPE_BOX);
@@ -2918,8 +2918,8 @@ bool EntityItemProperties::getPropertyInfo(const QString& propertyName, EntityPr
         }
     });
 
-    auto iter = _propertyInfos.find(propertyName);
-    if (iter != _propertyInfos.end()) {
+    auto iter = _propertyInfos.constFind(propertyName);
+    if (iter != _propertyInfos.cend()) {
         propertyInfo = *iter;
         return true;
     }
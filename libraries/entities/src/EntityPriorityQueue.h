@@ -12,8 +12,8 @@
 #ifndef hifi_EntityPriorityQueue_h
 #define hifi_EntityPriorityQueue_h
 
-#include <queue>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "EntityItem.h"
 
@@ -28,6 +28,7 @@ public:
     EntityItemPointer getEntity() const { return _weakEntity.lock(); }
     EntityItem* getRawEntityPointer() const { return _rawEntityPointer; }
     float getPriority() const { return _priority; }
+    void setPriority(float priority) { _priority = priority; }
     bool shouldForceRemove() const { return _forceRemove; }
 
     class Compare {
@@ -43,50 +44,143 @@ private:
     bool _forceRemove;
 };
 
+// EntityPriorityQueue is a binary max-heap of PrioritizedEntity that also knows where each entity is in the heap,
+// so that it can be kept across frames: an entity's priority can be changed in place, and the whole queue can be
+// reprioritized in linear time when the view changes.
 class EntityPriorityQueue {
+    friend class EntityPriorityQueueTests;
 public:
     inline bool empty() const {
-        assert(_queue.empty() == _entities.empty());
-        return _queue.empty();
+        assert(_heap.size() == _indices.size());
+        return _heap.empty();
     }
 
+    inline size_t size() const { return _heap.size(); }
+
     inline const PrioritizedEntity& top() const {
-        assert(!_queue.empty());
-        return _queue.top();
+        assert(!_heap.empty());
+        return _heap.front();
     }
 
     inline bool contains(const EntityItem* entity) const {
-        return _entities.find(entity) != std::end(_entities);
+        return _indices.find(entity) != std::end(_indices);
     }
 
     inline void emplace(const EntityItemPointer& entity, float priority, bool forceRemove = false) {
         assert(entity && !contains(entity.get()));
-        _queue.emplace(entity, priority, forceRemove);
-        _entities.insert(entity.get());
-        assert(_queue.size() == _entities.size());
+        _heap.emplace_back(entity, priority, forceRemove);
+        _indices[entity.get()] = _heap.size() - 1;
+        siftUp(_heap.size() - 1);
+        assert(_heap.size() == _indices.size());
     }
 
     inline void pop() {
         assert(!empty());
-        _entities.erase(_queue.top().getRawEntityPointer());
-        _queue.pop();
-        assert(_queue.size() == _entities.size());
+        remove(0);
+        assert(_heap.size() == _indices.size());
+    }
+
+    // sets the priority of a queued entity, or queues it
+    inline void update(const EntityItemPointer& entity, float priority, bool forceRemove = false) {
+        auto found = _indices.find(entity.get());
+        if (found == std::end(_indices)) {
+            emplace(entity, priority, forceRemove);
+            return;
+        }
+        size_t index = found->second;
+        _heap[index] = PrioritizedEntity(entity, priority, forceRemove);
+        siftDown(siftUp(index));
+    }
+
+    // recomputes the priority of every queued entity, and drops those given PrioritizedEntity::DO_NOT_SEND
+    template <typename F>
+    void reprioritize(F computePriority) {
+        size_t kept = 0;
+        for (size_t i = 0; i < _heap.size(); ++i) {
+            float priority = computePriority(_heap[i]);
+            if (priority == PrioritizedEntity::DO_NOT_SEND) {
+                _indices.erase(_heap[i].getRawEntityPointer());
+                continue;
+            }
+            _heap[i].setPriority(priority);
+            if (kept != i) {
+                _heap[kept] = std::move(_heap[i]);
+            }
+            _indices[_heap[kept].getRawEntityPointer()] = kept;
+            ++kept;
+        }
+        _heap.erase(_heap.begin() + kept, _heap.end());
+        // heapify bottom up
+        for (size_t i = _heap.size() / 2; i-- > 0; ) {
+            siftDown(i);
+        }
+        assert(_heap.size() == _indices.size());
     }
 
     inline void swap(EntityPriorityQueue& other) {
-        std::swap(_queue, other._queue);
-        std::swap(_entities, other._entities);
+        std::swap(_heap, other._heap);
+        std::swap(_indices, other._indices);
     }
 
 private:
-    using PriorityQueue = std::priority_queue<PrioritizedEntity,
-                                              std::vector<PrioritizedEntity>,
-                                              PrioritizedEntity::Compare>;
+    inline bool isBefore(size_t a, size_t b) const { return _heap[b].getPriority() < _heap[a].getPriority(); }
+
+    inline void place(size_t index, PrioritizedEntity&& entity) {
+        _indices[entity.getRawEntityPointer()] = index;
+        _heap[index] = std::move(entity);
+    }
+
+    inline size_t siftUp(size_t index) {
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!isBefore(index, parent)) {
+                break;
+            }
+            std::swap(_heap[index], _heap[parent]);
+            _indices[_heap[index].getRawEntityPointer()] = index;
+            _indices[_heap[parent].getRawEntityPointer()] = parent;
+            index = parent;
+        }
+        return index;
+    }
 
-    PriorityQueue _queue;
-    // Keep dictionary of all the entities in the queue for fast contain checks.
-    std::unordered_set<const EntityItem*> _entities;
+    inline size_t siftDown(size_t index) {
+        size_t size = _heap.size();
+        while (true) {
+            size_t first = index;
+            size_t left = 2 * index + 1;
+            size_t right = left + 1;
+            if (left < size && isBefore(left, first)) {
+                first = left;
+            }
+            if (right < size && isBefore(right, first)) {
+                first = right;
+            }
+            if (first == index) {
+                return index;
+            }
+            std::swap(_heap[index], _heap[first]);
+            _indices[_heap[index].getRawEntityPointer()] = index;
+            _indices[_heap[first].getRawEntityPointer()] = first;
+            index = first;
+        }
+    }
+
+    inline void remove(size_t index) {
+        _indices.erase(_heap[index].getRawEntityPointer());
+        size_t last = _heap.size() - 1;
+        if (index != last) {
+            place(index, std::move(_heap[last]));
+            _heap.pop_back();
+            siftDown(siftUp(index));
+        } else {
+            _heap.pop_back();
+        }
+    }
 
+    std::vector<PrioritizedEntity> _heap;
+    // index in the heap of each queued entity, also for fast contain checks
+    std::unordered_map<const EntityItem*, size_t> _indices;
 };
 
 #endif // hifi_EntityPriorityQueue_h
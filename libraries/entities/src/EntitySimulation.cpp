@@ -138,6 +138,8 @@ void EntitySimulation::sortEntitiesThatMoved() {
             prepareEntityForDelete(entity);
         } else {
             moveOperator.addEntityToMoveList(entity, newCube);
+            // the move is the simulation's, not an edit's, so it isn't journaled otherwise
+            _entityTree->journalEntityUpdated(entity->getEntityItemID());
             ++itemItr;
         }
     }
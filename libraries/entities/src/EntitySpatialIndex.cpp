@@ -0,0 +1,424 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+const int EntitySpatialIndex::BRANCHING;
+
+// the unsorted tail and the removed entries may grow to this, or to a sixteenth of the entries, before a query rebuilds
+static const size_t MIN_ENTRIES_BEFORE_REBUILD = 64;
+
+using Columns = EntitySpatialIndex::Columns;
+
+static const size_t LANES = 4;
+static_assert(EntitySpatialIndex::BRANCHING % LANES == 0, "groups must be a whole number of lanes");
+
+// Each test compares LANES consecutive entries of a Bounds at once, and returns a mask of the ones that pass
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+using Lanes = __m128;
+
+static inline Lanes load(const float* values) { return _mm_loadu_ps(values); }
+static inline Lanes broadcast(float value) { return _mm_set1_ps(value); }
+static inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+static inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+static inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+static inline Lanes max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+static inline int lessEqual(Lanes a, Lanes b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+#else
+struct Lanes {
+    float values[LANES];
+};
+
+template <typename F>
+static inline Lanes apply(const Lanes& a, const Lanes& b, F f) {
+    Lanes result;
+    for (size_t i = 0; i < LANES; ++i) {
+        result.values[i] = f(a.values[i], b.values[i]);
+    }
+    return result;
+}
+
+static inline Lanes load(const float* values) {
+    Lanes result;
+    std::copy(values, values + LANES, result.values);
+    return result;
+}
+static inline Lanes broadcast(float value) {
+    Lanes result;
+    std::fill(result.values, result.values + LANES, value);
+    return result;
+}
+static inline Lanes add(const Lanes& a, const Lanes& b) { return apply(a, b, [](float x, float y) { return x + y; }); }
+static inline Lanes sub(const Lanes& a, const Lanes& b) { return apply(a, b, [](float x, float y) { return x - y; }); }
+static inline Lanes mul(const Lanes& a, const Lanes& b) { return apply(a, b, [](float x, float y) { return x * y; }); }
+static inline Lanes max(const Lanes& a, const Lanes& b) { return apply(a, b, [](float x, float y) { return std::max(x, y); }); }
+static inline int lessEqual(const Lanes& a, const Lanes& b) {
+    int mask = 0;
+    for (size_t i = 0; i < LANES; ++i) {
+        mask |= (a.values[i] <= b.values[i]) ? (1 << i) : 0;
+    }
+    return mask;
+}
+#endif
+
+void EntitySpatialIndex::Bounds::resize(size_t size) {
+    // new entries are empty: no test passes for them, and they don't grow the nodes above them
+    minX.resize(size, FLT_MAX);
+    minY.resize(size, FLT_MAX);
+    minZ.resize(size, FLT_MAX);
+    maxX.resize(size, -FLT_MAX);
+    maxY.resize(size, -FLT_MAX);
+    maxZ.resize(size, -FLT_MAX);
+}
+
+void EntitySpatialIndex::Bounds::set(size_t index, const glm::vec3& minimum, const glm::vec3& maximum) {
+    minX[index] = minimum.x;
+    minY[index] = minimum.y;
+    minZ[index] = minimum.z;
+    maxX[index] = maximum.x;
+    maxY[index] = maximum.y;
+    maxZ[index] = maximum.z;
+}
+
+void EntitySpatialIndex::Bounds::setEmpty(size_t index) {
+    set(index, glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+}
+
+void EntitySpatialIndex::Bounds::copy(size_t to, const Bounds& from, size_t index) {
+    set(to, glm::vec3(from.minX[index], from.minY[index], from.minZ[index]),
+        glm::vec3(from.maxX[index], from.maxY[index], from.maxZ[index]));
+}
+
+static size_t roundUpToGroup(size_t size) {
+    const size_t GROUP = EntitySpatialIndex::BRANCHING;
+    return (size + GROUP - 1) / GROUP * GROUP;
+}
+
+void EntitySpatialIndex::insert(const EntityItemPointer& entity, const AACube& bounds) {
+    withWriteLock([&] {
+        QUuid id = entity->getID();
+        if (_indices.contains(id)) {
+            removeEntry(id);
+        }
+
+        if (_end == _entries.size()) {
+            _entries.resize(_end + BRANCHING);
+            _entities.resize(_end + BRANCHING);
+        }
+        _entries.set(_end, bounds.getMinimumPoint(), bounds.getMaximumPoint());
+        _entities[_end] = entity;
+        _indices.insert(id, (uint32_t)_end);
+        ++_end;
+    });
+}
+
+void EntitySpatialIndex::remove(const EntityItemPointer& entity) {
+    withWriteLock([&] {
+        QUuid id = entity->getID();
+        if (!_indices.contains(id)) {
+            return;
+        }
+        removeEntry(id);
+
+        if (_indices.isEmpty()) {
+            clear();
+        }
+    });
+}
+
+void EntitySpatialIndex::removeEntry(const QUuid& id) {
+    size_t index = *_indices.find(id);
+    _indices.remove(id);
+
+    if (index < _numSorted) {
+        // the nodes above keep bounding the removed entry until the next rebuild
+        _entries.setEmpty(index);
+        _entities[index].reset();
+        ++_numRemoved;
+        return;
+    }
+
+    // the tail isn't sorted, its last entry can fill the hole
+    size_t last = _end - 1;
+    if (index != last) {
+        _entries.copy(index, _entries, last);
+        _entities[index] = std::move(_entities[last]);
+        _indices.insert(_entities[index]->getID(), (uint32_t)index);
+    }
+    _entries.setEmpty(last);
+    _entities[last].reset();
+    --_end;
+}
+
+void EntitySpatialIndex::clear() {
+    withWriteLock([&] {
+        _entries = Bounds();
+        _entities.clear();
+        _indices.clear();
+        _levels.clear();
+        _numSorted = 0;
+        _end = 0;
+        _numRemoved = 0;
+    });
+}
+
+int EntitySpatialIndex::size() const {
+    return resultWithReadLock<int>([&] {
+        return _indices.size();
+    });
+}
+
+bool EntitySpatialIndex::needsRebuild() const {
+    size_t numChanged = (_end - _numSorted) + _numRemoved;
+    return numChanged > std::max(MIN_ENTRIES_BEFORE_REBUILD, (size_t)_indices.size() / 16);
+}
+
+// spreads the low 10 bits of value three bits apart, to interleave them with two other values
+static uint32_t spreadBits(uint32_t value) {
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+void EntitySpatialIndex::rebuild() {
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+    std::vector<SortEntry> sortEntries;
+    sortEntries.reserve(_indices.size());
+
+    glm::vec3 low(FLT_MAX);
+    glm::vec3 high(-FLT_MAX);
+    for (size_t i = 0; i < _end; ++i) {
+        if (_entities[i]) {
+            glm::vec3 center = 0.5f * glm::vec3(_entries.minX[i] + _entries.maxX[i], _entries.minY[i] + _entries.maxY[i],
+                _entries.minZ[i] + _entries.maxZ[i]);
+            low = glm::min(low, center);
+            high = glm::max(high, center);
+        }
+    }
+    glm::vec3 scale = 1023.0f / glm::max(high - low, glm::vec3(EPSILON));
+
+    // the element cubes of the octree come in a handful of sizes: keeping each size together, and each size along
+    // a Morton curve, keeps the few big cubes from widening the nodes over the many small ones
+    for (size_t i = 0; i < _end; ++i) {
+        if (!_entities[i]) {
+            continue;
+        }
+        int exponent;
+        frexpf(_entries.maxX[i] - _entries.minX[i], &exponent);
+        uint64_t sizeClass = (uint64_t)glm::clamp(exponent + 64, 0, 127);
+
+        glm::vec3 center = 0.5f * glm::vec3(_entries.minX[i] + _entries.maxX[i], _entries.minY[i] + _entries.maxY[i],
+            _entries.minZ[i] + _entries.maxZ[i]);
+        glm::uvec3 cell = glm::uvec3((center - low) * scale);
+        uint32_t morton = spreadBits(cell.x) | (spreadBits(cell.y) << 1) | (spreadBits(cell.z) << 2);
+
+        sortEntries.push_back({ (sizeClass << 32) | morton, (uint32_t)i });
+    }
+    std::sort(sortEntries.begin(), sortEntries.end(), [](const SortEntry& a, const SortEntry& b) {
+        return a.key < b.key;
+    });
+
+    size_t numEntries = sortEntries.size();
+    Bounds entries;
+    entries.resize(roundUpToGroup(numEntries));
+    std::vector<EntityItemPointer> entities(entries.size());
+    for (size_t i = 0; i < numEntries; ++i) {
+        size_t index = sortEntries[i].index;
+        entries.copy(i, _entries, index);
+        entities[i] = std::move(_entities[index]);
+        *_indices.find(entities[i]->getID()) = (uint32_t)i;
+    }
+    std::swap(_entries, entries);
+    _entities.swap(entities);
+    // the tail starts on a whole group, so that it can be scanned a whole group of lanes at a time too
+    _numSorted = _entries.size();
+    _end = _numSorted;
+    _numRemoved = 0;
+
+    _levels.clear();
+    size_t numItems = numEntries;
+    while (numItems > (size_t)BRANCHING) {
+        const Bounds& items = _levels.empty() ? _entries : _levels.back();
+        size_t numNodes = (numItems + BRANCHING - 1) / BRANCHING;
+        Bounds nodes;
+        nodes.resize(roundUpToGroup(numNodes));
+        for (size_t node = 0; node < numNodes; ++node) {
+            size_t first = node * BRANCHING;
+            auto minOf = [&](const std::vector<float>& values) {
+                return *std::min_element(values.begin() + first, values.begin() + first + BRANCHING);
+            };
+            auto maxOf = [&](const std::vector<float>& values) {
+                return *std::max_element(values.begin() + first, values.begin() + first + BRANCHING);
+            };
+            nodes.set(node, glm::vec3(minOf(items.minX), minOf(items.minY), minOf(items.minZ)),
+                glm::vec3(maxOf(items.maxX), maxOf(items.maxY), maxOf(items.maxZ)));
+        }
+        _levels.push_back(std::move(nodes));
+        numItems = numNodes;
+    }
+}
+
+namespace {
+
+class BoxTest {
+public:
+    BoxTest(const glm::vec3& minimum, const glm::vec3& maximum) :
+        _minX(broadcast(minimum.x)), _minY(broadcast(minimum.y)), _minZ(broadcast(minimum.z)),
+        _maxX(broadcast(maximum.x)), _maxY(broadcast(maximum.y)), _maxZ(broadcast(maximum.z)) {}
+
+    int operator()(const Columns& bounds, size_t first) const {
+        return lessEqual(load(bounds[0] + first), _maxX) & lessEqual(load(bounds[1] + first), _maxY) &
+            lessEqual(load(bounds[2] + first), _maxZ) & lessEqual(_minX, load(bounds[3] + first)) &
+            lessEqual(_minY, load(bounds[4] + first)) & lessEqual(_minZ, load(bounds[5] + first));
+    }
+
+private:
+    Lanes _minX, _minY, _minZ;
+    Lanes _maxX, _maxY, _maxZ;
+};
+
+class SphereTest {
+public:
+    SphereTest(const glm::vec3& center, float radius) :
+        _x(broadcast(center.x)), _y(broadcast(center.y)), _z(broadcast(center.z)),
+        _radiusSquared(broadcast(radius * radius)), _zero(broadcast(0.0f)) {}
+
+    int operator()(const Columns& bounds, size_t first) const {
+        // distance from the center to the box, per axis, is zero if the center is between the box's sides
+        Lanes dx = add(max(sub(load(bounds[0] + first), _x), _zero), max(sub(_x, load(bounds[3] + first)), _zero));
+        Lanes dy = add(max(sub(load(bounds[1] + first), _y), _zero), max(sub(_y, load(bounds[4] + first)), _zero));
+        Lanes dz = add(max(sub(load(bounds[2] + first), _z), _zero), max(sub(_z, load(bounds[5] + first)), _zero));
+        return lessEqual(add(add(mul(dx, dx), mul(dy, dy)), mul(dz, dz)), _radiusSquared);
+    }
+
+private:
+    Lanes _x, _y, _z;
+    Lanes _radiusSquared;
+    Lanes _zero;
+};
+
+class ViewTest {
+public:
+    ViewTest(const ViewFrustum& frustum) :
+        _keyhole(frustum.getPosition(), frustum.getCenterRadius()), _zero(broadcast(0.0f)) {
+        const ::Plane* planes = frustum.getPlanes();
+        for (int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+            const glm::vec3& normal = planes[i].getNormal();
+            _planes[i].normal[0] = broadcast(normal.x);
+            _planes[i].normal[1] = broadcast(normal.y);
+            _planes[i].normal[2] = broadcast(normal.z);
+            _planes[i].d = broadcast(planes[i].getDCoefficient());
+            // the farthest vertex along the normal takes the max side on the axes where the normal is positive
+            _planes[i].farthest[0] = normal.x > 0.0f ? 3 : 0;
+            _planes[i].farthest[1] = normal.y > 0.0f ? 4 : 1;
+            _planes[i].farthest[2] = normal.z > 0.0f ? 5 : 2;
+        }
+    }
+
+    int operator()(const Columns& bounds, size_t first) const {
+        const int ALL_LANES = (1 << LANES) - 1;
+        int inside = ALL_LANES;
+        for (const auto& plane : _planes) {
+            Lanes distance = add(add(mul(plane.normal[0], load(bounds[plane.farthest[0]] + first)),
+                mul(plane.normal[1], load(bounds[plane.farthest[1]] + first))),
+                add(mul(plane.normal[2], load(bounds[plane.farthest[2]] + first)), plane.d));
+            inside &= lessEqual(_zero, distance);
+        }
+        return inside == ALL_LANES ? inside : inside | _keyhole(bounds, first);
+    }
+
+private:
+    struct Plane {
+        Lanes normal[3];
+        Lanes d;
+        int farthest[3];
+    };
+
+    Plane _planes[NUM_FRUSTUM_PLANES];
+    SphereTest _keyhole;
+    Lanes _zero;
+};
+
+}
+
+template <typename Test>
+void EntitySpatialIndex::findInGroup(const Test& test, size_t level, size_t first,
+                                     std::vector<EntityItemPointer>& found) const {
+    Columns bounds = (level == 0 ? _entries : _levels[level - 1]).columns();
+    for (size_t lane = 0; lane < (size_t)BRANCHING; lane += LANES) {
+        int mask = test(bounds, first + lane);
+        for (size_t i = first + lane; mask != 0; ++i, mask >>= 1) {
+            if (!(mask & 1)) {
+                continue;
+            }
+            if (level == 0) {
+                if (_entities[i]) {
+                    found.push_back(_entities[i]);
+                }
+            } else {
+                findInGroup(test, level - 1, i * BRANCHING, found);
+            }
+        }
+    }
+}
+
+template <typename Test>
+void EntitySpatialIndex::find(const Test& test, std::vector<EntityItemPointer>& found) {
+    // the rebuild waits for a query, so that loading or clearing many entities only rebuilds once
+    if (resultWithReadLock<bool>([&] { return needsRebuild(); })) {
+        withWriteLock([&] {
+            if (needsRebuild()) {
+                rebuild();
+            }
+        });
+    }
+
+    withReadLock([&] {
+        if (_numSorted > 0) {
+            findInGroup(test, _levels.size(), 0, found);
+        }
+
+        Columns bounds = _entries.columns();
+        for (size_t first = _numSorted; first < _end; first += LANES) {
+            int mask = test(bounds, first);
+            for (size_t i = first; mask != 0; ++i, mask >>= 1) {
+                if ((mask & 1) && _entities[i]) {
+                    found.push_back(_entities[i]);
+                }
+            }
+        }
+    });
+}
+
+void EntitySpatialIndex::findTouchingSphere(const glm::vec3& center, float radius,
+                                            std::vector<EntityItemPointer>& found) {
+    find(SphereTest(center, radius), found);
+}
+
+void EntitySpatialIndex::findTouchingBox(const AABox& box, std::vector<EntityItemPointer>& found) {
+    find(BoxTest(box.getMinimumPoint(), box.getMaximumPoint()), found);
+}
+
+void EntitySpatialIndex::findInView(const ViewFrustum& frustum, std::vector<EntityItemPointer>& found) {
+    find(ViewTest(frustum), found);
+}
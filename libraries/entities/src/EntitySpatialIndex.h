@@ -0,0 +1,94 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <AACube.h>
+#include <shared/ReadWriteLockable.h>
+#include <UuidHashMap.h>
+#include <ViewFrustum.h>
+
+#include "EntityItem.h"
+
+/// Flat bounding volume hierarchy of the cubes of the tree elements that hold the entities, for the spatial queries
+/// of EntityTree. The entries and the nodes are stored as structure of arrays, so that a query tests a node's
+/// children, or a leaf's entries, with a few SIMD instructions over contiguous floats instead of chasing element
+/// pointers down the octree.
+///
+/// The hierarchy is implicit: entries are sorted by the size of their cube, then along a Morton curve, and every
+/// BRANCHING consecutive entries or nodes get a parent node bounding them. Entries added since the last sort go to
+/// an unsorted tail that is scanned linearly, and removed entries are only emptied; the next query rebuilds the
+/// whole index once either grows past a fraction of its size.
+///
+/// The entries are the element cubes rather than the entities' own boxes, so that the index only changes when an
+/// entity changes elements - see EntityTreeElement::addEntityItem() and removeEntityItem(). Queries return
+/// candidates that the caller still checks against the entity's own box, like the octree traversals did.
+class EntitySpatialIndex : public ReadWriteLockable {
+public:
+    static const int BRANCHING = 8;
+
+    void insert(const EntityItemPointer& entity, const AACube& bounds);
+    void remove(const EntityItemPointer& entity);
+    void clear();
+
+    int size() const;
+
+    void findTouchingSphere(const glm::vec3& center, float radius, std::vector<EntityItemPointer>& found);
+    void findTouchingBox(const AABox& box, std::vector<EntityItemPointer>& found);
+
+    /// Entities whose bounds may be in the frustum or its keyhole
+    void findInView(const ViewFrustum& frustum, std::vector<EntityItemPointer>& found);
+
+    /// The minimum x, y and z, then the maximum x, y and z, of consecutive entries or nodes
+    using Columns = std::array<const float*, 6>;
+
+private:
+    struct Bounds {
+        std::vector<float> minX, minY, minZ;
+        std::vector<float> maxX, maxY, maxZ;
+
+        size_t size() const { return minX.size(); }
+        Columns columns() const { return {{ minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data() }}; }
+        void resize(size_t size);
+        void set(size_t index, const glm::vec3& minimum, const glm::vec3& maximum);
+        void setEmpty(size_t index);
+        void copy(size_t to, const Bounds& from, size_t index);
+    };
+
+    template <typename Test>
+    void find(const Test& test, std::vector<EntityItemPointer>& found);
+    template <typename Test>
+    void findInGroup(const Test& test, size_t level, size_t first, std::vector<EntityItemPointer>& found) const;
+
+    void removeEntry(const QUuid& id);
+
+    bool needsRebuild() const;
+    void rebuild();
+
+    Bounds _entries; // sized to a multiple of BRANCHING, the unused entries are empty
+    std::vector<EntityItemPointer> _entities; // null for the unused entries
+    UuidHashMap<uint32_t> _indices; // index of each entity's entry
+    size_t _numSorted { 0 }; // entries before this are sorted and under _levels
+    size_t _end { 0 }; // entries from _numSorted to this are the unsorted tail
+    size_t _numRemoved { 0 }; // emptied entries of the sorted range
+
+    // _levels[0] bounds groups of BRANCHING entries, each following level groups of BRANCHING nodes of the level
+    // before, up to the last level that is a single group
+    std::vector<Bounds> _levels;
+};
+
+#endif // hifi_EntitySpatialIndex_h
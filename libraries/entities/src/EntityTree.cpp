@@ -10,6 +10,12 @@
 //
 
 #include "EntityTree.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
 #include <openssl/err.h>
@@ -25,9 +31,12 @@
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <TBBHelpers.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
+#include <OctreeJournal.h>
+#include <OctreeSnapshot.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -45,6 +54,8 @@
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 static const QString DOMAIN_UNLIMITED = "domainUnlimited";
+// enough entities for a decoding task to be worth handing to another thread, and to amortize its script engine
+static const int ENTITIES_PER_LOAD_TASK = 256;
 
 EntityTree::EntityTree(bool shouldReaverage) :
     Octree(shouldReaverage)
@@ -76,11 +87,44 @@ void EntityTree::createRootElement() {
 }
 
 OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
-    auto newElement = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newElement = EntityTreeElementPointer(new EntityTreeElement(octalCode), std::default_delete<EntityTreeElement>(),
+                                               SlabAllocator<EntityTreeElement>());
     newElement->setTree(std::static_pointer_cast<EntityTree>(shared_from_this()));
     return std::static_pointer_cast<OctreeElement>(newElement);
 }
 
+EntityTreeSnapshotPointer EntityTree::getSnapshot() {
+    uint64_t now = usecTimestampNow();
+    EntityTreeSnapshotPointer snapshot = std::atomic_load(&_snapshot);
+    if (snapshot && now - _snapshotCheckTime < SNAPSHOT_MAX_AGE) {
+        return snapshot;
+    }
+
+    // one caller refreshes the snapshot while the others carry on with the current one, unless there is none yet
+    std::unique_lock<std::mutex> lock(_snapshotMutex, std::defer_lock);
+    if (snapshot) {
+        if (!lock.try_lock()) {
+            return snapshot;
+        }
+    } else {
+        lock.lock();
+    }
+
+    snapshot = std::atomic_load(&_snapshot);
+    if (!snapshot || now - _snapshotCheckTime >= SNAPSHOT_MAX_AGE) {
+        withReadLock([&] {
+            // changes mark the elements up to the root, an unchanged root means an unchanged tree
+            EntityTreeElementPointer root = getRoot();
+            if (!snapshot || root->getLastChanged() >= snapshot->getTimestamp()) {
+                snapshot = EntityTreeSnapshot::build(root);
+                std::atomic_store(&_snapshot, snapshot);
+            }
+        });
+        _snapshotCheckTime = now;
+    }
+    return snapshot;
+}
+
 void EntityTree::eraseDomainAndNonOwnedEntities() {
     emit clearingEntities();
 
@@ -90,18 +134,18 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
     }
 
     this->withWriteLock([&] {
-        QHash<EntityItemID, EntityItemPointer> savedEntities;
+        UuidHashMap<EntityItemPointer> savedEntities;
         // NOTE: lock the Tree first, then lock the _entityMap.
         // It should never be done the other way around.
         QReadLocker locker(&_entityMapLock);
-        foreach(EntityItemPointer entity, _entityMap) {
+        for (const EntityItemPointer& entity : _entityMap) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupDomainAndNonOwnedEntities();
             }
 
             if (entity->isLocalEntity() || (entity->isAvatarEntity() && entity->getOwningAvatarID() == getMyAvatarSessionUUID())) {
-                savedEntities[entity->getEntityItemID()] = entity;
+                savedEntities.insert(entity->getEntityItemID(), entity);
             } else {
                 int32_t spaceIndex = entity->getSpaceIndex();
                 if (spaceIndex != -1) {
@@ -137,10 +181,10 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     if (_simulation) {
         _simulation->clearEntities();
     }
-    QHash<EntityItemID, EntityItemPointer> localMap;
+    UuidHashMap<EntityItemPointer> localMap;
     localMap.swap(_entityMap);
     this->withWriteLock([&] {
-        foreach(EntityItemPointer entity, localMap) {
+        for (const EntityItemPointer& entity : localMap) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupEntities();
@@ -154,6 +198,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
+    std::atomic_store(&_snapshot, EntityTreeSnapshotPointer());
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -748,6 +793,8 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
         if (getIsServer()) {
             removeCertifiedEntityOnServer(theEntity);
 
+            journalEntityErased(theEntity->getEntityItemID());
+
             // set up the deleted entities ID
             QWriteLocker recentlyDeletedEntitiesLocker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
@@ -986,194 +1033,88 @@ QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadiu
     return args.closestEntity;
 }
 
-class FindEntitiesInSphereArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereArgs* args = static_cast<FindEntitiesInSphereArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphere(args->position, args->targetRadius, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
-}
-
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInSphereWithTypeArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    EntityTypes::EntityType type;
-    PickFilter searchFilter;
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findTouchingSphere(center, radius, candidates);
 
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithTypeArgs* args = static_cast<FindEntitiesInSphereWithTypeArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithType(args->position, args->targetRadius, args->type, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+    for (const EntityItemPointer& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+            EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
     }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInSphereWithNameArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    QString name;
-    bool caseSensitive;
-    PickFilter searchFilter;
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findTouchingSphere(center, radius, candidates);
 
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithNameArgs* args = static_cast<FindEntitiesInSphereWithNameArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithName(args->position, args->targetRadius, args->name, args->caseSensitive, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+    for (const EntityItemPointer& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) && type == entity->getType() &&
+            EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
     }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
-    foundEntities.swap(args.entities);
-}
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findTouchingSphere(center, radius, candidates);
 
-class FindEntitiesInCubeArgs {
-public:
-    // Inputs
-    AACube cube;
-    PickFilter searchFilter;
-
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInCube(args->cube, args->searchFilter, args->entities);
-        return true;
+    for (const EntityItemPointer& entity : candidates) {
+        if (!EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+            continue;
+        }
+        QString entityName = entity->getName();
+        if ((caseSensitive && name != entityName) || (!caseSensitive && name.toLower() != entityName.toLower())) {
+            continue;
+        }
+        if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
     }
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInBoxArgs {
-public:
-    // Inputs
-    AABox box;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInBox(args->box, args->searchFilter, args->entities);
-        return true;
-    }
-    return false;
+    evalEntitiesInBox(AABox(cube), searchFilter, foundEntities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInFrustumArgs {
-public:
-    // Inputs
-    ViewFrustum frustum;
-    PickFilter searchFilter;
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findTouchingBox(box, candidates);
 
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInFrustumArgs* args = static_cast<FindEntitiesInFrustumArgs*>(extraData);
-    if (element->isInView(args->frustum)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInFrustum(args->frustum, args->searchFilter, args->entities);
-        return true;
+    for (const EntityItemPointer& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) && EntityTreeElement::entityTouchesBox(entity, box)) {
+            entities.push_back(entity->getID());
+        }
     }
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findInView(frustum, candidates);
+
+    QVector<QUuid> entities;
+    for (const EntityItemPointer& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) && EntityTreeElement::entityInView(entity, frustum)) {
+            entities.push_back(entity->getID());
+        }
+    }
+    foundEntities.swap(entities);
 }
 
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
@@ -1750,6 +1691,49 @@ void EntityTree::processChallengeOwnershipPacket(ReceivedMessage& message, const
     }
 }
 
+/// An entity add, edit or physics update on its way from an edit packet into the tree
+class EntityTree::EntityEdit : public OctreeEdit {
+public:
+    EntityEdit(PacketType type, const SharedNodePointer& senderNode) :
+        type(type),
+        senderNode(senderNode),
+        isClone(type == PacketType::EntityClone),
+        isAdd(type == PacketType::EntityAdd || type == PacketType::EntityClone),
+        isPhysics(type == PacketType::EntityPhysics) {}
+
+    PacketType type;
+    SharedNodePointer senderNode;
+    bool isClone;
+    bool isAdd;
+    bool isPhysics;
+
+    // erases and clones depend on every edit before them, a batch keeps them undecoded and hands them to
+    // processEditPacketData() when applied
+    ReceivedMessage* message { nullptr };
+    const unsigned char* editData { nullptr };
+    int maxLength { 0 };
+
+    bool valid { false };
+    EntityItemID entityItemID;
+    EntityItemProperties properties;
+    EntityItemID entityIDToClone;
+    EntityItemPointer entityToClone;
+    EntityItemPointer existingEntity;
+
+    bool suppressDisallowedClientScript { false };
+    bool suppressDisallowedServerScript { false };
+    bool suppressDisallowedPrivateUserData { false };
+
+    bool filtered { false };
+    bool allowed { true };
+    bool changedByFilter { false }; // the filter rewrote the properties, which then depend on the edit as sent
+
+    int numEdits { 1 }; // the edits merged into this one, for the edit stats
+    quint64 decodeTime { 0 };
+    quint64 lookupTime { 0 };
+    quint64 filterTime { 0 };
+};
+
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                      const SharedNodePointer& senderNode) {
 
@@ -1759,8 +1743,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
-    bool isClone = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -1770,310 +1752,426 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityClone:
-            isClone = true; // fall through to next case
-            // FALLTHRU
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
-            // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
-            _totalEditMessages++;
-
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
-            EntityItemPointer entityToClone;
-            if (isClone) {
-                QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
-                    if (entityToClone) {
-                        properties = entityToClone->getProperties();
-                    }
+            EntityEdit edit(message.getType(), senderNode);
+            processedBytes = decodeEdit(edit, editData, maxLength);
+            applyEdit(edit);
+            break;
+        }
+
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
+
+OctreeEditPointer EntityTree::decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& senderNode, int& bytesRead) {
+    std::unique_ptr<EntityEdit> edit { new EntityEdit(message.getType(), senderNode) };
+    switch (message.getType()) {
+        case PacketType::EntityAdd:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityEdit:
+            bytesRead = decodeEdit(*edit, editData, maxLength);
+            break;
+
+        default:
+            // a packet only holds edits of its own type, keep the rest of it for processEditPacketData()
+            edit->message = &message;
+            edit->editData = editData;
+            edit->maxLength = maxLength;
+            bytesRead = maxLength;
+            break;
+    }
+    return OctreeEditPointer(std::move(edit));
+}
+
+int EntityTree::prepareEdits(OctreeEdits& edits) {
+    // the last mergeable edit of each entity, among the edits kept so far
+    QHash<EntityItemID, size_t> lastEdits;
+    size_t numKept = 0;
+    int numMerged = 0;
+
+    for (size_t i = 0; i < edits.size(); ++i) {
+        EntityEdit& edit = static_cast<EntityEdit&>(*edits[i]);
+        if (edit.message) {
+            // erases and clones may touch any entity, don't merge edits across them
+            lastEdits.clear();
+        } else {
+            // filter ahead of the lock, against the tree as it is before the batch; the edits of entities added in the
+            // batch can only be filtered once the entities exist, when applied
+            if (!edit.isAdd) {
+                filterEdit(edit);
+            }
+
+            bool mergeable = !edit.isAdd && edit.filtered && edit.valid && edit.allowed && !edit.changedByFilter &&
+                !edit.suppressDisallowedClientScript && !edit.suppressDisallowedServerScript &&
+                !edit.suppressDisallowedPrivateUserData;
+
+            auto lastEdit = lastEdits.find(edit.entityItemID);
+            if (mergeable && lastEdit != lastEdits.end()) {
+                EntityEdit& previousEdit = static_cast<EntityEdit&>(*edits[lastEdit.value()]);
+                if (previousEdit.type == edit.type && previousEdit.senderNode == edit.senderNode) {
+                    // the later edit's properties win, and so does its timestamp
+                    quint64 lastEdited = edit.properties.getLastEdited();
+                    previousEdit.properties.merge(edit.properties);
+                    previousEdit.properties.setLastEdited(lastEdited);
+                    previousEdit.numEdits += edit.numEdits;
+                    previousEdit.decodeTime += edit.decodeTime;
+                    previousEdit.lookupTime += edit.lookupTime;
+                    previousEdit.filterTime += edit.filterTime;
+                    ++numMerged;
+                    continue;
                 }
+            }
+
+            if (mergeable) {
+                lastEdits[edit.entityItemID] = numKept;
             } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
+                lastEdits.remove(edit.entityItemID);
             }
+        }
 
-            endDecode = usecTimestampNow();
+        if (numKept != i) {
+            edits[numKept] = std::move(edits[i]);
+        }
+        ++numKept;
+    }
+    edits.resize(numKept);
+    return numMerged;
+}
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
+void EntityTree::applyEdits(OctreeEdits& edits) {
+    for (auto& octreeEdit : edits) {
+        EntityEdit& edit = static_cast<EntityEdit&>(*octreeEdit);
+        if (edit.message) {
+            const unsigned char* editData = edit.editData;
+            int bytesLeft = edit.maxLength;
+            while (bytesLeft > 0) {
+                int bytesRead = processEditPacketData(*edit.message, editData, bytesLeft, edit.senderNode);
+                if (bytesRead <= 0) {
+                    break;
                 }
+                editData += bytesRead;
+                bytesLeft -= bytesRead;
             }
+        } else {
+            applyEdit(edit);
+        }
+    }
+}
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+int EntityTree::decodeEdit(EntityEdit& edit, const unsigned char* editData, int maxLength) {
+    int processedBytes = 0;
+    quint64 startDecode = usecTimestampNow();
 
-                bool wasDeletedBecauseOfClientScript = false;
+    if (edit.isClone) {
+        QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        edit.valid = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, edit.entityIDToClone, edit.entityItemID);
+        if (edit.valid) {
+            edit.entityToClone = findEntityByEntityItemID(edit.entityIDToClone);
+            if (edit.entityToClone) {
+                edit.properties = edit.entityToClone->getProperties();
+            }
+        }
+    } else {
+        edit.valid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, edit.entityItemID, edit.properties);
+    }
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+    edit.decodeTime = usecTimestampNow() - startDecode;
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
+    const SharedNodePointer& senderNode = edit.senderNode;
+    EntityItemProperties& properties = edit.properties;
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+    if (edit.valid && !_entityScriptSourceWhitelist.isEmpty()) {
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+        bool wasDeletedBecauseOfClientScript = false;
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
-            }
-
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+            if (!clientScriptPassedWhitelist) {
                 if (wantEditLogging()) {
                     qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+                        << "] attempting to set entity script not on whitelist, edit rejected";
                 }
 
                 // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                if (isAdd) {
+                if (edit.isAdd) {
                     QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                    _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    validEditPacket = false;
+                    _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), edit.entityItemID);
+                    edit.valid = false;
+                    wasDeletedBecauseOfClientScript = true;
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    edit.suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                    (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
                 }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (edit.isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), edit.entityItemID);
+                        edit.valid = false;
+                    }
+                } else {
+                    edit.suppressDisallowedServerScript = true;
                 }
             }
+        }
+    }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+    if (!properties.getPrivateUserData().isEmpty() && edit.valid && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
 
-                if (existingEntity && !isAdd) {
+        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+        if (edit.isAdd) {
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), edit.entityItemID);
+            edit.valid = false;
+        } else {
+            edit.suppressDisallowedPrivateUserData = true;
+        }
+    }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+    if (!edit.isClone) {
+        if ((edit.isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+            (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
+            }
+        }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+        if (edit.isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
+
+    return processedBytes;
+}
+
+void EntityTree::filterEdit(EntityEdit& edit) {
+    if (!edit.isAdd) {
+        // search for the entity by EntityItemID
+        quint64 startLookup = usecTimestampNow();
+        edit.existingEntity = findEntityByEntityItemID(edit.entityItemID);
+        edit.lookupTime += usecTimestampNow() - startLookup;
+        if (!edit.existingEntity) {
+            // this is not an add-entity operation, and we don't know about the identified entity.
+            return;
+        }
+    }
+
+    if (!edit.valid) {
+        return;
+    }
+
+    quint64 startFilter = usecTimestampNow();
+    bool wasChanged = false;
+    // Having (un)lock rights bypasses the filter, unless it's a physics result.
+    FilterType filterType = edit.isPhysics ? FilterType::Physics : (edit.isAdd ? FilterType::Add : FilterType::Edit);
+    edit.allowed = (!edit.isPhysics && edit.senderNode->isAllowedEditor()) ||
+        filterProperties(edit.existingEntity, edit.properties, edit.properties, wasChanged, filterType);
+    if (!edit.allowed) {
+        auto timestamp = edit.properties.getLastEdited();
+        edit.properties = EntityItemProperties();
+        edit.properties.setLastEdited(timestamp);
+    }
+    edit.changedByFilter = wasChanged;
+    if (!edit.allowed || wasChanged) {
+        bumpTimestamp(edit.properties);
+        // For now, free ownership on any modification.
+        edit.properties.clearSimulationOwner();
+    }
+    edit.filtered = true;
+    edit.filterTime += usecTimestampNow() - startFilter;
+}
+
+void EntityTree::applyEdit(EntityEdit& edit) {
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    _totalEditMessages += edit.numEdits;
+
+    if (!edit.filtered) {
+        filterEdit(edit);
+    } else if (!edit.isAdd) {
+        // the entity may have been deleted since the edit was filtered
+        quint64 startLookup = usecTimestampNow();
+        edit.existingEntity = findEntityByEntityItemID(edit.entityItemID);
+        edit.lookupTime += usecTimestampNow() - startLookup;
+    }
+
+    const SharedNodePointer& senderNode = edit.senderNode;
+    const EntityItemID& entityItemID = edit.entityItemID;
+    EntityItemProperties& properties = edit.properties;
+    EntityItemPointer& existingEntity = edit.existingEntity;
+    bool isAdd = edit.isAdd;
+    bool isClone = edit.isClone;
+    bool allowed = edit.allowed;
+
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (edit.valid && (isAdd || existingEntity)) {
+        if (existingEntity && !isAdd) {
+
+            if (edit.suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
+            }
+
+            if (edit.suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
+
+            if (edit.suppressDisallowedPrivateUserData) {
+                bumpTimestamp(properties);
+                properties.setPrivateUserData(existingEntity->getPrivateUserData());
+            }
+
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+            startUpdate = usecTimestampNow();
+            if (!edit.isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(existingEntity, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            journalEntityUpdated(existingEntity->getEntityItemID());
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            const EntityItemID& entityIDToClone = edit.entityIDToClone;
+            EntityItemPointer& entityToClone = edit.entityToClone;
+            bool failedAdd = !allowed;
+            bool isCertified = !properties.getCertificateID().isEmpty();
+            bool isCloneable = properties.getCloneable();
+            int cloneLimit = properties.getCloneLimit();
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an uncertified entity with ID:" << entityItemID;
+            } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add a certified entity with ID:" << entityItemID;
+            } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+            } else if (isClone && !isCloneable) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+            } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+            } else {
+                if (isClone) {
+                    properties.convertToCloneProperties(entityIDToClone);
+                }
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
+                // this is a new entity... assign a new entityID
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+
+                if (newEntity && isCertified && getIsServer()) {
+                    if (!properties.verifyStaticCertificateProperties()) {
+                        qCDebug(entities) << "User" << senderNode->getUUID()
+                            << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                            << "static certificate verification.";
+                        // Delete the entity we just added if it doesn't pass static certificate verification
+                        deleteEntity(entityItemID, true);
+                    } else {
+                        validatePop(properties.getCertificateID(), entityItemID, senderNode);
                     }
+                }
+
+                if (newEntity && isClone) {
+                    entityToClone->addCloneID(newEntity->getEntityItemID());
+                    newEntity->setCloneOriginID(entityIDToClone);
+                }
 
-                    // if the EntityItem exists, then update it
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    journalEntityUpdated(newEntity->getEntityItemID());
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
+                    
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
-
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
-                        }
-
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
-
-
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
-
-            break;
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
         }
-
-        default:
-            processedBytes = 0;
-            break;
     }
-    return processedBytes;
+
+    _totalDecodeTime += edit.decodeTime;
+    _totalLookupTime += edit.lookupTime;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += edit.filterTime;
 }
 
 
@@ -2459,8 +2557,7 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
     QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
+    if (_entityMap.contains(id)) {
         qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
         assert(false);
         return;
@@ -2474,13 +2571,9 @@ void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
 }
 
 void EntityTree::debugDumpMap() {
-    // QHash's are implicitly shared, so we make a shared copy and use that instead.
-    // This way we might be able to avoid both a lock and a true copy.
-    QHash<EntityItemID, EntityItemPointer> localMap(_entityMap);
+    QReadLocker locker(&_entityMapLock);
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
-    QHashIterator<EntityItemID, EntityItemPointer> i(localMap);
-    while (i.hasNext()) {
-        i.next();
+    for (auto i = _entityMap.begin(); i != _entityMap.end(); ++i) {
         qCDebug(entities) << i.key() << ": " << i.value()->getElement().get();
     }
     qCDebug(entities) << "-----------------------------------------------------";
@@ -2885,163 +2978,232 @@ bool EntityTree::readFromMap(QVariantMap& map) {
 
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
-    // to a QScriptValue, and then to EntityItemProperties.  These properties are used
-    // to add the new entity to the EntityTree.
-    QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
+    // to a QScriptValue, and then to EntityItemProperties - in chunks over threads, as
+    // that is most of the time of a load.  These properties are then used to add the
+    // new entities to the EntityTree, in one pass.
+    const QVariantList entitiesQList = map["Entities"].toList();
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
-    QMap<QUuid, QVector<QUuid>> cloneIDs;
-
-    bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
-
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
-
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
-
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    LoadStats loadStats;
+    quint64 startDecode = usecTimestampNow();
+    int numEntities = entitiesQList.length();
+    std::vector<LoadedEntity> loadedEntities(numEntities);
+    tbb::parallel_for(tbb::blocked_range<int>(0, numEntities, ENTITIES_PER_LOAD_TASK), [&](const tbb::blocked_range<int>& range) {
+        // a script engine can only be used by one thread
+        QScriptEngine scriptEngine;
+        for (int i = range.begin(); i != range.end(); ++i) {
+            decodeLoadedEntity(entitiesQList.at(i).toMap(), contentVersion, scriptEngine, loadedEntities[i]);
         }
+    });
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    QUuid myNodeID;
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (nodeList) {
+        myNodeID = nodeList->getSessionUUID();
+    }
+    for (int i = 0; i < numEntities; ++i) {
+        EntityItemProperties& properties = loadedEntities[i].properties;
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
-        }
+        // handle parentJointName for wearables, here as the avatar's joints are not for other threads
+        if (_myAvatar && properties.getParentID() == AVATAR_SELF_ID) {
+            const QVariantMap entityMap = entitiesQList.at(i).toMap();
+            if (entityMap.contains("parentJointName")) {
+                properties.setParentJointIndex(_myAvatar->getJointIndex(entityMap["parentJointName"].toString()));
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+                qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+                    " mapped it to parentJointIndex " << properties.getParentJointIndex();
             }
         }
 
         if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
             properties.setOwningAvatarID(myNodeID);
         }
+    }
+    loadStats.decodeTime = usecTimestampNow() - startDecode;
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    return addLoadedEntities(loadedEntities, loadStats);
+}
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+void EntityTree::decodeLoadedEntity(QVariantMap entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                    LoadedEntity& loadedEntity) {
+    // QVariantMap --> QScriptValue --> EntityItemProperties
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemProperties& properties = loadedEntity.properties;
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
-            }
+    if (entityMap.contains("id")) {
+        loadedEntity.entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        loadedEntity.entityItemID = EntityItemID(QUuid::createUuid());
+    }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID, see readFromMap())
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
         }
+    }
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
             }
         }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
             }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
         }
+    }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
         }
+    }
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
         }
+    }
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
-            }
+    loadedEntity.decoded = true;
+}
+
+// position of a point in the depth first order of the tree's elements, i.e. the order of their octal codes
+static uint64_t octalCodeOrder(const glm::vec3& point) {
+    const int BITS_PER_AXIS = 21;
+    const float CELLS_PER_AXIS = (float)(1 << BITS_PER_AXIS);
+    glm::vec3 cell = glm::clamp((point + (float)HALF_TREE_SCALE) * (CELLS_PER_AXIS / (float)TREE_SCALE),
+                                glm::vec3(0.0f), glm::vec3(CELLS_PER_AXIS - 1.0f));
+    uint32_t x = (uint32_t)cell.x;
+    uint32_t y = (uint32_t)cell.y;
+    uint32_t z = (uint32_t)cell.z;
+
+    uint64_t order = 0;
+    for (int bit = BITS_PER_AXIS - 1; bit >= 0; --bit) {
+        // the child index at each level, see OctreeElement::getMyChildContainingPoint()
+        order = (order << 3) | (((x >> bit) & 1) << 2) | (((y >> bit) & 1) << 1) | ((z >> bit) & 1);
+    }
+    return order;
+}
+
+bool EntityTree::addLoadedEntities(std::vector<LoadedEntity>& loadedEntities, LoadStats& loadStats) {
+    // add the entities in the order of the elements they go to, so that consecutive additions go down the same
+    // branches of the tree and create its elements depth first, instead of jumping all over it. The position of
+    // children is relative to their parent, so they are added after all the others in their original order.
+    quint64 startSort = usecTimestampNow();
+    std::vector<std::pair<uint64_t, int>> order;
+    order.reserve(loadedEntities.size());
+    for (int i = 0; i < (int)loadedEntities.size(); ++i) {
+        const EntityItemProperties& properties = loadedEntities[i].properties;
+        if (loadedEntities[i].decoded) {
+            uint64_t key = properties.getParentID().isNull() ? octalCodeOrder(properties.getPosition())
+                                                             : std::numeric_limits<uint64_t>::max();
+            order.emplace_back(key, i);
         }
+    }
+    std::sort(order.begin(), order.end());
+    loadStats.sortTime = usecTimestampNow() - startSort;
+
+    quint64 startInsert = usecTimestampNow();
+    {
+        QWriteLocker locker(&_entityMapLock);
+        _entityMap.reserve(_entityMap.size() + (int)order.size());
+    }
+
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
+    bool success = order.size() == loadedEntities.size();
+    for (const auto& entry : order) {
+        const LoadedEntity& loadedEntity = loadedEntities[entry.second];
+        EntityItemPointer entity = addEntity(loadedEntity.entityItemID, loadedEntity.properties);
         if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+            qCDebug(entities) << "adding Entity failed:" << loadedEntity.entityItemID << loadedEntity.properties.getType();
             success = false;
+            continue;
         }
+        loadStats.numItems++;
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
         }
     }
 
@@ -3051,7 +3213,9 @@ bool EntityTree::readFromMap(QVariantMap& map) {
             entity->setCloneIDs(cloneIDs.value(entityID));
         }
     }
+    loadStats.insertTime = usecTimestampNow() - startInsert;
 
+    setLoadStats(loadStats);
     return success;
 }
 
@@ -3066,6 +3230,215 @@ bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& el
     return true;
 }
 
+// records are full EntityAdd edits, so that loading goes through the same path as an entity added by a client
+static bool encodeSnapshotRecord(const EntityItemPointer& entity, QByteArray& record) {
+    static const int INITIAL_RECORD_SIZE = 64 * 1024;
+    static const int MAX_RECORD_SIZE = 64 * 1024 * 1024;
+
+    EntityItemProperties properties = entity->getProperties();
+    properties.markAllChanged();
+
+    // grow the buffer until the whole entity fits in one record
+    OctreeElement::AppendState appendState;
+    int recordSize = std::max(record.capacity(), INITIAL_RECORD_SIZE);
+    do {
+        record.resize(recordSize);
+        EntityPropertyFlags didntFit;
+        appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entity->getEntityItemID(),
+            properties, record, properties.getChangedProperties(), didntFit);
+        recordSize *= 2;
+    } while (appendState != OctreeElement::COMPLETED && recordSize <= MAX_RECORD_SIZE);
+
+    return appendState == OctreeElement::COMPLETED;
+}
+
+bool EntityTree::writeToSnapshotFile(const QString& fileName, const OctreeElementPointer& element) {
+    // the records are encoded under the lock and written after it, so that edits don't wait on the disk
+    std::vector<std::pair<QUuid, QByteArray>> records;
+    QVariantMap namedPaths;
+    withReadLock([&] {
+        // the snapshot covers everything that is pending for the journal
+        {
+            QWriteLocker locker(&_journalLock);
+            _journalUpdatedEntities.clear();
+            _journalErasedEntities.clear();
+        }
+
+        // like the JSON export, this always saves the whole tree
+        records.reserve(_entityMap.size());
+        QByteArray record;
+        for (auto& entity : _entityMap) {
+            if (!entity->isParentIDValid()) {
+                continue;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+            }
+
+            if (!encodeSnapshotRecord(entity, record)) {
+                qCCritical(entities) << "Entity too large to save to snapshot:" << entity->getEntityItemID();
+                continue;
+            }
+            // a copy of just the encoded bytes, the record buffer is reused at its largest size
+            records.emplace_back(entity->getEntityItemID(), QByteArray(record.constData(), record.size()));
+        }
+
+        for (const auto& namedPath : _namedPaths) {
+            namedPaths[namedPath.first] = namedPath.second;
+        }
+    });
+
+    PacketVersion expectedVersion = versionForPacketType(expectedDataPacketType());
+    OctreeSnapshot::Writer writer(fileName, expectedVersion, _persistID, _persistDataVersion);
+    if (!writer.open()) {
+        return false;
+    }
+    for (const auto& record : records) {
+        if (!writer.addRecord(record.first, record.second)) {
+            return false;
+        }
+    }
+
+    QVariantMap metadata;
+    metadata["Paths"] = namedPaths;
+
+    QByteArray metadataBytes;
+    QDataStream metadataStream(&metadataBytes, QIODevice::WriteOnly);
+    metadataStream << metadata;
+    writer.setMetadata(metadataBytes);
+
+    return writer.commit();
+}
+
+bool EntityTree::readFromSnapshotFile(const QString& fileName, const QString& journalFileName) {
+    LoadStats loadStats;
+    quint64 startParse = usecTimestampNow();
+    OctreeSnapshot::Reader reader;
+    if (!reader.open(fileName)) {
+        return false;
+    }
+
+    PacketVersion expectedVersion = versionForPacketType(expectedDataPacketType());
+    if (reader.getContentVersion() != expectedVersion) {
+        qCCritical(entities) << "Snapshot" << fileName << "is of entity version" << reader.getContentVersion()
+            << "but" << expectedVersion << "is expected - convert it from JSON instead";
+        return false;
+    }
+
+    _persistID = reader.getID();
+    _persistDataVersion = (int)reader.getDataVersion();
+
+    QVariantMap metadata;
+    QDataStream metadataStream(reader.getMetadata());
+    metadataStream >> metadata;
+
+    _namedPaths.clear();
+    QVariantMap namedPathsMap = metadata["Paths"].toMap();
+    for (QVariantMap::const_iterator iter = namedPathsMap.begin(); iter != namedPathsMap.end(); ++iter) {
+        _namedPaths[iter.key()] = iter.value().toString();
+    }
+
+    // the latest journal record of an entity overrides its snapshot record, an empty one erases it
+    QHash<QUuid, QByteArray> journaled;
+    if (!journalFileName.isEmpty()) {
+        int numJournaled = OctreeJournal::replay(journalFileName, _persistID, _persistDataVersion, expectedVersion,
+            [&](OctreeJournal::RecordType type, const QUuid& id, const QByteArray& data) {
+                journaled[id] = type == OctreeJournal::Update ? data : QByteArray();
+            });
+        if (numJournaled > 0) {
+            qCDebug(entities) << "Folding" << numJournaled << "journaled edits of" << journaled.size() << "entities into" << fileName;
+        }
+    }
+
+    // decode the records in chunks over threads, then add the entities in one pass
+    std::vector<std::pair<QUuid, QByteArray>> records;
+    records.reserve(reader.getNumRecords() + journaled.size());
+    for (int i = 0; i < reader.getNumRecords(); ++i) {
+        QUuid id = reader.getRecordID(i);
+        if (!journaled.contains(id)) {
+            records.emplace_back(id, reader.getRecord(i));
+        }
+    }
+    for (auto iter = journaled.cbegin(); iter != journaled.cend(); ++iter) {
+        if (!iter.value().isEmpty()) {
+            records.emplace_back(iter.key(), iter.value());
+        }
+    }
+    loadStats.parseTime = usecTimestampNow() - startParse;
+
+    quint64 startDecode = usecTimestampNow();
+    int numEntities = (int)records.size();
+    std::vector<LoadedEntity> loadedEntities(numEntities);
+    tbb::parallel_for(tbb::blocked_range<int>(0, numEntities, ENTITIES_PER_LOAD_TASK), [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i != range.end(); ++i) {
+            const QByteArray& record = records[i].second;
+            LoadedEntity& loadedEntity = loadedEntities[i];
+            loadedEntity.entityItemID = records[i].first;
+            int processedBytes = 0;
+            loadedEntity.decoded = EntityItemProperties::decodeEntityEditPacket(
+                reinterpret_cast<const unsigned char*>(record.constData()), record.size(), processedBytes,
+                loadedEntity.entityItemID, loadedEntity.properties);
+        }
+    });
+    for (const auto& loadedEntity : loadedEntities) {
+        if (!loadedEntity.decoded) {
+            qCDebug(entities) << "decoding Entity failed:" << loadedEntity.entityItemID;
+        }
+    }
+    loadStats.decodeTime = usecTimestampNow() - startDecode;
+
+    return addLoadedEntities(loadedEntities, loadStats);
+}
+
+void EntityTree::setWantJournal(bool wantJournal) {
+    QWriteLocker locker(&_journalLock);
+    _wantJournal = wantJournal;
+    if (!wantJournal) {
+        _journalUpdatedEntities.clear();
+        _journalErasedEntities.clear();
+    }
+}
+
+void EntityTree::journalEntityUpdated(const EntityItemID& entityID) {
+    QWriteLocker locker(&_journalLock);
+    if (_wantJournal) {
+        _journalErasedEntities.remove(entityID);
+        _journalUpdatedEntities.insert(entityID);
+    }
+}
+
+void EntityTree::journalEntityErased(const EntityItemID& entityID) {
+    QWriteLocker locker(&_journalLock);
+    if (_wantJournal) {
+        _journalUpdatedEntities.remove(entityID);
+        _journalErasedEntities.insert(entityID);
+    }
+}
+
+bool EntityTree::writeToJournal(OctreeJournal& journal) {
+    QSet<EntityItemID> updatedEntities;
+    QSet<EntityItemID> erasedEntities;
+    QByteArray record;
+    bool success = true;
+    withReadLock([&] {
+        {
+            QWriteLocker locker(&_journalLock);
+            updatedEntities.swap(_journalUpdatedEntities);
+            erasedEntities.swap(_journalErasedEntities);
+        }
+
+        // an entity edited several times since the last write is only encoded once, in its current state
+        for (const auto& entityID : erasedEntities) {
+            success = success && journal.append(OctreeJournal::Erase, entityID);
+        }
+        for (const auto& entityID : updatedEntities) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (!entity || !entity->isParentIDValid() || !encodeSnapshotRecord(entity, record)) {
+                continue;
+            }
+            success = success && journal.append(OctreeJournal::Update, entityID, record);
+        }
+    });
+    return success && journal.flush();
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
@@ -12,14 +12,21 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+#include <mutex>
+
 #include <QSet>
 #include <QVector>
 
+#include <NumericalConstants.h>
 #include <Octree.h>
 #include <SpatialParentFinder.h>
+#include <UuidHashMap.h>
 
 #include "AddEntityOperator.h"
+#include "EntitySpatialIndex.h"
 #include "EntityTreeElement.h"
+#include "EntityTreeSnapshot.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
 
@@ -74,6 +81,14 @@ public:
         return std::static_pointer_cast<EntityTreeElement>(_rootElement);
     }
 
+    /// Read-only copy of the tree, for traversing it without the tree lock. The copy is shared by all its callers and
+    /// lags the tree by up to SNAPSHOT_MAX_AGE: once it is that old, the next caller rebuilds it if the tree changed.
+    static const uint64_t SNAPSHOT_MAX_AGE = 50 * USECS_PER_MSEC;
+    EntityTreeSnapshotPointer getSnapshot();
+
+    /// Index of the elements' cubes behind the evalEntitiesIn*() queries, kept up to date by EntityTreeElement
+    EntitySpatialIndex& getSpatialIndex() { return _spatialIndex; }
+
 
     virtual void eraseDomainAndNonOwnedEntities() override;
     virtual void eraseAllOctreeElements(bool createNewRoot = true) override;
@@ -89,6 +104,11 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool handlesBatchedEdits() const override { return getIsServer(); }
+    virtual OctreeEditPointer decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& senderNode, int& bytesRead) override;
+    virtual int prepareEdits(OctreeEdits& edits) override;
+    virtual void applyEdits(OctreeEdits& edits) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -195,6 +215,12 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToSnapshotFile(const QString& fileName, const OctreeElementPointer& element) override;
+    virtual bool readFromSnapshotFile(const QString& fileName, const QString& journalFileName = QString()) override;
+    virtual void setWantJournal(bool wantJournal) override;
+    virtual bool writeToJournal(OctreeJournal& journal) override;
+    // records an entity changed on the server, outside of an edit, for the next journal write
+    void journalEntityUpdated(const EntityItemID& entityID);
 
 
     glm::vec3 getContentsDimensions();
@@ -324,7 +350,8 @@ protected:
     }
 
     mutable QReadWriteLock _entityMapLock;
-    QHash<EntityItemID, EntityItemPointer> _entityMap;
+    UuidHashMap<EntityItemPointer> _entityMap;
+    EntitySpatialIndex _spatialIndex;
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
@@ -368,9 +395,24 @@ protected:
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
     bool filterProperties(EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType);
+
+    // the stages of an edit: decoding and filtering don't need the tree lock, applying it does
+    class EntityEdit;
+    int decodeEdit(EntityEdit& edit, const unsigned char* editData, int maxLength);
+    void filterEdit(EntityEdit& edit);
+    void applyEdit(EntityEdit& edit);
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceWhitelist;
 
+    // the stages of a load: the entities are decoded over threads, then added in one pass - see readFromMap()
+    struct LoadedEntity {
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        bool decoded { false };
+    };
+    void decodeLoadedEntity(QVariantMap entityMap, int contentVersion, QScriptEngine& scriptEngine, LoadedEntity& loadedEntity);
+    bool addLoadedEntities(std::vector<LoadedEntity>& loadedEntities, LoadStats& loadStats);
+
     MovingEntitiesOperator _entityMover;
     QHash<EntityItemID, EntityItemPointer> _entitiesToAdd;
 
@@ -397,6 +439,17 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    std::mutex _snapshotMutex; // held while building a snapshot
+    EntityTreeSnapshotPointer _snapshot; // only accessed with std::atomic_load and std::atomic_store
+    std::atomic<uint64_t> _snapshotCheckTime { 0 };
+
+    // entities changed since the last snapshot or journal write, an entity is in at most one of the sets
+    void journalEntityErased(const EntityItemID& entityID);
+    QReadWriteLock _journalLock;
+    bool _wantJournal { false };
+    QSet<EntityItemID> _journalUpdatedEntities;
+    QSet<EntityItemID> _journalErasedEntities;
+
     void updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                        MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
 };
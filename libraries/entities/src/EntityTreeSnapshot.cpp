@@ -0,0 +1,47 @@
+//
+//  EntityTreeSnapshot.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshot.h"
+
+#include <SharedUtil.h>
+
+EntityTreeSnapshotPointer EntityTreeSnapshot::build(const EntityTreeElementPointer& root) {
+    auto snapshot = std::make_shared<EntityTreeSnapshot>();
+
+    // nothing changes while the tree is locked, so the timestamp may as well be taken first
+    snapshot->_timestamp = usecTimestampNow();
+    snapshot->addElement(root);
+    return snapshot;
+}
+
+int EntityTreeSnapshot::addElement(const EntityTreeElementPointer& element) {
+    int index = (int)_elements.size();
+    _elements.emplace_back();
+    {
+        Element& copy = _elements.back();
+        copy.cube = element->getAACube();
+        copy.lastChanged = element->getLastChanged();
+        copy.lastChangedContent = element->getLastChangedContent();
+        copy.firstEntity = (uint32_t)_entities.size();
+    }
+
+    element->forEachEntity([&](EntityItemPointer entity) {
+        _entities.push_back(entity);
+    });
+    _elements[index].numEntities = (uint32_t)_entities.size() - _elements[index].firstEntity;
+
+    // adding the children moves _elements around, only index it
+    for (int i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+        EntityTreeElementPointer child = element->getChildAtIndex(i);
+        int32_t childIndex = child ? addElement(child) : -1;
+        _elements[index].children[i] = childIndex;
+    }
+    return index;
+}
@@ -0,0 +1,80 @@
+//
+//  EntityTreeSnapshot.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeSnapshot_h
+#define hifi_EntityTreeSnapshot_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <AACube.h>
+
+#include "EntityTreeElement.h"
+
+class EntityTreeSnapshot;
+using EntityTreeSnapshotPointer = std::shared_ptr<const EntityTreeSnapshot>;
+
+/// Read-only copy of the structure of an EntityTree: the cubes and change times of its elements, and the entities
+/// in them. It is built under the tree's read lock and never changes afterwards, so the entity server's send threads
+/// can traverse it without holding the tree lock, and keep traversing it while edits go into the tree.
+///
+/// A snapshot holds on to its entities, but skips the ones deleted since it was built.
+class EntityTreeSnapshot {
+public:
+    struct Element {
+        AACube cube;
+        uint64_t lastChanged;
+        uint64_t lastChangedContent;
+        int32_t children[NUMBER_OF_CHILDREN]; // indices of the children, -1 for none
+        uint32_t firstEntity;
+        uint32_t numEntities;
+
+        bool hasContent() const { return numEntities > 0; }
+    };
+
+    /// Call with the tree read-locked
+    static EntityTreeSnapshotPointer build(const EntityTreeElementPointer& root);
+
+    /// Time the snapshot was built at - everything changed later has a later change time
+    uint64_t getTimestamp() const { return _timestamp; }
+
+    const Element& getRoot() const { return _elements[0]; }
+    const Element* getChild(const Element& element, int childIndex) const;
+
+    int getNumElements() const { return (int)_elements.size(); }
+    int getNumEntities() const { return (int)_entities.size(); }
+
+    template <typename F>
+    void forEachEntity(const Element& element, F f) const;
+
+private:
+    int addElement(const EntityTreeElementPointer& element);
+
+    uint64_t _timestamp { 0 };
+    std::vector<Element> _elements; // depth first, the root first
+    std::vector<EntityItemPointer> _entities;
+};
+
+inline const EntityTreeSnapshot::Element* EntityTreeSnapshot::getChild(const Element& element, int childIndex) const {
+    int32_t child = element.children[childIndex];
+    return child != -1 ? &_elements[child] : nullptr;
+}
+
+template <typename F>
+void EntityTreeSnapshot::forEachEntity(const Element& element, F f) const {
+    for (uint32_t i = element.firstEntity; i < element.firstEntity + element.numEntities; ++i) {
+        if (!_entities[i]->isDead()) {
+            f(_entities[i]);
+        }
+    }
+}
+
+#endif // hifi_EntityTreeSnapshot_h
@@ -65,16 +65,17 @@ bool EntityTypes::typeIsValid(EntityType type) {
 }
 
 const QString& EntityTypes::getEntityTypeName(EntityType entityType) {
-    QMap<EntityType, QString>::iterator matchedTypeName = _typeToNameMap.find(entityType);
-    if (matchedTypeName != _typeToNameMap.end()) {
+    auto matchedTypeName = _typeToNameMap.constFind(entityType);
+    if (matchedTypeName != _typeToNameMap.cend()) {
         return matchedTypeName.value();
     }
     return ENTITY_TYPE_NAME_UNKNOWN;
 }
 
 EntityTypes::EntityType EntityTypes::getEntityTypeFromName(const QString& name) {
-    QMap<QString, EntityTypes::EntityType>::iterator matchedTypeName = _nameToTypeMap.find(name);
-    if (matchedTypeName != _nameToTypeMap.end()) {
+    // const lookup, this is called from several threads at once when a domain is loaded
+    auto matchedTypeName = _nameToTypeMap.constFind(name);
+    if (matchedTypeName != _nameToTypeMap.cend()) {
         return matchedTypeName.value();
     }
     if (name.size() > 0 && name[0].isLower()) {
@@ -15,26 +15,24 @@
 #include "EntityItemProperties.h"
 #include "EntityItemPropertiesMacros.h"
 
-QHash<QString, PulseMode> stringToPulseModeLookup;
-
-void addPulseMode(PulseMode mode) {
-    stringToPulseModeLookup[PulseModeHelpers::getNameForPulseMode(mode)] = mode;
+inline void addPulseMode(QHash<QString, PulseMode>& lookup, PulseMode mode) {
+    lookup[PulseModeHelpers::getNameForPulseMode(mode)] = mode;
 }
 
-void buildStringToPulseModeLookup() {
-    addPulseMode(PulseMode::NONE);
-    addPulseMode(PulseMode::IN_PHASE);
-    addPulseMode(PulseMode::OUT_PHASE);
-}
+// built up front, entities are read from script values on several threads at once
+const QHash<QString, PulseMode> stringToPulseModeLookup = [] {
+    QHash<QString, PulseMode> toReturn;
+    addPulseMode(toReturn, PulseMode::NONE);
+    addPulseMode(toReturn, PulseMode::IN_PHASE);
+    addPulseMode(toReturn, PulseMode::OUT_PHASE);
+    return toReturn;
+}();
 
 QString PulsePropertyGroup::getColorModeAsString() const {
     return PulseModeHelpers::getNameForPulseMode(_colorMode);
 }
 
 void PulsePropertyGroup::setColorModeFromString(const QString& pulseMode) {
-    if (stringToPulseModeLookup.empty()) {
-        buildStringToPulseModeLookup();
-    }
     auto pulseModeItr = stringToPulseModeLookup.find(pulseMode.toLower());
     if (pulseModeItr != stringToPulseModeLookup.end()) {
         _colorMode = pulseModeItr.value();
@@ -47,9 +45,6 @@ QString PulsePropertyGroup::getAlphaModeAsString() const {
 }
 
 void PulsePropertyGroup::setAlphaModeFromString(const QString& pulseMode) {
-    if (stringToPulseModeLookup.empty()) {
-        buildStringToPulseModeLookup();
-    }
     auto pulseModeItr = stringToPulseModeLookup.find(pulseMode.toLower());
     if (pulseModeItr != stringToPulseModeLookup.end()) {
         _alphaMode = pulseModeItr.value();
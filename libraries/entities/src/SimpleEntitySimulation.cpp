@@ -37,6 +37,7 @@ void SimpleEntitySimulation::clearOwnership(const QUuid& ownerID) {
             // remove ownership and dirty all the tree elements that contain the it
             entity->clearSimulationOwnership();
             entity->markAsChangedOnServer();
+            getEntityTree()->journalEntityUpdated(entity->getEntityItemID());
             if (auto element = entity->getElement()) {
                 DirtyOctreeElementOperator op(element);
                 getEntityTree()->recurseTreeWithOperator(&op);
@@ -170,6 +171,7 @@ void SimpleEntitySimulation::expireStaleOwnerships(uint64_t now) {
                 // remove ownership and dirty all the tree elements that contain the it
                 entity->clearSimulationOwnership();
                 entity->markAsChangedOnServer();
+                getEntityTree()->journalEntityUpdated(entity->getEntityItemID());
                 DirtyOctreeElementOperator op(entity->getElement());
                 getEntityTree()->recurseTreeWithOperator(&op);
             } else {
@@ -201,6 +203,7 @@ void SimpleEntitySimulation::stopOwnerlessEntities(uint64_t now) {
 
                     // dirty all the tree elements that contain it
                     entity->markAsChangedOnServer();
+                    getEntityTree()->journalEntityUpdated(entity->getEntityItemID());
                     DirtyOctreeElementOperator op(entity->getElement());
                     getEntityTree()->recurseTreeWithOperator(&op);
                 }
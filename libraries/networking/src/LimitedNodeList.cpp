@@ -18,6 +18,7 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
 #include <QtNetwork/QTcpSocket>
@@ -55,6 +56,36 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
 {
     qRegisterMetaType<ConnectionStep>("ConnectionStep");
     auto port = (socketListenPort != INVALID_PORT) ? socketListenPort : LIMITED_NODELIST_LOCAL_PORT.get();
+
+    // the receive threads verify and handle packets as soon as the socket is bound, so everything they call is set first
+
+    // set &PacketReceiver::handleVerifiedPacket as the verified packet callback for the udt::Socket
+    _nodeSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            _packetReceiver->handleVerifiedPacket(std::move(packet));
+    });
+    _nodeSocket.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+            _packetReceiver->handleVerifiedMessagePacket(std::move(packet));
+    });
+    _nodeSocket.setMessageFailureHandler([this](HifiSockAddr from,
+                                                udt::Packet::MessageNumber messageNumber) {
+            _packetReceiver->handleMessageFailure(from, messageNumber);
+    });
+
+    // set our isPacketVerified method as the verify operator for the udt::Socket
+    using std::placeholders::_1;
+    _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+
+    // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
+    _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
+
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains("HIFI_UDP_RECEIVE_THREADS")) {
+        // spread receiving and verifying packets across several sockets sharing our port
+        int numReceiveThreads = environment.value("HIFI_UDP_RECEIVE_THREADS").toInt();
+        qCDebug(networking) << "NodeList socket will receive on" << numReceiveThreads << "threads";
+        _nodeSocket.setNumReceiveThreads(numReceiveThreads);
+    }
+
     _nodeSocket.bind(QHostAddress::AnyIPv4, port);
     quint16 assignedPort = _nodeSocket.localPort();
     if (socketListenPort != INVALID_PORT && socketListenPort != 0 && socketListenPort != assignedPort) {
@@ -62,6 +93,11 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     }
     qCDebug(networking) << "NodeList socket is listening on" << assignedPort;
 
+    if (environment.contains("HIFI_BATCHED_UDP_RECEIVE")) {
+        qCDebug(networking) << "NodeList socket will drain datagrams in batches";
+        _nodeSocket.setBatchedReceiveEnabled(true);
+    }
+
     if (dtlsListenPort != INVALID_PORT) {
         // only create the DTLS socket during constructor if a custom port is passed
         _dtlsSocket = new QUdpSocket(this);
@@ -96,25 +132,6 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // check the local socket right now
     updateLocalSocket();
 
-    // set &PacketReceiver::handleVerifiedPacket as the verified packet callback for the udt::Socket
-    _nodeSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
-            _packetReceiver->handleVerifiedPacket(std::move(packet));
-    });
-    _nodeSocket.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
-            _packetReceiver->handleVerifiedMessagePacket(std::move(packet));
-    });
-    _nodeSocket.setMessageFailureHandler([this](HifiSockAddr from,
-                                                udt::Packet::MessageNumber messageNumber) {
-            _packetReceiver->handleMessageFailure(from, messageNumber);
-    });
-
-    // set our isPacketVerified method as the verify operator for the udt::Socket
-    using std::placeholders::_1;
-    _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
-
-    // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
-    _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
-
     // handle when a socket connection has its receiver side reset - might need to emit clientConnectionToNodeReset
     connect(&_nodeSocket, &udt::Socket::clientHandshakeRequestComplete, this, &LimitedNodeList::clientConnectionToSockAddrReset);
 
@@ -243,6 +260,8 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
 
     if (headerVersion != versionForPacketType(headerType)) {
 
+        // packets can be verified on the socket's receive threads, so the suppress maps need a lock
+        static QMutex versionDebugSuppressMutex;
         static QMultiHash<QUuid, PacketType> sourcedVersionDebugSuppressMap;
         static QMultiHash<HifiSockAddr, PacketType> versionDebugSuppressMap;
 
@@ -252,6 +271,7 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
         QUuid sourceID;
 
         if (PacketTypeEnum::getNonSourcedPackets().contains(headerType)) {
+            QMutexLocker suppressLocker(&versionDebugSuppressMutex);
             hasBeenOutput = versionDebugSuppressMap.contains(senderSockAddr, headerType);
 
             if (!hasBeenOutput) {
@@ -263,6 +283,7 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
             if (sourceNode) {
                 sourceID = sourceNode->getUUID();
 
+                QMutexLocker suppressLocker(&versionDebugSuppressMutex);
                 hasBeenOutput = sourcedVersionDebugSuppressMap.contains(sourceID, headerType);
 
                 if (!hasBeenOutput) {
@@ -320,12 +341,14 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     } else {
         NLPacket::LocalID sourceLocalID = Node::NULL_LOCAL_ID;
 
-        // check if we were passed a sourceNode hint or if we need to look it up
+        // check if we were passed a sourceNode hint or if we need to look it up - the node we look up is held
+        // until we are done with it, it can be removed from the node hash on another thread meanwhile
+        SharedNodePointer matchingNode;
         if (!sourceNode) {
             // figure out which node this is from
             sourceLocalID = NLPacket::sourceIDInHeader(packet);
 
-            SharedNodePointer matchingNode = nodeWithLocalID(sourceLocalID);
+            matchingNode = nodeWithLocalID(sourceLocalID);
             sourceNode = matchingNode.data();
         }
 
@@ -356,8 +379,10 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 
                 // check if the HMAC-md5 hash in the header matches the hash we would expect
                 if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
+                    static QMutex hashDebugSuppressMutex;
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
+                    QMutexLocker suppressLocker(&hashDebugSuppressMutex);
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
                         qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceID;
                         qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
@@ -614,6 +639,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         handleNodeKill(killedNode);
     }
 
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsMutex);
     _delayedNodeAdds.clear();
 }
 
@@ -780,10 +806,12 @@ void LimitedNodeList::addNewNode(NewNodeInfo info) {
 }
 
 void LimitedNodeList::delayNodeAdd(NewNodeInfo info) {
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsMutex);
     _delayedNodeAdds.push_back(info);
 }
 
 void LimitedNodeList::removeDelayedAdd(QUuid nodeUUID) {
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsMutex);
     auto it = std::find_if(_delayedNodeAdds.begin(), _delayedNodeAdds.end(), [&](const auto& info) {
         return info.uuid == nodeUUID;
     });
@@ -793,6 +821,7 @@ void LimitedNodeList::removeDelayedAdd(QUuid nodeUUID) {
 }
 
 bool LimitedNodeList::isDelayedNode(QUuid nodeUUID) {
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsMutex);
     auto it = std::find_if(_delayedNodeAdds.begin(), _delayedNodeAdds.end(), [&](const auto& info) {
         return info.uuid == nodeUUID;
     });
@@ -802,14 +831,21 @@ bool LimitedNodeList::isDelayedNode(QUuid nodeUUID) {
 void LimitedNodeList::processDelayedAdds() {
     _nodesAddedInCurrentTimeSlice = 0;
 
-    auto nodesToAdd = glm::min(_delayedNodeAdds.size(), _maxConnectionRate);
-    auto firstNodeToAdd = _delayedNodeAdds.begin();
-    auto lastNodeToAdd = firstNodeToAdd + nodesToAdd;
+    // take the nodes to add out from under the lock - isDelayedNode is called while verifying packets
+    std::vector<NewNodeInfo> nodesToAdd;
+    {
+        QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsMutex);
+        auto numNodesToAdd = glm::min(_delayedNodeAdds.size(), _maxConnectionRate);
+        auto firstNodeToAdd = _delayedNodeAdds.begin();
+        auto lastNodeToAdd = firstNodeToAdd + numNodesToAdd;
+
+        nodesToAdd.assign(firstNodeToAdd, lastNodeToAdd);
+        _delayedNodeAdds.erase(firstNodeToAdd, lastNodeToAdd);
+    }
 
-    for (auto it = firstNodeToAdd; it != lastNodeToAdd; ++it) {
-        addNewNode(*it);
+    for (const auto& info : nodesToAdd) {
+        addNewNode(info);
     }
-    _delayedNodeAdds.erase(firstNodeToAdd, lastNodeToAdd);
 }
 
 std::unique_ptr<NLPacket> LimitedNodeList::constructPingPacket(const QUuid& nodeId, PingType_t pingType) {
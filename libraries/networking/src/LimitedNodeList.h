@@ -24,6 +24,7 @@
 #endif
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
 #include <QtCore/QPointer>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
@@ -164,6 +165,11 @@ public:
     qint64 sendPacketList(std::unique_ptr<NLPacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 sendPacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode);
 
+    // unreliable packets sent from the calling thread between beginSendBatch and flushSendBatch
+    // are held back and written to the socket together when the batch is flushed
+    void beginSendBatch() { _nodeSocket.beginSendBatch(); }
+    qint64 flushSendBatch() { return _nodeSocket.flushSendBatch(); }
+
     std::function<void(Node*)> linkedDataCreateCallback;
 
     size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
@@ -491,6 +497,7 @@ private:
 
     size_t _maxConnectionRate { DEFAULT_MAX_CONNECTION_RATE };
     size_t _nodesAddedInCurrentTimeSlice { 0 };
+    QMutex _delayedNodeAddsMutex;
     std::vector<NewNodeInfo> _delayedNodeAdds;
 
     int _inboundPPS { 0 };
@@ -32,17 +32,27 @@ MessagesClient::MessagesClient() {
     connect(nodeList.data(), &LimitedNodeList::nodeActivated, this, &MessagesClient::handleNodeActivated);
 }
 
-void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
+bool MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                                 bool& isText, QString& message, QByteArray& data, QUuid& senderID) {
     quint16 channelLength;
+    if (receivedMessage->getBytesLeftToRead() < (qint64)sizeof(channelLength)) {
+        return false;
+    }
     receivedMessage->readPrimitive(&channelLength);
+
+    quint32 messageLength;
+    if (receivedMessage->getBytesLeftToRead() < (qint64)(channelLength + sizeof(isText) + sizeof(messageLength))) {
+        return false;
+    }
     auto channelData = receivedMessage->read(channelLength);
     channel = QString::fromUtf8(channelData);
 
     receivedMessage->readPrimitive(&isText);
 
-    quint32 messageLength;
     receivedMessage->readPrimitive(&messageLength);
+    if (receivedMessage->getBytesLeftToRead() < (qint64)messageLength) {
+        return false;
+    }
     auto messageData = receivedMessage->read(messageLength);
     if (isText) {
         message = QString::fromUtf8(messageData);
@@ -57,6 +67,7 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
         QUuid emptyUUID;
         senderID = emptyUUID; // packet was missing UUID use default instead
     }
+    return true;
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
@@ -106,12 +117,19 @@ void MessagesClient::handleMessagesPacket(QSharedPointer<ReceivedMessage> receiv
     QByteArray data;
     bool isText { false };
     QUuid senderID;
-    decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-    if (isText) {
-        emit messageReceived(channel, message, senderID, false);
-    } else {
-        emit dataReceived(channel, data, senderID, false);
-    }
+
+    // the messages mixer sends the messages it has for a node together, a message that runs past the end is dropped
+    do {
+        if (!decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID)) {
+            qCWarning(messages_client) << "Dropping a malformed message from" << senderNode->getUUID();
+            break;
+        }
+        if (isText) {
+            emit messageReceived(channel, message, senderID, false);
+        } else {
+            emit dataReceived(channel, data, senderID, false);
+        }
+    } while (receivedMessage->getBytesLeftToRead() > 0);
 }
 
 void MessagesClient::sendMessage(QString channel, QString message, bool localOnly) {
@@ -161,7 +161,8 @@ public:
      */
     Q_INVOKABLE void unsubscribe(QString channel);
 
-    static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
+    // false, without a message, if the lengths the message declares run past the end of the packet
+    static bool decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
 
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
@@ -0,0 +1,83 @@
+//
+//  MessagesPacer.cpp
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MessagesPacer.h"
+
+#include <algorithm>
+#include <climits>
+
+#include <NumericalConstants.h>
+
+// how much of a node's bandwidth can be sent at once, after it had nothing to send
+const float MAX_BURST_SECONDS = 0.1f;
+
+bool MessagesPacer::queueMessage(const QUuid& nodeID, const QByteArray& payload) {
+    const bool isLimited = _maxNodeKbps > 0.0f;
+    const float bytesPerSecond = _maxNodeKbps * BYTES_PER_KILOBIT;
+    const int maxHeldBytes = isLimited ? (int)bytesPerSecond : INT_MAX;
+
+    auto found = _destinations.find(nodeID);
+    if (found == _destinations.end()) {
+        found = _destinations.insert(nodeID, Destination());
+        found->budget = bytesPerSecond * MAX_BURST_SECONDS;
+    }
+    Destination& destination = found.value();
+    if (!destination.messages.isEmpty() && destination.numBytes + payload.size() > maxHeldBytes) {
+        return false;
+    }
+    destination.messages.enqueue(payload);
+    destination.numBytes += payload.size();
+    _numHeldBytes += payload.size();
+    return true;
+}
+
+MessagesPacer::Batches MessagesPacer::takeMessages(float elapsedSeconds) {
+    const bool isLimited = _maxNodeKbps > 0.0f;
+    const float bytesPerSecond = _maxNodeKbps * BYTES_PER_KILOBIT;
+    const float maxBudget = bytesPerSecond * MAX_BURST_SECONDS;
+
+    Batches batches;
+    int numHeldBytes = 0;
+    for (auto it = _destinations.begin(); it != _destinations.end();) {
+        Destination& destination = it.value();
+        destination.budget = std::min(destination.budget + elapsedSeconds * bytesPerSecond, maxBudget);
+
+        // the last message can take the budget below zero, it is paid back before the next is sent
+        if (!destination.messages.isEmpty() && (!isLimited || destination.budget > 0.0f)) {
+            QVector<QByteArray>& batch = batches[it.key()];
+            while (!destination.messages.isEmpty() && (!isLimited || destination.budget > 0.0f)) {
+                QByteArray payload = destination.messages.dequeue();
+                destination.numBytes -= payload.size();
+                destination.budget -= payload.size();
+                batch.push_back(payload);
+            }
+        }
+
+        if (destination.messages.isEmpty() && (!isLimited || destination.budget >= maxBudget)) {
+            it = _destinations.erase(it);
+        } else {
+            numHeldBytes += destination.numBytes;
+            ++it;
+        }
+    }
+    _numHeldBytes = numHeldBytes;
+    return batches;
+}
+
+int MessagesPacer::removeNode(const QUuid& nodeID) {
+    auto found = _destinations.find(nodeID);
+    if (found == _destinations.end()) {
+        return 0;
+    }
+    int numMessages = found->messages.size();
+    _numHeldBytes -= found->numBytes;
+    _destinations.erase(found);
+    return numMessages;
+}
@@ -0,0 +1,56 @@
+//
+//  MessagesPacer.h
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MessagesPacer_h
+#define hifi_MessagesPacer_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QQueue>
+#include <QtCore/QUuid>
+#include <QtCore/QVector>
+
+/// The messages waiting to be sent to each node, no faster than the node's bandwidth allows. A node can be sent a
+/// tenth of a second's worth at once, after it had nothing to send; the rest are held, up to a second's worth, and past
+/// that dropped.
+class MessagesPacer {
+public:
+    using Batches = QHash<QUuid, QVector<QByteArray>>;
+
+    void setMaxNodeBandwidth(float kbps) { _maxNodeKbps = kbps; } // unlimited when zero
+
+    /// Holds a message for the node, false if it is dropped instead. A message too large for the held bytes still goes
+    /// out, on its own.
+    bool queueMessage(const QUuid& nodeID, const QByteArray& payload);
+
+    /// The messages to send to each node now, in the order they were queued, after the time since the last call.
+    Batches takeMessages(float elapsedSeconds);
+
+    /// Drops the messages held for the node, returns how many.
+    int removeNode(const QUuid& nodeID);
+
+    /// Whether the node has messages held, or a budget still refilling from its last messages.
+    bool hasNode(const QUuid& nodeID) const { return _destinations.contains(nodeID); }
+
+    int getNumHeldBytes() const { return _numHeldBytes; }
+
+private:
+    struct Destination {
+        QQueue<QByteArray> messages; // held until the node's bandwidth allows them
+        int numBytes { 0 };
+        float budget { 0.0f }; // bytes the node's bandwidth allows now
+    };
+
+    QHash<QUuid, Destination> _destinations;
+    float _maxNodeKbps { 0.0f };
+    int _numHeldBytes { 0 };
+};
+
+#endif // hifi_MessagesPacer_h
@@ -48,6 +48,7 @@ public:
     virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {}
 
     virtual int estimatedTimeout() const = 0;
+    virtual int estimatedRTT() const { return 0; } // in microseconds, zero until measured
 
 protected:
     void setMSS(int mss) { _mss = mss; }
@@ -443,6 +443,7 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+    _stats.recordRTT(_congestionControl->estimatedRTT());
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
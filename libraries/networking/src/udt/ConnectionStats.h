@@ -93,6 +93,7 @@ public:
 
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+    void recordRTT(int sample);
     
 private:
     Stats _currentSample;
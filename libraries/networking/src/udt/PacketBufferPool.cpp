@@ -0,0 +1,68 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+using namespace udt;
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (_pool) {
+        _pool->release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+std::shared_ptr<PacketBufferPool> PacketBufferPool::create(size_t maxFreeSlabs) {
+    return std::shared_ptr<PacketBufferPool>(new PacketBufferPool(maxFreeSlabs));
+}
+
+PacketBufferPool::~PacketBufferPool() {
+    for (auto slab : _freeSlabs) {
+        delete[] slab;
+    }
+}
+
+PacketBuffer PacketBufferPool::acquire() {
+    char* slab = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_freeSlabs.empty()) {
+            slab = _freeSlabs.back();
+            _freeSlabs.pop_back();
+        }
+    }
+
+    if (!slab) {
+        slab = new char[SLAB_SIZE];
+        ++_numAllocatedSlabs;
+    }
+
+    return PacketBuffer(slab, PacketBufferDeleter(shared_from_this()));
+}
+
+size_t PacketBufferPool::getNumFreeSlabs() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _freeSlabs.size();
+}
+
+void PacketBufferPool::release(char* slab) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_freeSlabs.size() < _maxFreeSlabs) {
+            _freeSlabs.push_back(slab);
+            return;
+        }
+    }
+
+    // we're already holding on to as many free slabs as we want to keep, give this one back to the heap
+    --_numAllocatedSlabs;
+    delete[] slab;
+}
@@ -0,0 +1,74 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+
+namespace udt {
+
+class PacketBufferPool;
+
+// Deleter for packet buffers - slabs that came from a PacketBufferPool are handed back to it,
+// everything else (buffers allocated with new char[]) is simply deleted
+class PacketBufferDeleter {
+public:
+    PacketBufferDeleter() = default;
+    PacketBufferDeleter(std::default_delete<char[]>) {}
+    explicit PacketBufferDeleter(std::shared_ptr<PacketBufferPool> pool) : _pool(std::move(pool)) {}
+
+    void operator()(char* buffer) const;
+
+private:
+    std::shared_ptr<PacketBufferPool> _pool;
+};
+
+// std::unique_ptr<char[]> converts implicitly to a PacketBuffer, so heap allocated buffers can still be used
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+// Thread-safe pool of MTU sized slabs used to receive datagrams without a heap allocation per packet.
+// Packets holding a slab keep the pool alive, so they are free to outlive the Socket that read them.
+class PacketBufferPool : public std::enable_shared_from_this<PacketBufferPool> {
+public:
+    static const int SLAB_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER;
+    static const size_t DEFAULT_MAX_FREE_SLABS = 4096;
+
+    static std::shared_ptr<PacketBufferPool> create(size_t maxFreeSlabs = DEFAULT_MAX_FREE_SLABS);
+    ~PacketBufferPool();
+
+    PacketBuffer acquire();
+
+    size_t getNumFreeSlabs() const;
+    size_t getNumAllocatedSlabs() const { return _numAllocatedSlabs; }
+
+private:
+    PacketBufferPool(size_t maxFreeSlabs) : _maxFreeSlabs(maxFreeSlabs) {}
+
+    void release(char* slab);
+
+    mutable std::mutex _mutex;
+    std::vector<char*> _freeSlabs;
+    size_t _maxFreeSlabs;
+    std::atomic<size_t> _numAllocatedSlabs { 0 };
+
+    friend class PacketBufferDeleter;
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
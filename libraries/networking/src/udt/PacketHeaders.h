@@ -340,7 +340,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    JointDeltas
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -389,7 +390,8 @@ enum class AudioVersion : PacketVersion {
 };
 
 enum class MessageDataVersion : PacketVersion {
-    TextOrBinaryData = 18
+    TextOrBinaryData = 18,
+    Coalesced
 };
 
 enum class IcePingVersion : PacketVersion {
@@ -402,7 +404,8 @@ enum class PingVersion : PacketVersion {
 
 enum class AvatarQueryVersion : PacketVersion {
     SendMultipleFrustums = 21,
-    ConicalFrustums = 22
+    ConicalFrustums = 22,
+    JointKeyframeRequests = 23
 };
 
 #endif // hifi_PacketHeaders_h
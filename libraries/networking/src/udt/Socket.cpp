@@ -11,10 +11,24 @@
 
 #include "Socket.h"
 
-#ifdef Q_OS_ANDROID
+#include <algorithm>
+#include <iterator>
+
+#if defined(Q_OS_ANDROID) || defined(Q_OS_LINUX)
 #include <sys/socket.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <netinet/udp.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
+
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -38,6 +52,82 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+struct Socket::SendBatch {
+    struct Datagram {
+        int offset;
+        int size;
+        HifiSockAddr destination;
+    };
+
+    Socket* socket { nullptr };
+    std::vector<char> data;
+    std::vector<Datagram> datagrams;
+
+    void append(const char* datagram, int size, const HifiSockAddr& destination) {
+        // datagrams are packed back to back so runs to the same destination can go out as a single GSO send
+        datagrams.push_back({ (int)data.size(), size, destination });
+        data.insert(data.end(), datagram, datagram + size);
+    }
+
+    void clear() {
+        data.clear();
+        datagrams.clear();
+    }
+};
+
+struct Socket::ReceiveShard {
+    int socketDescriptor { -1 };
+    std::atomic<bool> stopping { false };
+    std::thread thread;
+};
+
+#if defined(Q_OS_LINUX)
+
+// binds a UDP socket that shares its port with every other socket this process binds to it with SO_REUSEPORT
+static int bindReusePortSocket(const QHostAddress& address, quint16 port, bool blocking) {
+    int sd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | (blocking ? 0 : SOCK_NONBLOCK), 0);
+    if (sd < 0) {
+        qCWarning(networking) << "udt::Socket could not create a socket to bind with SO_REUSEPORT -" << errno;
+        return -1;
+    }
+
+    sockaddr_in bindAddress;
+    memset(&bindAddress, 0, sizeof(sockaddr_in));
+    bindAddress.sin_family = AF_INET;
+    bindAddress.sin_port = htons(port);
+    bindAddress.sin_addr.s_addr = htonl(address.toIPv4Address());
+
+    int enable = 1;
+    if (setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0
+        || ::bind(sd, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(sockaddr_in)) != 0) {
+        qCWarning(networking) << "udt::Socket could not bind to port" << port << "with SO_REUSEPORT -" << errno;
+        ::close(sd);
+        return -1;
+    }
+
+    return sd;
+}
+
+// sets up the message headers for a recvmmsg call, slots that handed their slab off to a packet get a fresh one
+static void prepareReceiveMessages(PacketBufferPool& pool, PacketBuffer* buffers, iovec* iovecs,
+                                   sockaddr_storage* senderAddresses, mmsghdr* messages, int numMessages) {
+    for (int i = 0; i < numMessages; ++i) {
+        if (!buffers[i]) {
+            buffers[i] = pool.acquire();
+        }
+
+        iovecs[i].iov_base = buffers[i].get();
+        iovecs[i].iov_len = PacketBufferPool::SLAB_SIZE;
+
+        memset(&messages[i], 0, sizeof(mmsghdr));
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_name = &senderAddresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+}
+
+#endif
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -58,9 +148,29 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
 }
 
+Socket::~Socket() {
+    stopReceiveShards();
+}
+
 void Socket::bind(const QHostAddress& address, quint16 port) {
 
+#if defined(Q_OS_LINUX)
+    int reusePortSocket = -1;
+    if (_numReceiveThreads > 1) {
+        // the main socket needs SO_REUSEPORT as well, otherwise the receive shards can't share its port
+        reusePortSocket = bindReusePortSocket(address, port, false);
+        if (reusePortSocket >= 0 && !_udpSocket.setSocketDescriptor(reusePortSocket, QAbstractSocket::BoundState)) {
+            ::close(reusePortSocket);
+            reusePortSocket = -1;
+        }
+    }
+
+    if (reusePortSocket < 0) {
+        _udpSocket.bind(address, port);
+    }
+#else
     _udpSocket.bind(address, port);
+#endif
 
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes();
@@ -69,6 +179,12 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
         auto sd = _udpSocket.socketDescriptor();
         int val = IP_PMTUDISC_DONT;
         setsockopt(sd, IPPROTO_IP, IP_MTU_DISCOVER, &val, sizeof(val));
+
+        // kernels that know about UDP_SEGMENT let us hand a run of datagrams to the stack as one send
+        int gsoSize = 0;
+        socklen_t gsoSizeLength = sizeof(gsoSize);
+        _gsoSupported = getsockopt(sd, SOL_UDP, UDP_SEGMENT, &gsoSize, &gsoSizeLength) == 0;
+        qCDebug(networking) << "UDP GSO is" << (_gsoSupported ? "supported" : "not supported") << "on this socket";
 #elif defined(Q_OS_WIN)
         auto sd = _udpSocket.socketDescriptor();
         int val = 0; // false
@@ -78,6 +194,12 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
         }
 #endif
     }
+
+#if defined(Q_OS_LINUX)
+    if (reusePortSocket >= 0) {
+        startReceiveShards(address);
+    }
+#endif
 }
 
 void Socket::rebind() {
@@ -85,6 +207,7 @@ void Socket::rebind() {
 }
 
 void Socket::rebind(quint16 localPort) {
+    stopReceiveShards();
     _udpSocket.abort();
     bind(QHostAddress::AnyIPv4, localPort);
 }
@@ -138,8 +261,9 @@ qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
 
     SequenceNumber sequenceNumber;
     {
-        Lock lock(_unreliableSequenceNumbersMutex);
-        sequenceNumber = ++_unreliableSequenceNumbers[sockAddr];
+        auto& shard = addressShardFor(sockAddr);
+        Lock lock(shard.mutex);
+        sequenceNumber = ++shard.unreliableSequenceNumbers[sockAddr];
     }
 
     auto connection = findOrCreateConnection(sockAddr, true);
@@ -236,6 +360,13 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const HifiSockAddr&
 
 qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
 
+    auto& sendBatch = getThreadSendBatch();
+    if (sendBatch.socket == this) {
+        // this thread is batching its sends - hold on to the datagram until flushSendBatch
+        sendBatch.append(datagram.constData(), datagram.size(), sockAddr);
+        return datagram.size();
+    }
+
     // don't attempt to write the datagram if we're unbound.  Just drop it.
     // _udpSocket.writeDatagram will return an error anyway, but there are
     // potential crashes in Qt when that happens.
@@ -270,11 +401,186 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+Socket::SendBatch& Socket::getThreadSendBatch() {
+    // every thread collects its own batch, so mixer slaves can batch their sends independently of each other
+    static thread_local SendBatch sendBatch;
+    return sendBatch;
+}
+
+void Socket::beginSendBatch() {
+#if defined(Q_OS_LINUX)
+    auto& sendBatch = getThreadSendBatch();
+    Q_ASSERT_X(!sendBatch.socket || sendBatch.socket == this, "Socket::beginSendBatch",
+               "Cannot batch sends to more than one socket from the same thread");
+    sendBatch.socket = this;
+#endif
+}
+
+qint64 Socket::flushSendBatch() {
+    auto& sendBatch = getThreadSendBatch();
+    if (sendBatch.socket != this) {
+        return 0;
+    }
+
+    // stop batching first so that any fallback writes go straight to the socket
+    sendBatch.socket = nullptr;
+
+    qint64 bytesWritten = 0;
+    if (!sendBatch.datagrams.empty()) {
+        bytesWritten = writeSendBatch(sendBatch);
+    }
+    sendBatch.clear();
+
+    return bytesWritten;
+}
+
+qint64 Socket::writeSendBatch(SendBatch& batch) {
+    qint64 bytesWritten = 0;
+
+#if defined(Q_OS_LINUX)
+    if (_udpSocket.state() != QAbstractSocket::BoundState) {
+        qCDebug(networking) << "Attempt to flush send batch when in unbound state - dropping"
+            << batch.datagrams.size() << "datagrams";
+        return -1;
+    }
+
+    static const int MAX_MESSAGES_PER_CALL = 64;
+    static const int MAX_GSO_SEGMENTS = 64;
+    static const int MAX_GSO_BYTES = 65000;
+
+    auto sd = _udpSocket.socketDescriptor();
+    bool useGSO = _gsoSupported;
+
+    mmsghdr messages[MAX_MESSAGES_PER_CALL];
+    iovec iovecs[MAX_MESSAGES_PER_CALL];
+    sockaddr_in addresses[MAX_MESSAGES_PER_CALL];
+    char controls[MAX_MESSAGES_PER_CALL][CMSG_SPACE(sizeof(uint16_t))];
+
+    // index of the first datagram in each message, so we can fall back to plain writes if sendmmsg gives up
+    size_t firstDatagrams[MAX_MESSAGES_PER_CALL + 1];
+
+    const size_t numDatagrams = batch.datagrams.size();
+    size_t nextDatagram = 0;
+
+    while (nextDatagram < numDatagrams) {
+        int numMessages = 0;
+
+        while (numMessages < MAX_MESSAGES_PER_CALL && nextDatagram < numDatagrams) {
+            const auto& first = batch.datagrams[nextDatagram];
+            size_t endDatagram = nextDatagram + 1;
+            int length = first.size;
+
+            if (useGSO) {
+                // coalesce a run of equally sized datagrams to the same destination into one GSO send,
+                // only the last segment of a run is allowed to be shorter
+                while (endDatagram < numDatagrams && (int)(endDatagram - nextDatagram) < MAX_GSO_SEGMENTS) {
+                    const auto& candidate = batch.datagrams[endDatagram];
+                    if (candidate.destination != first.destination || candidate.size > first.size
+                        || length + candidate.size > MAX_GSO_BYTES) {
+                        break;
+                    }
+
+                    length += candidate.size;
+                    ++endDatagram;
+
+                    if (candidate.size < first.size) {
+                        break;
+                    }
+                }
+            }
+
+            auto& message = messages[numMessages];
+            memset(&message, 0, sizeof(mmsghdr));
+
+            auto& address = addresses[numMessages];
+            memset(&address, 0, sizeof(sockaddr_in));
+            address.sin_family = AF_INET;
+            address.sin_port = htons(first.destination.getPort());
+            address.sin_addr.s_addr = htonl(first.destination.getAddress().toIPv4Address());
+
+            iovecs[numMessages].iov_base = batch.data.data() + first.offset;
+            iovecs[numMessages].iov_len = length;
+
+            message.msg_hdr.msg_name = &address;
+            message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            message.msg_hdr.msg_iov = &iovecs[numMessages];
+            message.msg_hdr.msg_iovlen = 1;
+
+            if (endDatagram - nextDatagram > 1) {
+                message.msg_hdr.msg_control = controls[numMessages];
+                message.msg_hdr.msg_controllen = sizeof(controls[numMessages]);
+
+                auto controlMessage = CMSG_FIRSTHDR(&message.msg_hdr);
+                controlMessage->cmsg_level = SOL_UDP;
+                controlMessage->cmsg_type = UDP_SEGMENT;
+                controlMessage->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                *reinterpret_cast<uint16_t*>(CMSG_DATA(controlMessage)) = (uint16_t)first.size;
+            }
+
+            firstDatagrams[numMessages] = nextDatagram;
+            ++numMessages;
+            nextDatagram = endDatagram;
+        }
+        firstDatagrams[numMessages] = nextDatagram;
+
+        int numSent = 0;
+        while (numSent < numMessages) {
+            int result = sendmmsg(sd, messages + numSent, numMessages - numSent, 0);
+            if (result <= 0) {
+                break;
+            }
+
+            for (int i = numSent; i < numSent + result; ++i) {
+                bytesWritten += messages[i].msg_len;
+            }
+            numSent += result;
+        }
+
+        if (numSent < numMessages) {
+            int error = errno;
+
+            if (useGSO && (error == EIO || error == EINVAL)) {
+                // the kernel or the NIC refused segmentation offload, don't try it again
+                qCDebug(networking) << "udt::Socket disabling UDP GSO after send error" << error;
+                _gsoSupported = false;
+                useGSO = false;
+            } else {
+                HIFI_FCDEBUG(networking(), "udt::Socket sendmmsg error" << error << "- writing"
+                    << (firstDatagrams[numMessages] - firstDatagrams[numSent]) << "datagrams individually");
+            }
+
+            // sendmmsg stops at the first message it could not send, write the rest one datagram at a time
+            for (size_t i = firstDatagrams[numSent]; i < firstDatagrams[numMessages]; ++i) {
+                const auto& datagram = batch.datagrams[i];
+                auto written = writeDatagram(batch.data.data() + datagram.offset, datagram.size, datagram.destination);
+                if (written > 0) {
+                    bytesWritten += written;
+                }
+            }
+        }
+    }
+#else
+    for (const auto& datagram : batch.datagrams) {
+        auto written = writeDatagram(batch.data.data() + datagram.offset, datagram.size, datagram.destination);
+        if (written > 0) {
+            bytesWritten += written;
+        }
+    }
+#endif
+
+    return bytesWritten;
+}
+
+Socket::AddressShard& Socket::addressShardFor(const HifiSockAddr& sockAddr) {
+    return _addressShards[std::hash<HifiSockAddr>()(sockAddr) % NUM_ADDRESS_SHARDS];
+}
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreate) {
-    Lock connectionsLock(_connectionsHashMutex);
-    auto it = _connectionsHash.find(sockAddr);
+    auto& shard = addressShardFor(sockAddr);
+    Lock connectionsLock(shard.mutex);
+    auto it = shard.connections.find(sockAddr);
 
-    if (it == _connectionsHash.end()) {
+    if (it == shard.connections.end()) {
         // we did not have a matching connection, time to see if we should make one
 
         if (filterCreate && _connectionCreationFilterOperator && !_connectionCreationFilterOperator(sockAddr)) {
@@ -298,7 +604,7 @@ Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool fi
 
             qCDebug(networking) << "Creating new Connection class for" << sockAddr;
 
-            it = _connectionsHash.insert(it, std::make_pair(sockAddr, std::move(connection)));
+            it = shard.connections.insert(it, std::make_pair(sockAddr, std::move(connection)));
         }
     }
 
@@ -311,17 +617,24 @@ void Socket::clearConnections() {
         return;
     }
 
-    Lock connectionsLock(_connectionsHashMutex);
-    if (_connectionsHash.size() > 0) {
-        // clear all of the current connections in the socket
-        qCDebug(networking) << "Clearing all remaining connections in Socket.";
-        _connectionsHash.clear();
+    bool hadConnections = false;
+    for (auto& shard : _addressShards) {
+        Lock connectionsLock(shard.mutex);
+        if (shard.connections.size() > 0) {
+            hadConnections = true;
+            shard.connections.clear();
+        }
+    }
+
+    if (hadConnections) {
+        qCDebug(networking) << "Cleared all remaining connections in Socket.";
     }
 }
 
 void Socket::cleanupConnection(HifiSockAddr sockAddr) {
-    Lock connectionsLock(_connectionsHashMutex);
-    auto numErased = _connectionsHash.erase(sockAddr);
+    auto& shard = addressShardFor(sockAddr);
+    Lock connectionsLock(shard.mutex);
+    auto numErased = shard.connections.erase(sockAddr);
 
     if (numErased > 0) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -365,10 +678,206 @@ void Socket::checkForReadyReadBackup() {
     }
 }
 
+void Socket::setBatchedReceiveEnabled(bool enabled) {
+#if defined(Q_OS_LINUX)
+    _batchedReceiveEnabled = enabled;
+#else
+    if (enabled) {
+        qCDebug(networking) << "Batched datagram receive is only supported on Linux - using one read per datagram.";
+    }
+#endif
+}
+
+void Socket::setNumReceiveThreads(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+#if defined(Q_OS_LINUX)
+    if (numThreads == _numReceiveThreads) {
+        return;
+    }
+
+    _numReceiveThreads = numThreads;
+
+    if (_udpSocket.state() == QAbstractSocket::BoundState) {
+        // the main socket has to be re-created with (or without) SO_REUSEPORT
+        rebind();
+    }
+#else
+    if (numThreads > 1) {
+        qCDebug(networking) << "Sharded receive threads are only supported on Linux - receiving on the Socket thread.";
+    }
+#endif
+}
+
+void Socket::startReceiveShards(const QHostAddress& address) {
+#if defined(Q_OS_LINUX)
+    // how often a shard blocked in recvmmsg wakes up to check if it is being stopped
+    static const int RECEIVE_SHARD_WAKE_USECS = 100 * 1000;
+
+    for (int i = 1; i < _numReceiveThreads; ++i) {
+        int sd = bindReusePortSocket(address, _udpSocket.localPort(), true);
+        if (sd < 0) {
+            break;
+        }
+
+        if (_shouldChangeSocketOptions) {
+            int bufferSize = udt::UDP_RECEIVE_BUFFER_SIZE_BYTES;
+            setsockopt(sd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+        }
+
+        timeval receiveTimeout { 0, RECEIVE_SHARD_WAKE_USECS };
+        setsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, &receiveTimeout, sizeof(receiveTimeout));
+
+        auto shard = std::unique_ptr<ReceiveShard>(new ReceiveShard);
+        shard->socketDescriptor = sd;
+        shard->thread = std::thread(&Socket::runReceiveShard, this, std::ref(*shard));
+        _receiveShards.push_back(std::move(shard));
+    }
+
+    qCDebug(networking) << "Receiving on" << (_receiveShards.size() + 1) << "sockets sharing port" << _udpSocket.localPort();
+#else
+    Q_UNUSED(address);
+#endif
+}
+
+void Socket::stopReceiveShards() {
+#if defined(Q_OS_LINUX)
+    for (auto& shard : _receiveShards) {
+        shard->stopping = true;
+        // wakes up a shard blocked in recvmmsg right away instead of at its next receive timeout
+        ::shutdown(shard->socketDescriptor, SHUT_RDWR);
+    }
+
+    for (auto& shard : _receiveShards) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+        ::close(shard->socketDescriptor);
+    }
+#endif
+
+    _receiveShards.clear();
+}
+
+void Socket::runReceiveShard(ReceiveShard& shard) {
+#if defined(Q_OS_LINUX)
+    static const int RECEIVE_BATCH_SIZE = 64;
+
+    PacketBuffer buffers[RECEIVE_BATCH_SIZE];
+    iovec iovecs[RECEIVE_BATCH_SIZE];
+    sockaddr_storage senderAddresses[RECEIVE_BATCH_SIZE];
+    mmsghdr messages[RECEIVE_BATCH_SIZE];
+
+    std::vector<ShardedDatagram> verified;
+    verified.reserve(RECEIVE_BATCH_SIZE);
+
+    while (!shard.stopping) {
+        prepareReceiveMessages(*_packetBufferPool, buffers, iovecs, senderAddresses, messages, RECEIVE_BATCH_SIZE);
+
+        // block until a datagram arrives, then take whatever else is already queued behind it
+        int numReceived = recvmmsg(shard.socketDescriptor, messages, RECEIVE_BATCH_SIZE, MSG_WAITFORONE, nullptr);
+        if (numReceived <= 0) {
+            // receive timeout, interrupted or shut down - check if we are stopping and go again
+            continue;
+        }
+
+        auto receiveTime = p_high_resolution_clock::now();
+
+        for (int i = 0; i < numReceived; ++i) {
+            int sizeRead = messages[i].msg_len;
+            if (sizeRead <= 0 || messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                continue;
+            }
+
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
+            verifyShardedDatagram(std::move(buffers[i]), sizeRead, senderSockAddr, receiveTime, verified);
+        }
+
+        if (!verified.empty()) {
+            {
+                Lock lock(_shardedDatagramsMutex);
+                std::move(verified.begin(), verified.end(), std::back_inserter(_shardedDatagrams));
+            }
+            verified.clear();
+
+            if (!_shardedDatagramsScheduled.exchange(true)) {
+                QMetaObject::invokeMethod(this, "processShardedDatagrams", Qt::QueuedConnection);
+            }
+        }
+    }
+#else
+    Q_UNUSED(shard);
+#endif
+}
+
+void Socket::verifyShardedDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                                   p_high_resolution_clock::time_point receiveTime,
+                                   std::vector<ShardedDatagram>& verified) {
+    bool hasUnfilteredHandler = false;
+    {
+        Lock lock(_unfilteredHandlersMutex);
+        hasUnfilteredHandler = _unfilteredHandlers.find(senderSockAddr) != _unfilteredHandlers.end();
+    }
+
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    ShardedDatagram datagram;
+    datagram.senderSockAddr = senderSockAddr;
+    datagram.receiveTime = receiveTime;
+
+    if (hasUnfilteredHandler || isControlPacket) {
+        // nothing to verify, these are handled entirely on the Socket thread
+        datagram.buffer = std::move(buffer);
+        datagram.size = size;
+    } else {
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // run the version and hash checks here so they are spread across the shards instead of the Socket thread
+        if (_packetFilterOperator && !_packetFilterOperator(*packet)) {
+            return;
+        }
+
+        datagram.size = size;
+        datagram.packet = std::move(packet);
+    }
+
+    verified.push_back(std::move(datagram));
+}
+
+void Socket::processShardedDatagrams() {
+    // clear the flag before taking the queue, so a shard that adds to it after the swap schedules us again
+    _shardedDatagramsScheduled = false;
+
+    std::vector<ShardedDatagram> datagrams;
+    {
+        Lock lock(_shardedDatagramsMutex);
+        datagrams.swap(_shardedDatagrams);
+    }
+
+    for (auto& datagram : datagrams) {
+        _lastPacketSizeRead = datagram.size;
+        _lastPacketSockAddr = datagram.senderSockAddr;
+
+        if (datagram.packet) {
+            _lastReceivedSequenceNumber = datagram.packet->getSequenceNumber();
+            processVerifiedPacket(std::move(datagram.packet));
+        } else {
+            processDatagram(std::move(datagram.buffer), datagram.size, datagram.senderSockAddr, datagram.receiveTime);
+        }
+    }
+}
+
 void Socket::readPendingDatagrams() {
     using namespace std::chrono;
     static const auto MAX_PROCESS_TIME { 100ms };
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
+
+    if (_batchedReceiveEnabled) {
+        readPendingDatagramBatches(abortTime);
+        return;
+    }
+
     int packetSizeWithHeader = -1;
 
     while (_udpSocket.hasPendingDatagrams() &&
@@ -394,7 +903,7 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBuffer(new char[packetSizeWithHeader]);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
@@ -410,82 +919,184 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+void Socket::readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime) {
+#if defined(Q_OS_LINUX)
+    using namespace std::chrono;
+    static const int RECEIVE_BATCH_SIZE = 64;
 
-            continue;
+    if (!_udpSocket.hasPendingDatagrams()) {
+        return;
+    }
+
+    // The first datagram always goes through QUdpSocket - reading from it is what re-arms Qt's read notifier
+    // for this socket, so that datagrams arriving after we have drained it still trigger readyRead.
+    // Everything behind it is pulled straight from the descriptor with recvmmsg.
+    int packetSizeWithHeader = _udpSocket.pendingDatagramSize();
+    if (packetSizeWithHeader >= 0) {
+        _readyReadBackupTimer->start();
+
+        auto receiveTime = p_high_resolution_clock::now();
+        HifiSockAddr senderSockAddr;
+
+        auto buffer = packetSizeWithHeader <= PacketBufferPool::SLAB_SIZE
+            ? _packetBufferPool->acquire() : PacketBuffer(new char[packetSizeWithHeader]);
+
+        auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
+                                                senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
+
+        _lastPacketSizeRead = sizeRead;
+        _lastPacketSockAddr = senderSockAddr;
+
+        if (sizeRead > 0) {
+            processDatagram(std::move(buffer), sizeRead, senderSockAddr, receiveTime);
         }
+    }
+
+    auto sd = _udpSocket.socketDescriptor();
+
+    PacketBuffer buffers[RECEIVE_BATCH_SIZE];
+    iovec iovecs[RECEIVE_BATCH_SIZE];
+    sockaddr_storage senderAddresses[RECEIVE_BATCH_SIZE];
+    mmsghdr messages[RECEIVE_BATCH_SIZE];
+
+    while (system_clock::now() <= abortTime) {
+        prepareReceiveMessages(*_packetBufferPool, buffers, iovecs, senderAddresses, messages, RECEIVE_BATCH_SIZE);
+
+        int numReceived = recvmmsg(sd, messages, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (numReceived <= 0) {
+            // EAGAIN - the socket is drained
+            break;
+        }
+
+        _readyReadBackupTimer->start();
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        // all datagrams pulled by one recvmmsg call share a receive time
+        auto receiveTime = p_high_resolution_clock::now();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        for (int i = 0; i < numReceived; ++i) {
+            int sizeRead = messages[i].msg_len;
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+            if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                // nothing we send is larger than an MTU, drop anything that did not fit in a slab
+                HIFI_FCDEBUG(networking(), "Dropping oversized datagram from" << senderSockAddr);
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            if (sizeRead <= 0) {
+                continue;
+            }
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+            processDatagram(std::move(buffers[i]), sizeRead, senderSockAddr, receiveTime);
+        }
+
+        if (numReceived < RECEIVE_BATCH_SIZE) {
+            // short batch, nothing more was waiting on the socket
+            break;
+        }
+    }
+#else
+    Q_UNUSED(abortTime);
+#endif
+}
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+void Socket::processDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    bool hasUnfilteredHandler = false;
+    BasePacketHandler unfilteredHandler;
+    {
+        Lock lock(_unfilteredHandlersMutex);
+        auto it = _unfilteredHandlers.find(senderSockAddr);
+        if (it != _unfilteredHandlers.end()) {
+            hasUnfilteredHandler = true;
+            unfilteredHandler = it->second;
+        }
+    }
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    if (hasUnfilteredHandler) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (unfilteredHandler) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            unfilteredHandler(std::move(basePacket));
+        }
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            processVerifiedPacket(std::move(packet));
+        }
+    }
+}
+
+void Socket::processVerifiedPacket(std::unique_ptr<Packet> packet) {
+    auto connection = findOrCreateConnection(packet->getSenderSockAddr(), true);
+
+    if (packet->isReliable()) {
+        // if this was a reliable packet then signal the matching connection with the sequence number
+
+        if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                      packet->getDataSize(),
+                                                                      packet->getPayloadSize())) {
+            // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+            qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
+            return;
+        }
+    } else if (connection) {
+        connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                    packet->getPayloadSize());
+    }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
-            }
+    if (packet->isPartOfMessage()) {
+        if (connection) {
+            connection->queueReceivedMessagePacket(std::move(packet));
         }
+    } else if (_packetHandler) {
+        // call the verified packet callback to let it handle this packet
+        _packetHandler(std::move(packet));
     }
 }
 
 void Socket::connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, const char* slot) {
-    Lock connectionsLock(_connectionsHashMutex);
-    auto it = _connectionsHash.find(destinationAddr);
-    if (it != _connectionsHash.end()) {
+    auto& shard = addressShardFor(destinationAddr);
+    Lock connectionsLock(shard.mutex);
+    auto it = shard.connections.find(destinationAddr);
+    if (it != shard.connections.end()) {
         connect(it->second.get(), SIGNAL(packetSent()), receiver, slot);
     }
 }
@@ -497,19 +1108,27 @@ void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtua
 
 
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
-    qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
-            << _connectionsHash.size() << "live connections)";
     _maxBandwidth = maxBandwidth;
-    Lock connectionsLock(_connectionsHashMutex);
-    for (auto& pair : _connectionsHash) {
-        auto& connection = pair.second;
-        connection->setMaxBandwidth(_maxBandwidth);
+
+    size_t numConnections = 0;
+    for (auto& shard : _addressShards) {
+        Lock connectionsLock(shard.mutex);
+        for (auto& pair : shard.connections) {
+            auto& connection = pair.second;
+            connection->setMaxBandwidth(_maxBandwidth);
+        }
+        numConnections += shard.connections.size();
     }
+
+    qInfo() << "Set socket's maximum bandwith to" << maxBandwidth << "bps. ("
+            << numConnections << "live connections)";
 }
 
 ConnectionStats::Stats Socket::sampleStatsForConnection(const HifiSockAddr& destination) {
-    auto it = _connectionsHash.find(destination);
-    if (it != _connectionsHash.end()) {
+    auto& shard = addressShardFor(destination);
+    Lock connectionsLock(shard.mutex);
+    auto it = shard.connections.find(destination);
+    if (it != shard.connections.end()) {
         return it->second->sampleStats();
     } else {
         return ConnectionStats::Stats();
@@ -518,11 +1137,12 @@ ConnectionStats::Stats Socket::sampleStatsForConnection(const HifiSockAddr& dest
 
 Socket::StatsVector Socket::sampleStatsForAllConnections() {
     StatsVector result;
-    Lock connectionsLock(_connectionsHashMutex);
 
-    result.reserve(_connectionsHash.size());
-    for (const auto& connectionPair : _connectionsHash) {
-        result.emplace_back(connectionPair.first, connectionPair.second->sampleStats());
+    for (auto& shard : _addressShards) {
+        Lock connectionsLock(shard.mutex);
+        for (const auto& connectionPair : shard.connections) {
+            result.emplace_back(connectionPair.first, connectionPair.second->sampleStats());
+        }
     }
     return result;
 }
@@ -530,12 +1150,12 @@ Socket::StatsVector Socket::sampleStatsForAllConnections() {
 
 std::vector<HifiSockAddr> Socket::getConnectionSockAddrs() {
     std::vector<HifiSockAddr> addr;
-    Lock connectionsLock(_connectionsHashMutex);
 
-    addr.reserve(_connectionsHash.size());
-
-    for (const auto& connectionPair : _connectionsHash) {
-        addr.push_back(connectionPair.first);
+    for (auto& shard : _addressShards) {
+        Lock connectionsLock(shard.mutex);
+        for (const auto& connectionPair : shard.connections) {
+            addr.push_back(connectionPair.first);
+        }
     }
     return addr;
 }
@@ -570,28 +1190,32 @@ void Socket::handleStateChanged(QAbstractSocket::SocketState socketState) {
 }
 
 void Socket::handleRemoteAddressChange(HifiSockAddr previousAddress, HifiSockAddr currentAddress) {
-    {
-        Lock connectionsLock(_connectionsHashMutex);
-
-        const auto connectionIter = _connectionsHash.find(previousAddress);
-        // Don't move classes that are unused so far.
-        if (connectionIter != _connectionsHash.end() && connectionIter->second->hasReceivedHandshake()) {
-            auto connection = move(connectionIter->second);
-            _connectionsHash.erase(connectionIter);
-            connection->setDestinationAddress(currentAddress);
-            _connectionsHash[currentAddress] = move(connection);
-            connectionsLock.unlock();
-            qCDebug(networking) << "Moved Connection class from" << previousAddress << "to" << currentAddress;
-
-            Lock sequenceNumbersLock(_unreliableSequenceNumbersMutex);
-            const auto sequenceNumbersIter = _unreliableSequenceNumbers.find(previousAddress);
-            if (sequenceNumbersIter != _unreliableSequenceNumbers.end()) {
-                auto sequenceNumbers = sequenceNumbersIter->second;
-                _unreliableSequenceNumbers.erase(sequenceNumbersIter);
-                _unreliableSequenceNumbers[currentAddress] = sequenceNumbers;
-            }
+    auto& previousShard = addressShardFor(previousAddress);
+    auto& currentShard = addressShardFor(currentAddress);
+
+    // both addresses may live in the same shard - otherwise always lock the shards in the same order
+    Lock firstLock(std::min(&previousShard, &currentShard)->mutex);
+    Lock secondLock;
+    if (&previousShard != &currentShard) {
+        secondLock = Lock(std::max(&previousShard, &currentShard)->mutex);
+    }
 
+    const auto connectionIter = previousShard.connections.find(previousAddress);
+    // Don't move classes that are unused so far.
+    if (connectionIter != previousShard.connections.end() && connectionIter->second->hasReceivedHandshake()) {
+        auto connection = move(connectionIter->second);
+        previousShard.connections.erase(connectionIter);
+        connection->setDestinationAddress(currentAddress);
+        currentShard.connections[currentAddress] = move(connection);
+
+        const auto sequenceNumbersIter = previousShard.unreliableSequenceNumbers.find(previousAddress);
+        if (sequenceNumbersIter != previousShard.unreliableSequenceNumbers.end()) {
+            auto sequenceNumbers = sequenceNumbersIter->second;
+            previousShard.unreliableSequenceNumbers.erase(sequenceNumbersIter);
+            currentShard.unreliableSequenceNumbers[currentAddress] = sequenceNumbers;
         }
+
+        qCDebug(networking) << "Moved Connection class from" << previousAddress << "to" << currentAddress;
     }
 }
 
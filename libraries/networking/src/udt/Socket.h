@@ -14,18 +14,25 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
 #include <list>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtNetwork/QUdpSocket>
 
+#include <PortableHighResolutionClock.h>
+
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "PacketBufferPool.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -56,6 +63,7 @@ public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -79,8 +87,25 @@ public:
         { _connectionCreationFilterOperator = filterOperator; }
     
     void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler)
-        { _unfilteredHandlers[senderSockAddr] = handler; }
+        { Lock lock(_unfilteredHandlersMutex); _unfilteredHandlers[senderSockAddr] = handler; }
     
+    // Unreliable datagrams written from the calling thread are held until flushSendBatch, then written together
+    // with sendmmsg (coalescing same-size runs to one destination with UDP GSO where the kernel supports it).
+    // Only has an effect on Linux - elsewhere datagrams are written immediately.
+    void beginSendBatch();
+    qint64 flushSendBatch();
+
+    // Linux only - drain the socket with recvmmsg into pooled MTU sized buffers instead of one read per datagram
+    void setBatchedReceiveEnabled(bool enabled);
+    bool isBatchedReceiveEnabled() const { return _batchedReceiveEnabled; }
+
+    // Linux only - bind numThreads sockets to our port with SO_REUSEPORT so the kernel spreads peers across them.
+    // Every socket past the first gets its own receive thread that verifies packets (version and HMAC checks
+    // in the packet filter operator) before handing them to the Socket thread.
+    // The packet filter operator must be safe to call from those threads.
+    void setNumReceiveThreads(int numThreads);
+    int getNumReceiveThreads() const { return _numReceiveThreads; }
+
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
@@ -104,12 +129,48 @@ public slots:
 private slots:
     void readPendingDatagrams();
     void checkForReadyReadBackup();
+    void processShardedDatagrams();
 
     void handleSocketError(QAbstractSocket::SocketError socketError);
     void handleStateChanged(QAbstractSocket::SocketState socketState);
 
 private:
     void setSystemBufferSizes();
+    struct SendBatch;
+    static SendBatch& getThreadSendBatch();
+    qint64 writeSendBatch(SendBatch& batch);
+    void readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime);
+    void processDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+    void processVerifiedPacket(std::unique_ptr<Packet> packet);
+
+    struct ReceiveShard;
+
+    // a datagram read by a receive shard - data packets arrive already verified, control packets and datagrams for
+    // unfiltered handlers arrive as the raw buffer and take the regular processDatagram path on the Socket thread
+    struct ShardedDatagram {
+        std::unique_ptr<Packet> packet;
+        PacketBuffer buffer;
+        qint64 size { 0 };
+        HifiSockAddr senderSockAddr;
+        p_high_resolution_clock::time_point receiveTime;
+    };
+
+    void startReceiveShards(const QHostAddress& address);
+    void stopReceiveShards();
+    void runReceiveShard(ReceiveShard& shard);
+    void verifyShardedDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                               p_high_resolution_clock::time_point receiveTime, std::vector<ShardedDatagram>& verified);
+
+    // per-address state is split across shards, each with its own lock, so that threads sending to
+    // or receiving from different peers don't all serialize on the same mutex
+    struct AddressShard {
+        Mutex mutex;
+        std::unordered_map<HifiSockAddr, SequenceNumber> unreliableSequenceNumbers;
+        std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> connections;
+    };
+    static const int NUM_ADDRESS_SHARDS = 16;
+    AddressShard& addressShardFor(const HifiSockAddr& sockAddr);
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
@@ -128,12 +189,10 @@ private:
     MessageFailureHandler _messageFailureHandler;
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
 
-    Mutex _unreliableSequenceNumbersMutex;
-    Mutex _connectionsHashMutex;
-
+    Mutex _unfilteredHandlersMutex;
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
-    std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
-    std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
+
+    std::array<AddressShard, NUM_ADDRESS_SHARDS> _addressShards;
 
     QTimer* _readyReadBackupTimer { nullptr };
 
@@ -143,6 +202,16 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+    bool _batchedReceiveEnabled { false };
+    std::atomic<bool> _gsoSupported { false };
+    std::shared_ptr<PacketBufferPool> _packetBufferPool { PacketBufferPool::create() };
+
+    int _numReceiveThreads { 1 };
+    std::vector<std::unique_ptr<ReceiveShard>> _receiveShards;
+    Mutex _shardedDatagramsMutex;
+    std::vector<ShardedDatagram> _shardedDatagrams;
+    std::atomic<bool> _shardedDatagramsScheduled { false };
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
@@ -254,6 +254,10 @@ int TCPVegasCC::estimatedTimeout() const {
     return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
 }
 
+int TCPVegasCC::estimatedRTT() const {
+    return _ewmaRTT == -1 ? 0 : _ewmaRTT;
+}
+
 bool TCPVegasCC::isCongestionWindowLimited() {
     if (_slowStart) {
         return true;
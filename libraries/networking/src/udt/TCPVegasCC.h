@@ -33,6 +33,7 @@ public:
     virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
 
     virtual int estimatedTimeout() const override;
+    virtual int estimatedRTT() const override;
     
 protected:
     virtual void performCongestionAvoidance(SequenceNumber ack);
@@ -52,7 +52,7 @@
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "ents"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -676,6 +676,10 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith(".ents")) {
+        return readFromSnapshotFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -839,6 +843,7 @@ bool Octree::readJSONFromStream(
     // if the data is gzipped we may not have a useful bytesAvailable() result, so just keep reading until
     // we get an eof.  Leave streamLength parameter for consistency.
 
+    quint64 startParse = usecTimestampNow();
     QByteArray jsonBuffer;
     char* rawData = new char[READ_JSON_BUFFER_SIZE];
     while (!inputStream.atEnd()) {
@@ -865,8 +870,12 @@ bool Octree::readJSONFromStream(
     if (!marketplaceID.isEmpty()) {
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
+    quint64 parseTime = usecTimestampNow() - startParse;
 
     bool success = readFromMap(asMap);
+    LoadStats loadStats = getLoadStats();
+    loadStats.parseTime = parseTime;
+    setLoadStats(loadStats);
     delete[] rawData;
     return success;
 }
@@ -882,6 +891,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "ents") {
+        success = writeToSnapshotFile(qFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
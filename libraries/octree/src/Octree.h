@@ -13,8 +13,10 @@
 #define hifi_Octree_h
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <stdint.h>
+#include <vector>
 
 #include <QHash>
 #include <QObject>
@@ -33,10 +35,19 @@
 class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
+class OctreeJournal;
 class OctreePacketData;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
 
+/// An edit decoded from an edit packet, waiting to be applied to the tree, see Octree::decodeEditPacketData()
+class OctreeEdit {
+public:
+    virtual ~OctreeEdit() {}
+};
+using OctreeEditPointer = std::unique_ptr<OctreeEdit>;
+using OctreeEdits = std::vector<OctreeEditPointer>;
+
 extern QVector<QString> PERSIST_EXTENSIONS;
 
 /// derive from this class to use the Octree::recurseTreeWithOperator() method
@@ -73,6 +84,9 @@ public:
     } reason;
     reason stopReason;
 
+    // items may reuse an encoding they made for another destination, when nothing about them changed since
+    bool useEncodedDataCache { false };
+
     EncodeBitstreamParams(bool includeExistsBits = WANT_EXISTS_BITS,
                           NodeData* nodeData = nullptr) :
             includeExistsBits(includeExistsBits),
@@ -138,6 +152,17 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    // Batched edits: rather than each edit going through processEditPacketData() under its own write lock, the edits
+    // of a batch are decoded by decodeEditPacketData() without the tree lock - from several threads at once - then
+    // prepared in order by prepareEdits(), still without the lock, and applied in order by applyEdits() under a single
+    // write lock. The message must outlive the edits decoded from it.
+    virtual bool handlesBatchedEdits() const { return false; }
+    virtual OctreeEditPointer decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& sourceNode, int& bytesRead) { bytesRead = 0; return nullptr; }
+    // returns the number of edits that were merged into others and removed from the batch
+    virtual int prepareEdits(OctreeEdits& edits) { return 0; }
+    virtual void applyEdits(OctreeEdits& edits) { }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -213,6 +238,8 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    // binary snapshot, see OctreeSnapshot.h - only supported by trees that can encode their items on their own
+    virtual bool writeToSnapshotFile(const QString& fileName, const OctreeElementPointer& element) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -223,6 +250,12 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    // folds in the journal of the snapshot, if any, see OctreeJournal.h
+    virtual bool readFromSnapshotFile(const QString& fileName, const QString& journalFileName = QString()) { return false; }
+
+    // edit journal - the tree tracks the items changed since the last snapshot, and appends them on writeToJournal()
+    virtual void setWantJournal(bool wantJournal) { }
+    virtual bool writeToJournal(OctreeJournal& journal) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -261,9 +294,24 @@ public:
     virtual quint64 getAverageFilterTime() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
+    QUuid getPersistID() const { return _persistID; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
+
+    /// Time taken by each phase of the last load of a whole file or map, for the server stats, which read it from
+    /// another thread
+    struct LoadStats {
+        int numItems { 0 };
+        quint64 parseTime { 0 }; // reading and parsing the JSON, or the snapshot's index and journal
+        quint64 decodeTime { 0 }; // converting the items to properties, spread over threads
+        quint64 sortTime { 0 }; // ordering them by octal code
+        quint64 insertTime { 0 }; // adding them to the tree
+    };
+    LoadStats getLoadStats() const { std::lock_guard<std::mutex> lock(_loadStatsMutex); return _loadStats; }
 
 
 protected:
+    void setLoadStats(const LoadStats& loadStats) { std::lock_guard<std::mutex> lock(_loadStatsMutex); _loadStats = loadStats; }
+
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
 
     static bool countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData);
@@ -277,6 +325,8 @@ protected:
 
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
+    mutable std::mutex _loadStatsMutex;
+    LoadStats _loadStats; // guarded by _loadStatsMutex
 
     bool _isDirty;
     bool _shouldReaverage;
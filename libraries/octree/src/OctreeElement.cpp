@@ -52,23 +52,24 @@ OctreeElement::OctreeElement() {
 }
 
 void OctreeElement::init(unsigned char * octalCode) {
+    unsigned char rootOctalCode = 0;
     if (!octalCode) {
-        octalCode = new unsigned char[1];
-        *octalCode = 0;
+        octalCode = &rootOctalCode;
     }
     _voxelNodeCount++;
     _voxelNodeLeafCount++; // all nodes start as leaf nodes
 
 
+    // codes up to 8 bytes, which is 20 levels deep, are kept inline, the longer ones go to SlabPool
     size_t octalCodeLength = bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(octalCode));
     if (octalCodeLength > sizeof(_octalCode)) {
-        _octalCode.pointer = octalCode;
+        _octalCode.pointer = static_cast<unsigned char*>(SlabPool::allocate(octalCodeLength));
+        memcpy(_octalCode.pointer, octalCode, octalCodeLength);
         _octcodePointer = true;
         _octcodeMemoryUsage += octalCodeLength;
     } else {
         _octcodePointer = false;
         memcpy(_octalCode.buffer, octalCode, octalCodeLength);
-        delete[] octalCode;
     }
 
     // set up the _children union
@@ -107,8 +108,9 @@ OctreeElement::~OctreeElement() {
     }
 
     if (_octcodePointer) {
-        _octcodeMemoryUsage -= bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(getOctalCode()));
-        delete[] _octalCode.pointer;
+        size_t octalCodeLength = bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(getOctalCode()));
+        _octcodeMemoryUsage -= octalCodeLength;
+        SlabPool::release(_octalCode.pointer, octalCodeLength);
     }
 
     // delete all of this node's children, this also takes care of all population tracking data
@@ -388,7 +390,8 @@ OctreeElementPointer OctreeElement::addChildAtIndex(int childIndex) {
             _voxelNodeLeafCount--;
         }
 
-        unsigned char* newChildCode = childOctalCode(getOctalCode(), childIndex);
+        unsigned char newChildCode[MAX_CHILD_OCTAL_CODE_BYTES];
+        childOctalCode(getOctalCode(), childIndex, newChildCode);
         childAt = createNewElement(newChildCode);
         setChildAtIndex(childIndex, childAt);
 
@@ -21,6 +21,7 @@
 
 #include <OctalCode.h>
 #include <SharedUtil.h>
+#include <SlabAllocator.h>
 #include <ViewFrustum.h>
 
 #include "AACube.h"
@@ -48,12 +49,19 @@ protected:
     // can only be constructed by derived implementation
     OctreeElement();
 
+    /// The octal code is copied, it remains the caller's. Allocate the element with new, so that it comes from the
+    /// element pools, and give its shared pointer a SlabAllocator for the control block to come from them too.
     virtual OctreeElementPointer createNewElement(unsigned char * octalCode = NULL) = 0;
 
 public:
     virtual void init(unsigned char * octalCode); /// Your subclass must call init on construction.
     virtual ~OctreeElement();
 
+    /// Elements of all the octree types are allocated from SlabPool: a tree is millions of them, allocated and
+    /// traversed together
+    static void* operator new(size_t size) { return SlabPool::allocate(size); }
+    static void operator delete(void* element, size_t size) { SlabPool::release(element, size); }
+
     // methods you can and should override to implement your tree functionality
 
     /// Adds a child to the current element. Override this if there is additional child initialization your class needs.
@@ -11,16 +11,23 @@
 
 #include "OctreeEntitiesFileParser.h"
 
+#include <atomic>
 #include <sstream>
 #include <cctype>
+#include <vector>
 
 #include <QUuid>
 #include <QJsonDocument>
 #include <QJsonObject>
 
+#include <TBBHelpers.h>
+
 
 using std::string;
 
+// enough for a parse task to be worth handing to another thread
+const int ENTITIES_PER_PARSE_TASK = 64;
+
 std::string OctreeEntitiesFileParser::getErrorString() const {
     std::ostringstream err;
     if (_errorString.size() != 0) {
@@ -219,6 +226,13 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
         return false;
     }
 
+    // find where each entity starts and ends, then parse them in chunks over threads
+    struct EntitySpan {
+        int position;
+        int line;
+        int end;
+    };
+    std::vector<EntitySpan> spans;
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -230,23 +244,45 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
-            return false;
-        }
-
-        entitiesArray.append(entity.object());
+        spans.push_back({ _position - 1, _line, matchingBrace });
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
-            return true;
+            break;
         } else if (c != ',') {
             _errorString = "Entity array item incorrectly terminated";
             return false;
         }
     }
+
+    int numEntities = (int)spans.size();
+    std::vector<QJsonObject> entities(numEntities);
+    std::atomic<int> firstIllFormed { numEntities };
+    tbb::parallel_for(tbb::blocked_range<int>(0, numEntities, ENTITIES_PER_PARSE_TASK), [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i != range.end(); ++i) {
+            const EntitySpan& span = spans[i];
+            QJsonDocument entity = QJsonDocument::fromJson(QByteArray::fromRawData(_entitiesContents.constData() + span.position,
+                span.end - span.position));
+            if (entity.isNull()) {
+                int first = firstIllFormed;
+                while (i < first && !firstIllFormed.compare_exchange_weak(first, i)) { }
+                return;
+            }
+            entities[i] = entity.object();
+        }
+    });
+
+    if (firstIllFormed < numEntities) {
+        _position = spans[firstIllFormed].position;
+        _line = spans[firstIllFormed].line;
+        _errorString = "Ill-formed entity";
+        return false;
+    }
+
+    entitiesArray.reserve(numEntities);
+    for (auto& entity : entities) {
+        entitiesArray.append(std::move(entity));
+    }
     return true;
 }
 
@@ -0,0 +1,135 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <cstring>
+
+#include <QFileInfo>
+
+#include "OctreeLogging.h"
+
+const QString OctreeJournal::FILE_EXTENSION = "journal";
+
+static const char MAGIC[8] = { 'H', 'F', 'O', 'C', 'T', 'J', 'N', 'L' };
+static const uint32_t FORMAT_VERSION = 1;
+static const int NUM_BYTES_ID = 16;
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t contentVersion;
+    uint8_t snapshotID[16];
+    int64_t snapshotDataVersion;
+};
+static_assert(sizeof(Header) == 40, "OctreeJournal Header must be packed");
+
+// size, type and ID ahead of the data, checksum after it
+static const int RECORD_PREFIX_SIZE = sizeof(uint32_t) + sizeof(uint8_t) + NUM_BYTES_ID;
+static const int RECORD_SUFFIX_SIZE = sizeof(uint16_t);
+
+static Header makeHeader(const QUuid& snapshotID, int64_t snapshotDataVersion, PacketVersion contentVersion) {
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.contentVersion = contentVersion;
+    memcpy(header.snapshotID, snapshotID.toRfc4122().constData(), NUM_BYTES_ID);
+    header.snapshotDataVersion = snapshotDataVersion;
+    return header;
+}
+
+bool OctreeJournal::reset(const QUuid& snapshotID, int64_t snapshotDataVersion, PacketVersion contentVersion) {
+    _file.close();
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCCritical(octree) << "Failed to open journal for writing:" << _file.fileName() << _file.errorString();
+        return false;
+    }
+
+    Header header = makeHeader(snapshotID, snapshotDataVersion, contentVersion);
+    return _file.write(reinterpret_cast<const char*>(&header), sizeof(Header)) == sizeof(Header) && flush();
+}
+
+bool OctreeJournal::append(RecordType type, const QUuid& id, const QByteArray& data) {
+    if (!_file.isOpen()) {
+        return false;
+    }
+
+    // the record is assembled first so that it goes out in one write
+    QByteArray record;
+    record.reserve(RECORD_PREFIX_SIZE + data.size() + RECORD_SUFFIX_SIZE);
+    uint32_t size = (uint32_t)data.size();
+    record.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    record.append((char)type);
+    record.append(id.toRfc4122());
+    record.append(data);
+    uint16_t checksum = qChecksum(record.constData() + sizeof(size), record.size() - sizeof(size));
+    record.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+
+    if (_file.write(record) != record.size()) {
+        qCCritical(octree) << "Failed to append to journal:" << _file.fileName() << _file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool OctreeJournal::flush() {
+    return _file.isOpen() && _file.flush();
+}
+
+bool OctreeJournal::hasRecords(const QString& fileName) {
+    return QFileInfo(fileName).size() > (qint64)sizeof(Header);
+}
+
+int OctreeJournal::replay(const QString& fileName, const QUuid& snapshotID, int64_t snapshotDataVersion,
+                          PacketVersion contentVersion, const Replay& replay) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QByteArray journal = file.readAll();
+    file.close();
+
+    Header expected = makeHeader(snapshotID, snapshotDataVersion, contentVersion);
+    if (journal.size() < (int)sizeof(Header) || memcmp(journal.constData(), &expected, sizeof(Header)) != 0) {
+        qCDebug(octree) << "Ignoring journal" << fileName << "which wasn't started on the current snapshot";
+        return 0;
+    }
+
+    int numRecords = 0;
+    int offset = sizeof(Header);
+    while (journal.size() - offset >= RECORD_PREFIX_SIZE + RECORD_SUFFIX_SIZE) {
+        const char* record = journal.constData() + offset;
+        uint32_t size;
+        memcpy(&size, record, sizeof(size));
+        if (size > (uint32_t)(journal.size() - offset - RECORD_PREFIX_SIZE - RECORD_SUFFIX_SIZE)) {
+            break;
+        }
+
+        uint16_t checksum;
+        memcpy(&checksum, record + RECORD_PREFIX_SIZE + size, sizeof(checksum));
+        if (checksum != qChecksum(record + sizeof(size), RECORD_PREFIX_SIZE - sizeof(size) + size)) {
+            break;
+        }
+
+        RecordType type = (RecordType)record[sizeof(size)];
+        QUuid id = QUuid::fromRfc4122(QByteArray::fromRawData(record + sizeof(size) + sizeof(uint8_t), NUM_BYTES_ID));
+        replay(type, id, journal.mid(offset + RECORD_PREFIX_SIZE, size));
+
+        offset += RECORD_PREFIX_SIZE + size + RECORD_SUFFIX_SIZE;
+        ++numRecords;
+    }
+
+    if (offset != journal.size()) {
+        qCWarning(octree) << "Journal" << fileName << "ends with an incomplete record, dropped"
+            << journal.size() - offset << "bytes";
+    }
+    return numRecords;
+}
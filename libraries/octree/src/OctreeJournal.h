@@ -0,0 +1,74 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournal_h
+#define hifi_OctreeJournal_h
+
+#include <cstdint>
+#include <functional>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QUuid>
+
+#include <udt/PacketHeaders.h>
+
+/// Append-only log of the items changed since the last snapshot of an octree, see OctreeSnapshot.h.
+///
+/// A record holds either the whole state of an item, encoded like a snapshot record, or its deletion. The latest
+/// record of an item overrides its snapshot record, so a journal is folded in when the snapshot is loaded, and
+/// compacting the journal is just writing a new snapshot and starting a new journal on top of it.
+///
+/// The journal names the snapshot it was started on, it is ignored when loaded with any other snapshot - e.g. when
+/// the server stopped after writing a new snapshot but before starting its journal.
+///
+/// Layout, little-endian:
+///     Header          40 bytes, see below
+///     Records         { uint32_t size; uint8_t type; uint8_t id[16]; uint8_t data[size]; uint16_t checksum; }
+class OctreeJournal {
+public:
+    enum RecordType : uint8_t {
+        Update = 1,
+        Erase = 2
+    };
+
+    using Replay = std::function<void(RecordType type, const QUuid& id, const QByteArray& data)>;
+
+    static const QString FILE_EXTENSION;
+
+    OctreeJournal(const QString& fileName) : _file(fileName) {}
+
+    QString getFileName() const { return _file.fileName(); }
+
+    /// Starts a new, empty journal on top of a snapshot
+    bool reset(const QUuid& snapshotID, int64_t snapshotDataVersion, PacketVersion contentVersion);
+
+    bool append(RecordType type, const QUuid& id, const QByteArray& data = QByteArray());
+
+    /// Hands the appended records to the OS, so that they survive the server crashing
+    bool flush();
+
+    bool isOpen() const { return _file.isOpen(); }
+    qint64 size() const { return _file.isOpen() ? _file.size() : 0; }
+
+    /// True if the journal file holds any record, whichever snapshot it was started on
+    static bool hasRecords(const QString& fileName);
+
+    /// Calls replay for each record of the journal, in order, if it was started on the given snapshot. A record cut
+    /// short at the end, by a crash while it was appended, ends the replay. Returns the number of records replayed.
+    static int replay(const QString& fileName, const QUuid& snapshotID, int64_t snapshotDataVersion,
+                      PacketVersion contentVersion, const Replay& replay);
+
+private:
+    QFile _file;
+};
+
+#endif // hifi_OctreeJournal_h
@@ -36,10 +36,17 @@
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
+#include "OctreeSnapshot.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
+// journaled edits are handed to the OS this often, it bounds what a crash loses
+constexpr std::chrono::seconds JOURNAL_FLUSH_INTERVAL { 1 };
+// the journal is folded into a new snapshot once it grows past half the snapshot, or is this old
+constexpr qint64 MIN_JOURNAL_SIZE_TO_COMPACT { 1000 * 1000 };
+constexpr std::chrono::minutes MAX_TIME_BETWEEN_COMPACTIONS { 10 };
+
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
@@ -58,6 +65,10 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+
+    if (isPersistedAsSnapshot()) {
+        _journal.reset(new OctreeJournal(_filename + "." + OctreeJournal::FILE_EXTENSION));
+    }
 }
 
 void OctreePersistThread::start() {
@@ -74,7 +85,35 @@ void OctreePersistThread::start() {
     OctreeUtils::RawOctreeData data;
     qCDebug(octree) << "Reading octree data from" << _filename;
     QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
+    if (isPersistedAsSnapshot() && file.exists() && !isSnapshotOfCurrentVersion()) {
+        // e.g. after an upgrade, the snapshot is kept aside and the content migrated again from JSON: the domain
+        // server's copy, which is sent on every persist, or the local JSON file if the domain server has none newer
+        qCWarning(octree) << "Snapshot" << _filename << "is of another version, reading the JSON copy instead";
+        backupCurrentFile();
+    }
+    if (isPersistedAsSnapshot() && !file.exists()) {
+        // first start with the binary format, migrate from the JSON file the server used to persist to
+        file.setFileName(findMostRecentFileExtension(_filename, { "json", "json.gz" }));
+        qCDebug(octree) << "No snapshot found, reading octree data from" << file.fileName();
+    }
+
+    if (isPersistedAsSnapshot() && file.fileName() == _filename && file.open(QIODevice::ReadOnly)) {
+        // only the header of a snapshot is read here, the rest is mapped when the tree is loaded
+        QByteArray header = file.read(sizeof(OctreeSnapshot::Header));
+        file.close();
+
+        PacketVersion contentVersion;
+        if (OctreeSnapshot::readInfo(header, data.id, data.dataVersion, contentVersion)) {
+            qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+            packet->writePrimitive(true);
+            auto id = data.id.toRfc4122();
+            packet->write(id);
+            packet->writePrimitive(data.dataVersion);
+        } else {
+            qCWarning(octree) << "No octree data found";
+            packet->writePrimitive(false);
+        }
+    } else if (file.open(QIODevice::ReadOnly)) {
         QByteArray jsonData(file.readAll());
         file.close();
         if (!gunzip(jsonData, _cachedJSONData)) {
@@ -115,8 +154,17 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     if (includesNewData) {
         _cachedJSONData.clear();
         replacementData = message->readAll();
-        replaceData(replacementData);
-        hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        if (isPersistedAsSnapshot()) {
+            // the replacement is JSON, it is loaded from memory and the snapshot written from the loaded tree
+            backupCurrentFile();
+            if (!gunzip(replacementData, _cachedJSONData)) {
+                _cachedJSONData = replacementData;
+            }
+            hasValidOctreeData = data.readOctreeDataInfoFromData(_cachedJSONData);
+        } else {
+            replaceData(replacementData);
+            hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        }
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
@@ -130,7 +178,10 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
                 data.resetIdAndVersion();
 
                 QFile file(_filename);
-                if (file.open(QIODevice::WriteOnly)) {
+                if (isPersistedAsSnapshot()) {
+                    // migrating from JSON, the snapshot is written once the data is loaded
+                    _cachedJSONData = data.toByteArray();
+                } else if (file.open(QIODevice::WriteOnly)) {
                     auto entityData = data.toGzippedByteArray();
                     file.write(entityData);
                     file.close();
@@ -149,11 +200,14 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    bool loadedFromJSON = !_cachedJSONData.isEmpty();
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
+        if (_cachedJSONData.isEmpty() && isPersistedAsSnapshot()) {
+            persistentFileRead = _tree->readFromSnapshotFile(_filename, _journal->getFileName());
+        } else if (_cachedJSONData.isEmpty()) {
             persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
         } else {
             QDataStream jsonStream(_cachedJSONData);
@@ -166,8 +220,35 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
+    Octree::LoadStats loadStats = _tree->getLoadStats();
+    qCDebug(octree) << "Loaded" << loadStats.numItems << "items in" << _loadTimeUSecs << "usecs - parse" << loadStats.parseTime
+        << "decode" << loadStats.decodeTime << "sort" << loadStats.sortTime << "insert" << loadStats.insertTime;
+
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    if (isPersistedAsSnapshot() && !persistentFileRead) {
+        if (!loadedFromJSON) {
+            // e.g. a snapshot of another version, keep it from being overwritten by the next persist
+            backupCurrentFile();
+        }
+    } else if (isPersistedAsSnapshot() && (loadedFromJSON || OctreeJournal::hasRecords(_journal->getFileName()))) {
+        // write the snapshot right away, so that the next start maps it instead of parsing the JSON or folding in
+        // the journal again
+        if (!loadedFromJSON) {
+            _tree->incrementPersistDataVersion();
+        }
+        if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
+            qCDebug(octree) << "Wrote octree data snapshot to" << _filename;
+            startJournal();
+        } else {
+            // the journal is kept until a snapshot gets written
+            qCWarning(octree) << "Failed to write octree data snapshot to" << _filename;
+            _tree->setDirtyBit();
+        }
+    } else if (isPersistedAsSnapshot()) {
+        startJournal();
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -191,7 +272,8 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
 
-    if (replacementData.isNull()) {
+    // a snapshot that couldn't be read, with no JSON copy to fall back on, must not replace the domain server's copy
+    if (replacementData.isNull() && !(isPersistedAsSnapshot() && !persistentFileRead)) {
         sendLatestEntityDataToDS();
     }
 
@@ -201,10 +283,22 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 }
 
 
+bool OctreePersistThread::isSnapshotOfCurrentVersion() const {
+    QFile file(_filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray header = file.read(sizeof(OctreeSnapshot::Header));
+    QUuid id;
+    int64_t dataVersion;
+    PacketVersion contentVersion;
+    return OctreeSnapshot::readInfo(header, id, dataVersion, contentVersion) && contentVersion == _tree->expectedVersion();
+}
+
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || isPersistedAsSnapshot()) {
         return "application/zip";
     }
     return "";
@@ -248,6 +342,11 @@ void OctreePersistThread::process() {
     auto now = std::chrono::steady_clock::now();
     auto timeSinceLastPersist = now - _lastPersistCheck;
 
+    if (_journal && _journal->isOpen() && now - _lastJournalFlush > JOURNAL_FLUSH_INTERVAL) {
+        _lastJournalFlush = now;
+        flushJournal();
+    }
+
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
         persist();
@@ -258,12 +357,19 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    _forceCompaction = true;
     persist();
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (isPersistedAsSnapshot()) {
+        // snapshots are only meaningful to this version of the server, hand out the content as JSON
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -303,6 +409,13 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        if (_journal && _journal->isOpen() && !_forceCompaction &&
+            _journal->size() < std::max(MIN_JOURNAL_SIZE_TO_COMPACT, _lastSnapshotSize / 2) &&
+            std::chrono::steady_clock::now() - _lastCompaction < MAX_TIME_BETWEEN_COMPACTIONS) {
+            // the edits are in the journal already, the snapshot can wait
+            return;
+        }
+        _forceCompaction = false;
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -316,14 +429,39 @@ void OctreePersistThread::persist() {
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+            if (_journal) {
+                startJournal();
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+            // the pending journal edits went into the failed snapshot, retry the snapshot next time
+            _forceCompaction = true;
         }
 
         sendLatestEntityDataToDS();
     }
 }
 
+void OctreePersistThread::flushJournal() {
+    if (!_tree->writeToJournal(*_journal)) {
+        // the edits are still in the tree, have the next persist write a snapshot
+        qCWarning(octree) << "Failed to write journal" << _journal->getFileName();
+        _forceCompaction = true;
+    }
+}
+
+void OctreePersistThread::startJournal() {
+    // call right after writing a snapshot, or loading one whose journal was empty
+    PacketVersion contentVersion = versionForPacketType(_tree->expectedDataPacketType());
+    if (_journal->reset(_tree->getPersistID(), _tree->getPersistDataVersion(), contentVersion)) {
+        _tree->setWantJournal(true);
+    } else {
+        _tree->setWantJournal(false);
+    }
+    _lastSnapshotSize = QFileInfo(_filename).size();
+    _lastCompaction = std::chrono::steady_clock::now();
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
     auto nodeList = DependencyManager::get<NodeList>();
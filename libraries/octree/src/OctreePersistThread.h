@@ -14,9 +14,12 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <memory>
+
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeJournal.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -59,9 +62,14 @@ protected slots:
 
 protected:
     void persist();
+    void flushJournal();
+    void startJournal();
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
+    bool isPersistedAsSnapshot() const { return _persistAsFileType == "ents"; }
+    bool isSnapshotOfCurrentVersion() const;
+
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
 
@@ -79,6 +87,13 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    // with the snapshot format, edits are journaled in between snapshots - see OctreeJournal.h
+    std::unique_ptr<OctreeJournal> _journal;
+    std::chrono::steady_clock::time_point _lastJournalFlush;
+    std::chrono::steady_clock::time_point _lastCompaction;
+    qint64 _lastSnapshotSize { 0 };
+    bool _forceCompaction { false };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -12,6 +12,7 @@
 #ifndef hifi_OctreeQueryNode_h
 #define hifi_OctreeQueryNode_h
 
+#include <atomic>
 #include <iostream>
 
 #include <qqueue.h>
@@ -86,6 +87,13 @@ public:
     bool shouldForceFullScene() const { return _shouldForceFullScene; }
     void setShouldForceFullScene(bool shouldForceFullScene) { _shouldForceFullScene = shouldForceFullScene; }
 
+    // set by the send thread, for the server stats: how many items are waiting to be sent to this client, and the
+    // rate it is being sent at
+    int getSendBacklog() const { return _sendBacklog; }
+    void setSendBacklog(int sendBacklog) { _sendBacklog = sendBacklog; }
+    int getSendBytesPerSecond() const { return _sendBytesPerSecond; }
+    void setSendBytesPerSecond(int sendBytesPerSecond) { _sendBytesPerSecond = sendBytesPerSecond; }
+
 private:
     bool _viewSent { false };
     std::unique_ptr<NLPacket> _octreePacket;
@@ -118,6 +126,9 @@ private:
     QJsonObject _lastCheckJSONParameters;
 
     bool _shouldForceFullScene { false };
+
+    std::atomic<int> _sendBacklog { 0 };
+    std::atomic<int> _sendBytesPerSecond { 0 };
 };
 
 #endif // hifi_OctreeQueryNode_h
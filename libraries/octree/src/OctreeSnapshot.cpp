@@ -0,0 +1,210 @@
+//
+//  OctreeSnapshot.cpp
+//  libraries/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "OctreeLogging.h"
+
+using namespace OctreeSnapshot;
+
+static const int NUM_BYTES_ID = 16;
+
+static void writeID(uint8_t* destination, const QUuid& id) {
+    QByteArray bytes = id.toRfc4122();
+    memcpy(destination, bytes.constData(), NUM_BYTES_ID);
+}
+
+static QUuid readID(const uint8_t* source) {
+    return QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(source), NUM_BYTES_ID));
+}
+
+static bool lessByID(const IndexEntry& a, const IndexEntry& b) {
+    return memcmp(a.id, b.id, NUM_BYTES_ID) < 0;
+}
+
+bool OctreeSnapshot::isSnapshot(const QByteArray& data) {
+    return data.size() >= (int)sizeof(MAGIC) && memcmp(data.constData(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool OctreeSnapshot::readInfo(const QByteArray& data, QUuid& id, int64_t& dataVersion, PacketVersion& contentVersion) {
+    if (data.size() < (int)sizeof(Header) || !isSnapshot(data)) {
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, data.constData(), sizeof(Header));
+    if (header.formatVersion != FORMAT_VERSION) {
+        return false;
+    }
+
+    id = readID(header.id);
+    dataVersion = header.dataVersion;
+    contentVersion = (PacketVersion)header.contentVersion;
+    return true;
+}
+
+Writer::Writer(const QString& fileName, PacketVersion contentVersion, const QUuid& id, int64_t dataVersion) :
+    _file(fileName)
+{
+    memset(&_header, 0, sizeof(Header));
+    memcpy(_header.magic, MAGIC, sizeof(MAGIC));
+    _header.formatVersion = FORMAT_VERSION;
+    _header.contentVersion = contentVersion;
+    writeID(_header.id, id);
+    _header.dataVersion = dataVersion;
+}
+
+bool Writer::open() {
+    if (!_file.open(QIODevice::WriteOnly)) {
+        qCCritical(octree) << "Failed to open snapshot for writing:" << _file.fileName() << _file.errorString();
+        return false;
+    }
+
+    // the header is rewritten with the final counts and offsets on commit
+    _offset = sizeof(Header);
+    return _file.write(reinterpret_cast<const char*>(&_header), sizeof(Header)) == sizeof(Header);
+}
+
+bool Writer::addRecord(const QUuid& id, const QByteArray& record) {
+    IndexEntry entry;
+    writeID(entry.id, id);
+    entry.offset = _offset;
+    entry.size = (uint32_t)record.size();
+    entry.reserved = 0;
+
+    if (_file.write(record) != record.size()) {
+        return false;
+    }
+    _offset += record.size();
+    _index.push_back(entry);
+    return true;
+}
+
+bool Writer::commit() {
+    std::sort(_index.begin(), _index.end(), lessByID);
+
+    _header.numRecords = (uint32_t)_index.size();
+    _header.indexOffset = _offset;
+    _header.metadataOffset = _offset + _index.size() * sizeof(IndexEntry);
+    _header.metadataSize = (uint32_t)_metadata.size();
+
+    qint64 indexSize = (qint64)(_index.size() * sizeof(IndexEntry));
+    bool success = _file.write(reinterpret_cast<const char*>(_index.data()), indexSize) == indexSize &&
+        _file.write(_metadata) == _metadata.size() &&
+        _file.seek(0) &&
+        _file.write(reinterpret_cast<const char*>(&_header), sizeof(Header)) == sizeof(Header);
+
+    if (!success) {
+        qCCritical(octree) << "Failed to write snapshot:" << _file.fileName() << _file.errorString();
+        _file.cancelWriting();
+        _file.commit();
+        return false;
+    }
+
+    if (!_file.commit()) {
+        qCCritical(octree) << "Failed to commit snapshot:" << _file.fileName() << _file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool Reader::open(const QString& fileName) {
+    close();
+
+    _file.setFileName(fileName);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCCritical(octree) << "Cannot open snapshot for reading:" << fileName << _file.errorString();
+        return false;
+    }
+
+    _size = _file.size();
+    _data = _size > 0 ? _file.map(0, _size) : nullptr;
+    if (!_data) {
+        qCCritical(octree) << "Cannot map snapshot:" << fileName << _file.errorString();
+        close();
+        return false;
+    }
+
+    if (!validate()) {
+        qCCritical(octree) << "Snapshot is corrupt:" << fileName;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Reader::close() {
+    if (_data) {
+        _file.unmap(const_cast<uchar*>(_data));
+    }
+    _file.close();
+    _data = nullptr;
+    _size = 0;
+    _header = nullptr;
+    _index = nullptr;
+}
+
+bool Reader::validate() {
+    if (_size < (qint64)sizeof(Header)) {
+        return false;
+    }
+    _header = reinterpret_cast<const Header*>(_data);
+    if (memcmp(_header->magic, MAGIC, sizeof(MAGIC)) != 0 || _header->formatVersion != FORMAT_VERSION) {
+        return false;
+    }
+
+    // everything the header points at must lie within the file, so that the accessors don't have to check
+    uint64_t size = (uint64_t)_size;
+    uint64_t indexSize = (uint64_t)_header->numRecords * sizeof(IndexEntry);
+    if (_header->indexOffset > size || indexSize > size - _header->indexOffset ||
+        _header->metadataOffset > size || _header->metadataSize > size - _header->metadataOffset ||
+        _header->indexOffset % alignof(IndexEntry) != 0) {
+        return false;
+    }
+    _index = reinterpret_cast<const IndexEntry*>(_data + _header->indexOffset);
+
+    for (uint32_t i = 0; i < _header->numRecords; ++i) {
+        if (_index[i].offset > _header->indexOffset || _index[i].size > _header->indexOffset - _index[i].offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QUuid Reader::getID() const {
+    return readID(_header->id);
+}
+
+QUuid Reader::getRecordID(int record) const {
+    return readID(_index[record].id);
+}
+
+QByteArray Reader::getRecord(int record) const {
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(_data + _index[record].offset), _index[record].size);
+}
+
+int Reader::findRecord(const QUuid& id) const {
+    IndexEntry key;
+    writeID(key.id, id);
+
+    const IndexEntry* end = _index + _header->numRecords;
+    const IndexEntry* found = std::lower_bound(_index, end, key, lessByID);
+    if (found == end || memcmp(found->id, key.id, NUM_BYTES_ID) != 0) {
+        return -1;
+    }
+    return (int)(found - _index);
+}
+
+QByteArray Reader::getMetadata() const {
+    return QByteArray(reinterpret_cast<const char*>(_data + _header->metadataOffset), _header->metadataSize);
+}
@@ -0,0 +1,123 @@
+//
+//  OctreeSnapshot.h
+//  libraries/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSnapshot_h
+#define hifi_OctreeSnapshot_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QSaveFile>
+#include <QString>
+#include <QUuid>
+
+#include <udt/PacketHeaders.h>
+
+/// Binary persist format of an octree: a flat list of records, one per item, in the tree's own wire encoding,
+/// followed by an index of the records sorted by item ID and a metadata blob.
+///
+/// The file is memory mapped when read; records are only decoded when they are asked for. The records are only
+/// meaningful to the version of the wire encoding they were written with, so a snapshot of another content version
+/// can't be loaded - the JSON format is the interchange format between versions.
+///
+/// Layout, little-endian:
+///     Header          64 bytes, see below
+///     Records         numRecords byte strings, back to back
+///     Index           numRecords x { uint8_t id[16]; uint64_t offset; uint32_t size; uint32_t reserved; }
+///     Metadata        metadataSize bytes
+namespace OctreeSnapshot {
+
+static const char MAGIC[8] = { 'H', 'F', 'O', 'C', 'T', 'S', 'N', 'P' };
+static const uint32_t FORMAT_VERSION = 1;
+static const QString FILE_EXTENSION = "ents";
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t contentVersion; // version of the records' wire encoding
+    uint8_t id[16];
+    int64_t dataVersion;
+    uint32_t numRecords;
+    uint32_t metadataSize;
+    uint64_t indexOffset;
+    uint64_t metadataOffset;
+};
+static_assert(sizeof(Header) == 64, "OctreeSnapshot::Header must be packed");
+
+struct IndexEntry {
+    uint8_t id[16];
+    uint64_t offset;
+    uint32_t size;
+    uint32_t reserved;
+};
+static_assert(sizeof(IndexEntry) == 32, "OctreeSnapshot::IndexEntry must be packed");
+
+/// True if the data starts like a snapshot, whatever its versions
+bool isSnapshot(const QByteArray& data);
+
+/// Reads the ID and data version from the first bytes of a snapshot, without mapping it
+bool readInfo(const QByteArray& data, QUuid& id, int64_t& dataVersion, PacketVersion& contentVersion);
+
+class Writer {
+public:
+    Writer(const QString& fileName, PacketVersion contentVersion, const QUuid& id, int64_t dataVersion);
+
+    bool open();
+    bool addRecord(const QUuid& id, const QByteArray& record);
+    void setMetadata(const QByteArray& metadata) { _metadata = metadata; }
+
+    /// Writes the index and metadata, and atomically replaces the file
+    bool commit();
+
+private:
+    QSaveFile _file;
+    Header _header;
+    std::vector<IndexEntry> _index;
+    QByteArray _metadata;
+    uint64_t _offset { 0 };
+};
+
+class Reader {
+public:
+    ~Reader() { close(); }
+
+    bool open(const QString& fileName);
+    void close();
+
+    PacketVersion getContentVersion() const { return (PacketVersion)_header->contentVersion; }
+    QUuid getID() const;
+    int64_t getDataVersion() const { return _header->dataVersion; }
+
+    int getNumRecords() const { return (int)_header->numRecords; }
+    QUuid getRecordID(int record) const;
+
+    /// The record's bytes, pointing into the mapping - valid until the reader is closed
+    QByteArray getRecord(int record) const;
+
+    /// Index of the record of an item, or -1
+    int findRecord(const QUuid& id) const;
+
+    QByteArray getMetadata() const;
+
+private:
+    bool validate();
+
+    QFile _file;
+    const uchar* _data { nullptr };
+    qint64 _size { 0 };
+    const Header* _header { nullptr };
+    const IndexEntry* _index { nullptr };
+};
+
+}
+
+#endif // hifi_OctreeSnapshot_h
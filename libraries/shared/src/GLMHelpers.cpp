@@ -11,6 +11,7 @@
 
 #include "GLMHelpers.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -110,6 +111,78 @@ int unpackFloatVec3FromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm
     return sourceBuffer - startPosition;
 }
 
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+static inline __m128 selectFloats(__m128 mask, __m128 ifTrue, __m128 ifFalse) {
+    return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+static inline __m128i selectInts(__m128i mask, __m128i ifTrue, __m128i ifFalse) {
+    return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+}
+#endif
+
+int packFloatVec3sToSignedTwoByteFixed(unsigned char* destBuffer, const float* const components[3], int count, int radix) {
+    using FixedType = int16_t;
+    int n = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // the same operations as packFloatScalarToSignedTwoByteFixed(), for the same rounding
+    const __m128 scale = _mm_set1_ps((float)(1 << radix));
+    const __m128 minFixed = _mm_set1_ps((float)std::numeric_limits<FixedType>::min());
+    const __m128 maxFixed = _mm_set1_ps((float)std::numeric_limits<FixedType>::max());
+    for (; n + 4 <= count; n += 4) {
+        alignas(16) FixedType fixed[3][8];
+        for (int i = 0; i < 3; i++) {
+            __m128 value = _mm_mul_ps(_mm_loadu_ps(components[i] + n), scale);
+            __m128i fixed32 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(value, minFixed), maxFixed));
+            _mm_store_si128((__m128i*)fixed[i], _mm_packs_epi32(fixed32, fixed32));
+        }
+        for (int j = 0; j < 4; j++) {
+            for (int i = 0; i < 3; i++) {
+                memcpy(destBuffer, &fixed[i][j], sizeof(FixedType));
+                destBuffer += sizeof(FixedType);
+            }
+        }
+    }
+#endif
+    for (; n < count; n++) {
+        destBuffer += packFloatVec3ToSignedTwoByteFixed(destBuffer,
+            glm::vec3(components[0][n], components[1][n], components[2][n]), radix);
+    }
+    return count * 3 * (int)sizeof(FixedType);
+}
+
+int unpackFloatVec3sFromSignedTwoByteFixed(const unsigned char* sourceBuffer, float* const components[3], int count,
+                                           int radix) {
+    using FixedType = int16_t;
+    int n = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    const __m128 scale = _mm_set1_ps((float)(1 << radix));
+    for (; n + 4 <= count; n += 4) {
+        alignas(16) int32_t fixed[3][4];
+        for (int j = 0; j < 4; j++) {
+            for (int i = 0; i < 3; i++) {
+                FixedType twoByteFixed;
+                memcpy(&twoByteFixed, sourceBuffer, sizeof(FixedType));
+                fixed[i][j] = twoByteFixed;
+                sourceBuffer += sizeof(FixedType);
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            __m128 value = _mm_cvtepi32_ps(_mm_load_si128((const __m128i*)fixed[i]));
+            _mm_storeu_ps(components[i] + n, _mm_div_ps(value, scale));
+        }
+    }
+#endif
+    for (; n < count; n++) {
+        glm::vec3 vector;
+        sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, vector, radix);
+        components[0][n] = vector.x;
+        components[1][n] = vector.y;
+        components[2][n] = vector.z;
+    }
+    return count * 3 * (int)sizeof(FixedType);
+}
+
 int packFloatAngleToTwoByte(unsigned char* buffer, float degrees) {
     const float ANGLE_CONVERSION_RATIO = (std::numeric_limits<uint16_t>::max() / 360.0f);
 
@@ -231,6 +304,132 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+int packOrientationQuatsToSixBytes(unsigned char* buffer, const float* const components[4], int count) {
+    int n = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // the same constants and operations as packOrientationQuatToSixBytes(), for the same rounding
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t NUM_BITS_PER_COMPONENT = 15;
+    const uint32_t RANGE = (1 << NUM_BITS_PER_COMPONENT) - 1;
+    const __m128 magnitude = _mm_set1_ps(MAGNITUDE);
+    const __m128 twoMagnitude = _mm_set1_ps(2.0f * MAGNITUDE);
+    const __m128 range = _mm_set1_ps((float)RANGE);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128i lowBits = _mm_set1_epi32(0x7fff);
+
+    for (; n + 4 <= count; n += 4) {
+        __m128 q[4];
+        for (int i = 0; i < 4; i++) {
+            q[i] = _mm_loadu_ps(components[i] + n);
+        }
+
+        // find largest component, the first one of them on ties
+        __m128 largestMagnitude = _mm_andnot_ps(signBit, q[0]);
+        __m128 largest = q[0];
+        __m128i largestComponent = _mm_setzero_si128();
+        for (int i = 1; i < 4; i++) {
+            __m128 componentMagnitude = _mm_andnot_ps(signBit, q[i]);
+            __m128 isLarger = _mm_cmpgt_ps(componentMagnitude, largestMagnitude);
+            largestMagnitude = selectFloats(isLarger, componentMagnitude, largestMagnitude);
+            largest = selectFloats(isLarger, q[i], largest);
+            largestComponent = selectInts(_mm_castps_si128(isLarger), _mm_set1_epi32(i), largestComponent);
+        }
+
+        // ensure that the sign of the dropped component is always negative.
+        __m128 flip = _mm_and_ps(_mm_cmpgt_ps(largest, _mm_setzero_ps()), signBit);
+
+        // quantize the smallest three components, the j-th one is q[j] before the largest component and q[j + 1] after
+        __m128i quantized[3];
+        for (int j = 0; j < 3; j++) {
+            __m128 beforeLargest = _mm_castsi128_ps(_mm_cmpgt_epi32(largestComponent, _mm_set1_epi32(j)));
+            __m128 value = _mm_xor_ps(selectFloats(beforeLargest, q[j], q[j + 1]), flip);
+            value = _mm_div_ps(_mm_add_ps(value, magnitude), twoMagnitude);
+            quantized[j] = _mm_cvttps_epi32(_mm_mul_ps(value, range));
+        }
+
+        // encode the largestComponent into the high bits of the first two components
+        alignas(16) uint32_t encoded[3][4];
+        _mm_store_si128((__m128i*)encoded[0], _mm_or_si128(_mm_and_si128(quantized[0], lowBits),
+            _mm_slli_epi32(_mm_and_si128(largestComponent, _mm_set1_epi32(0x01)), 15)));
+        _mm_store_si128((__m128i*)encoded[1], _mm_or_si128(_mm_and_si128(quantized[1], lowBits),
+            _mm_slli_epi32(_mm_and_si128(largestComponent, _mm_set1_epi32(0x02)), 14)));
+        _mm_store_si128((__m128i*)encoded[2], quantized[2]);
+
+        for (int j = 0; j < 4; j++) {
+            buffer[0] = HI_BYTE(encoded[0][j]);
+            buffer[1] = LO_BYTE(encoded[0][j]);
+            buffer[2] = HI_BYTE(encoded[1][j]);
+            buffer[3] = LO_BYTE(encoded[1][j]);
+            buffer[4] = HI_BYTE(encoded[2][j]);
+            buffer[5] = LO_BYTE(encoded[2][j]);
+            buffer += 6;
+        }
+    }
+#endif
+    for (; n < count; n++) {
+        glm::quat quat;
+        for (int i = 0; i < 4; i++) {
+            quat[i] = components[i][n];
+        }
+        buffer += packOrientationQuatToSixBytes(buffer, quat);
+    }
+    return count * 6;
+}
+
+int unpackOrientationQuatsFromSixBytes(const unsigned char* buffer, float* const components[4], int count) {
+    int n = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // the same constants and operations as unpackOrientationQuatFromSixBytes(), for the same rounding
+    const uint32_t NUM_BITS_PER_COMPONENT = 15;
+    const float RANGE = (float)((1 << NUM_BITS_PER_COMPONENT) - 1);
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const __m128 magnitude = _mm_set1_ps(MAGNITUDE);
+    const __m128 twoMagnitude = _mm_set1_ps(2.0f * MAGNITUDE);
+    const __m128 range = _mm_set1_ps(RANGE);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    for (; n + 4 <= count; n += 4) {
+        alignas(16) int32_t stored[3][4];
+        alignas(16) int32_t largest[4];
+        for (int j = 0; j < 4; j++) {
+            stored[0][j] = ((0x7f & buffer[0]) << 8) | buffer[1];
+            stored[1][j] = ((0x7f & buffer[2]) << 8) | buffer[3];
+            stored[2][j] = ((0x7f & buffer[4]) << 8) | buffer[5];
+            largest[j] = ((0x80 & buffer[2]) >> 6) | ((0x80 & buffer[0]) >> 7);
+            buffer += 6;
+        }
+
+        __m128 floatComponents[3];
+        for (int i = 0; i < 3; i++) {
+            __m128 value = _mm_div_ps(_mm_cvtepi32_ps(_mm_load_si128((const __m128i*)stored[i])), range);
+            floatComponents[i] = _mm_sub_ps(_mm_mul_ps(value, twoMagnitude), magnitude);
+        }
+
+        // missingComponent is always negative.
+        __m128 missingComponent = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(floatComponents[0], floatComponents[0]));
+        missingComponent = _mm_sub_ps(missingComponent, _mm_mul_ps(floatComponents[1], floatComponents[1]));
+        missingComponent = _mm_sub_ps(missingComponent, _mm_mul_ps(floatComponents[2], floatComponents[2]));
+        missingComponent = _mm_xor_ps(_mm_sqrt_ps(missingComponent), signBit);
+
+        __m128i largestComponent = _mm_load_si128((const __m128i*)largest);
+        for (int i = 0; i < 4; i++) {
+            __m128 afterLargest = _mm_castsi128_ps(_mm_cmplt_epi32(largestComponent, _mm_set1_epi32(i)));
+            __m128 isLargest = _mm_castsi128_ps(_mm_cmpeq_epi32(largestComponent, _mm_set1_epi32(i)));
+            __m128 value = selectFloats(afterLargest, floatComponents[std::max(i - 1, 0)], floatComponents[std::min(i, 2)]);
+            _mm_storeu_ps(components[i] + n, selectFloats(isLargest, missingComponent, value));
+        }
+    }
+#endif
+    for (; n < count; n++) {
+        glm::quat quat;
+        buffer += unpackOrientationQuatFromSixBytes(buffer, quat);
+        for (int i = 0; i < 4; i++) {
+            components[i][n] = quat[i];
+        }
+    }
+    return count * 6;
+}
+
 bool closeEnough(float a, float b, float relativeError) {
     assert(relativeError >= 0.0f);
     // NOTE: we add EPSILON to the denominator so we can avoid checking for division by zero.
@@ -118,6 +118,12 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// Batches of the above, for the joints of an avatar: the quaternions are passed as one array per component, the
+// n-th quaternion being (components[0][n], components[1][n], components[2][n], components[3][n]) in glm::quat
+// index order. The bytes are the same as packing the quaternions one after the other, four at a time with SSE2.
+int packOrientationQuatsToSixBytes(unsigned char* buffer, const float* const components[4], int count);
+int unpackOrientationQuatsFromSixBytes(const unsigned char* buffer, float* const components[4], int count);
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -140,6 +146,11 @@ int unpackFloatScalarFromSignedTwoByteFixed(const int16_t* byteFixedPointer, flo
 int packFloatVec3ToSignedTwoByteFixed(unsigned char* destBuffer, const glm::vec3& srcVector, int radix);
 int unpackFloatVec3FromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm::vec3& destination, int radix);
 
+// Batches of the above, with the vec3's passed as one array per component like the quaternions above
+int packFloatVec3sToSignedTwoByteFixed(unsigned char* destBuffer, const float* const components[3], int count, int radix);
+int unpackFloatVec3sFromSignedTwoByteFixed(const unsigned char* sourceBuffer, float* const components[3], int count,
+                                           int radix);
+
 bool closeEnough(float a, float b, float relativeError);
 
 /// \return vec3 with euler angles in radians
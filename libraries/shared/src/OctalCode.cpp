@@ -75,6 +75,17 @@ int branchIndexWithDescendant(const unsigned char* ancestorOctalCode, const unsi
 }
 
 unsigned char* childOctalCode(const unsigned char* parentOctalCode, int childNumber) {
+    int parentCodeSections = parentOctalCode
+        ? numberOfThreeBitSectionsInCode(parentOctalCode)
+        : 0;
+
+    // create a new buffer to hold the new octal code
+    unsigned char* newCode = new unsigned char[bytesRequiredForCodeLength(parentCodeSections + 1)];
+    childOctalCode(parentOctalCode, childNumber, newCode);
+    return newCode;
+}
+
+void childOctalCode(const unsigned char* parentOctalCode, int childNumber, unsigned char* newCode) {
 
     // find the length (in number of three bit code sequences)
     // in the parent
@@ -88,9 +99,6 @@ unsigned char* childOctalCode(const unsigned char* parentOctalCode, int childNum
     // child code will have one more section than the parent
     size_t childCodeBytes = bytesRequiredForCodeLength(parentCodeSections + 1);
 
-    // create a new buffer to hold the new octal code
-    unsigned char* newCode = new unsigned char[childCodeBytes];
-
     // copy the parent code to the child
     if (parentOctalCode) {
         memcpy(newCode, parentOctalCode, parentCodeBytes);
@@ -124,8 +132,6 @@ unsigned char* childOctalCode(const unsigned char* parentOctalCode, int childNum
         // no wraparound, left shift and add
         newCode[(startBit / 8) + 1] += (childNumber << leftShift);
     }
-
-    return newCode;
 }
 
 void voxelDetailsForCode(const unsigned char* octalCode, VoxelPositionSize& voxelPositionSize) {
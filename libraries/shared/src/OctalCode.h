@@ -32,6 +32,10 @@ size_t bytesRequiredForCodeLength(unsigned char threeBitCodes);
 int branchIndexWithDescendant(const unsigned char* ancestorOctalCode, const unsigned char* descendantOctalCode);
 unsigned char* childOctalCode(const unsigned char* parentOctalCode, int childNumber);
 
+/// Writes the code of the child into a buffer of at least bytesRequiredForCodeLength() of the child's sections
+void childOctalCode(const unsigned char* parentOctalCode, int childNumber, unsigned char* destination);
+const size_t MAX_CHILD_OCTAL_CODE_BYTES = 1 + (255 * BITS_IN_OCTAL + 7) / 8;
+
 const int OVERFLOWED_OCTCODE_BUFFER = -1;
 const int UNKNOWN_OCTCODE_LENGTH = -2;
 
@@ -0,0 +1,172 @@
+//
+//  RangeCoder.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RangeCoder.h"
+
+const int BitModel::BITS;
+const int BitModel::ADAPT_SHIFT;
+const int IntModel::MAX_BITS;
+const int32_t IntModel::MAX_MAGNITUDE;
+
+// the range is kept above TOP by shifting out a byte at a time
+static const uint32_t TOP = 1 << 24;
+static const uint32_t ONE = 1 << BitModel::BITS;
+
+void RangeEncoder::encodeBit(BitModel& model, int bit) {
+    uint32_t bound = (_range >> BitModel::BITS) * model.probability;
+    if (bit == 0) {
+        _range = bound;
+        model.probability += (ONE - model.probability) >> BitModel::ADAPT_SHIFT;
+    } else {
+        _low += bound;
+        _range -= bound;
+        model.probability -= model.probability >> BitModel::ADAPT_SHIFT;
+    }
+    while (_range < TOP) {
+        _range <<= 8;
+        shiftLow();
+    }
+}
+
+void RangeEncoder::encodeDirectBits(uint32_t value, int numBits) {
+    while (numBits > 0) {
+        --numBits;
+        _range >>= 1;
+        if ((value >> numBits) & 1) {
+            _low += _range;
+        }
+        if (_range < TOP) {
+            _range <<= 8;
+            shiftLow();
+        }
+    }
+}
+
+void RangeEncoder::flush() {
+    int start = _output.size();
+    for (int i = 0; i < 5; ++i) {
+        shiftLow();
+    }
+    // the decoder reads zeros past the end, so the trailing ones need not be sent
+    int end = _output.size();
+    while (end > start && _output.at(end - 1) == 0) {
+        --end;
+    }
+    _output.truncate(end);
+}
+
+void RangeEncoder::shiftLow() {
+    // a byte is held back in the cache, along with any 0xFF bytes after it, until it is known whether a carry
+    // will propagate into it
+    if ((uint32_t)_low < 0xFF000000 || (_low >> 32) != 0) {
+        uint8_t carry = (uint8_t)(_low >> 32);
+        uint8_t byte = _cache;
+        do {
+            // the first byte is always zero, the decoder does not read it
+            if (!_isFirstByte) {
+                _output.append((char)(uint8_t)(byte + carry));
+            }
+            _isFirstByte = false;
+            byte = 0xFF;
+        } while (--_cacheSize != 0);
+        _cache = (uint8_t)(_low >> 24);
+    }
+    ++_cacheSize;
+    _low = (_low & 0x00FFFFFF) << 8;
+}
+
+RangeDecoder::RangeDecoder(const unsigned char* data, int size) :
+    _next(data),
+    _end(data + (size > 0 ? size : 0))
+{
+    for (int i = 0; i < 4; ++i) {
+        _code = (_code << 8) | nextByte();
+    }
+}
+
+int RangeDecoder::decodeBit(BitModel& model) {
+    uint32_t bound = (_range >> BitModel::BITS) * model.probability;
+    int bit;
+    if (_code < bound) {
+        _range = bound;
+        model.probability += (ONE - model.probability) >> BitModel::ADAPT_SHIFT;
+        bit = 0;
+    } else {
+        _code -= bound;
+        _range -= bound;
+        model.probability -= model.probability >> BitModel::ADAPT_SHIFT;
+        bit = 1;
+    }
+    while (_range < TOP) {
+        _range <<= 8;
+        _code = (_code << 8) | nextByte();
+    }
+    return bit;
+}
+
+uint32_t RangeDecoder::decodeDirectBits(int numBits) {
+    uint32_t value = 0;
+    while (numBits > 0) {
+        --numBits;
+        _range >>= 1;
+        uint32_t bit = 0;
+        if (_code >= _range) {
+            _code -= _range;
+            bit = 1;
+        }
+        value = (value << 1) | bit;
+        if (_range < TOP) {
+            _range <<= 8;
+            _code = (_code << 8) | nextByte();
+        }
+    }
+    return value;
+}
+
+int32_t IntModel::encode(RangeEncoder& encoder, int32_t value) {
+    if (value == 0) {
+        encoder.encodeBit(_isNonZero, 0);
+        return 0;
+    }
+    encoder.encodeBit(_isNonZero, 1);
+    encoder.encodeBit(_isNegative, value < 0 ? 1 : 0);
+
+    uint32_t magnitude = value < 0 ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+    if (magnitude > (uint32_t)MAX_MAGNITUDE) {
+        magnitude = MAX_MAGNITUDE;
+    }
+    int numBits = 1;
+    while ((magnitude >> numBits) != 0) {
+        ++numBits;
+    }
+    for (int i = 1; i < numBits; ++i) {
+        encoder.encodeBit(_length[i - 1], 1);
+    }
+    if (numBits < MAX_BITS) {
+        encoder.encodeBit(_length[numBits - 1], 0);
+    }
+    // the leading one is implied by the length
+    encoder.encodeDirectBits(magnitude, numBits - 1);
+
+    return value < 0 ? -(int32_t)magnitude : (int32_t)magnitude;
+}
+
+int32_t IntModel::decode(RangeDecoder& decoder) {
+    if (decoder.decodeBit(_isNonZero) == 0) {
+        return 0;
+    }
+    bool isNegative = decoder.decodeBit(_isNegative) != 0;
+    int numBits = 1;
+    while (numBits < MAX_BITS && decoder.decodeBit(_length[numBits - 1]) != 0) {
+        ++numBits;
+    }
+    int32_t magnitude = (int32_t)((1U << (numBits - 1)) | decoder.decodeDirectBits(numBits - 1));
+    return isNegative ? -magnitude : magnitude;
+}
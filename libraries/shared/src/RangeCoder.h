@@ -0,0 +1,89 @@
+//
+//  RangeCoder.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RangeCoder_h
+#define hifi_RangeCoder_h
+
+#include <cstdint>
+
+#include <QByteArray>
+
+/// An adaptive binary range coder, as in LZMA: every bit is coded with the probability of its model, which the encoder
+/// and the decoder both adapt to the bits seen so far, so that a bit that is nearly always the same costs a small
+/// fraction of a bit. Small enough to code the values of a single packet.
+
+/// The probability of a bit to be zero, out of 1 << BITS
+class BitModel {
+public:
+    static const int BITS = 11;
+    static const int ADAPT_SHIFT = 5;
+
+    uint16_t probability { 1 << (BITS - 1) };
+};
+
+class RangeEncoder {
+public:
+    /// The coded bytes are appended to the output when flushed
+    RangeEncoder(QByteArray& output) : _output(output) {}
+
+    void encodeBit(BitModel& model, int bit);
+
+    /// The low numBits bits of value, each at even odds
+    void encodeDirectBits(uint32_t value, int numBits);
+
+    void flush();
+
+private:
+    void shiftLow();
+
+    QByteArray& _output;
+    uint64_t _low { 0 };
+    uint32_t _range { 0xFFFFFFFF };
+    uint8_t _cache { 0 };
+    int _cacheSize { 1 };
+    bool _isFirstByte { true };
+};
+
+class RangeDecoder {
+public:
+    /// Past the end of the data, the decoder reads zeros: a truncated or corrupt input decodes to wrong values, never
+    /// to a read out of the buffer
+    RangeDecoder(const unsigned char* data, int size);
+
+    int decodeBit(BitModel& model);
+    uint32_t decodeDirectBits(int numBits);
+
+private:
+    uint8_t nextByte() { return _next < _end ? *_next++ : 0; }
+
+    const unsigned char* _next;
+    const unsigned char* _end;
+    uint32_t _range { 0xFFFFFFFF };
+    uint32_t _code { 0 };
+};
+
+/// Signed integers that are mostly small: a zero flag, a sign, the length of the magnitude in unary and its bits
+/// below the leading one. Magnitudes are clamped to MAX_BITS bits.
+class IntModel {
+public:
+    static const int MAX_BITS = 24;
+    static const int32_t MAX_MAGNITUDE = (1 << MAX_BITS) - 1;
+
+    /// Returns the value as it will be decoded, after clamping
+    int32_t encode(RangeEncoder& encoder, int32_t value);
+    int32_t decode(RangeDecoder& decoder);
+
+private:
+    BitModel _isNonZero;
+    BitModel _isNegative;
+    BitModel _length[MAX_BITS - 1];
+};
+
+#endif // hifi_RangeCoder_h
@@ -0,0 +1,107 @@
+//
+//  SlabAllocator.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SlabAllocator.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+const size_t SlabPool::GRANULARITY;
+const size_t SlabPool::MAX_BLOCK_SIZE;
+const size_t SlabPool::SLAB_SIZE;
+
+static_assert(SlabPool::GRANULARITY % alignof(std::max_align_t) == 0, "blocks must be aligned for any type");
+
+namespace {
+
+const size_t NUM_POOLS = SlabPool::MAX_BLOCK_SIZE / SlabPool::GRANULARITY;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct Pool {
+    std::mutex mutex;
+    FreeBlock* freeBlocks { nullptr };
+    char* next { nullptr }; // never allocated part of the last slab
+    char* end { nullptr };
+};
+
+std::atomic<size_t> reservedBytes { 0 };
+std::atomic<size_t> allocatedBytes { 0 };
+
+Pool& poolForSize(size_t size) {
+    // never destroyed, as blocks may still be released while other statics are destroyed at exit
+    static Pool* pools = new Pool[NUM_POOLS];
+    return pools[(size - 1) / SlabPool::GRANULARITY];
+}
+
+}
+
+void* SlabPool::allocate(size_t size) {
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > MAX_BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+
+    size_t blockSize = (size + GRANULARITY - 1) / GRANULARITY * GRANULARITY;
+    Pool& pool = poolForSize(size);
+    void* block;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (pool.freeBlocks) {
+            block = pool.freeBlocks;
+            pool.freeBlocks = pool.freeBlocks->next;
+        } else {
+            if (pool.next + blockSize > pool.end) {
+                pool.next = static_cast<char*>(::operator new(SLAB_SIZE));
+                pool.end = pool.next + SLAB_SIZE / blockSize * blockSize;
+                reservedBytes += SLAB_SIZE;
+            }
+            block = pool.next;
+            pool.next += blockSize;
+        }
+    }
+    allocatedBytes += blockSize;
+    return block;
+}
+
+void SlabPool::release(void* block, size_t size) {
+    if (!block) {
+        return;
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > MAX_BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+
+    Pool& pool = poolForSize(size);
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+        freeBlock->next = pool.freeBlocks;
+        pool.freeBlocks = freeBlock;
+    }
+    allocatedBytes -= (size + GRANULARITY - 1) / GRANULARITY * GRANULARITY;
+}
+
+size_t SlabPool::getReservedBytes() {
+    return reservedBytes;
+}
+
+size_t SlabPool::getAllocatedBytes() {
+    return allocatedBytes;
+}
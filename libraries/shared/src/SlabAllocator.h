@@ -0,0 +1,60 @@
+//
+//  SlabAllocator.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SlabAllocator_h
+#define hifi_SlabAllocator_h
+
+#include <cstddef>
+
+/// Pools of small fixed size blocks, carved out of large slabs, for the objects that a structure like a tree allocates
+/// one at a time by the million: one call to the system allocator per slab instead of one per object, and objects
+/// allocated together end up next to each other in memory.
+///
+/// There is one pool per multiple of GRANULARITY bytes, up to MAX_BLOCK_SIZE; bigger blocks go to the system allocator.
+/// Released blocks are kept for the next allocation of their size, the slabs are never given back to the system.
+///
+/// All functions are thread safe, a block can be released from another thread than the one that allocated it.
+class SlabPool {
+public:
+    static const size_t GRANULARITY = 16;
+    static const size_t MAX_BLOCK_SIZE = 1024;
+    static const size_t SLAB_SIZE = 64 * 1024;
+
+    static void* allocate(size_t size);
+
+    /// The size must be the one the block was allocated with
+    static void release(void* block, size_t size);
+
+    /// Bytes of the slabs taken from the system, and of the blocks currently allocated in them
+    static size_t getReservedBytes();
+    static size_t getAllocatedBytes();
+};
+
+/// Standard allocator over SlabPool, e.g. for the control blocks of shared pointers:
+///     std::shared_ptr<T>(new T(), std::default_delete<T>(), SlabAllocator<T>())
+template <typename T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    SlabAllocator() = default;
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>&) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(SlabPool::allocate(count * sizeof(T))); }
+    void deallocate(T* pointer, size_t count) { SlabPool::release(pointer, count * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const SlabAllocator<U>&) const { return false; }
+};
+
+#endif // hifi_SlabAllocator_h
@@ -0,0 +1,269 @@
+//
+//  UuidHashMap.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UuidHashMap_h
+#define hifi_UuidHashMap_h
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <QUuid>
+
+/// Hash map keyed by QUuid, with open addressing: the keys and values are stored inline in a single flat array,
+/// and a parallel array of one byte tags lets a lookup skip most of the slots it probes without touching them.
+///
+/// Slots are probed linearly, and removals shift the following entries back rather than leaving tombstones, so
+/// that lookups stay short however many entries come and go.
+///
+/// The null QUuid is not a valid key. Like the Qt containers, it is not thread safe, but const methods can be called
+/// from any number of threads at once - e.g. under the read side of a QReadWriteLock.
+template <typename T>
+class UuidHashMap {
+    struct Slot {
+        QUuid key;
+        T value {};
+    };
+
+    template <typename S, typename V>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator(const uint8_t* tags, S* slots, size_t index, size_t capacity) :
+            _tags(tags), _slots(slots), _index(index), _capacity(capacity) { skipEmpty(); }
+
+        const QUuid& key() const { return _slots[_index].key; }
+        V& value() const { return _slots[_index].value; }
+
+        V& operator*() const { return value(); }
+        V* operator->() const { return &value(); }
+        Iterator& operator++() { ++_index; skipEmpty(); return *this; }
+        Iterator operator++(int) { Iterator result = *this; ++(*this); return result; }
+        bool operator==(const Iterator& other) const { return _index == other._index; }
+        bool operator!=(const Iterator& other) const { return _index != other._index; }
+
+    private:
+        void skipEmpty() {
+            while (_index < _capacity && _tags[_index] == EMPTY) {
+                ++_index;
+            }
+        }
+
+        const uint8_t* _tags;
+        S* _slots;
+        size_t _index;
+        size_t _capacity;
+    };
+
+public:
+    using iterator = Iterator<Slot, T>;
+    using const_iterator = Iterator<const Slot, const T>;
+
+    int size() const { return (int)_size; }
+    bool isEmpty() const { return _size == 0; }
+
+    /// The value of the key, or a default constructed value if there is none
+    T value(const QUuid& key) const {
+        const T* found = find(key);
+        return found ? *found : T();
+    }
+
+    /// Pointer to the value of the key, or nullptr - valid until the map is changed
+    const T* find(const QUuid& key) const {
+        size_t index = indexOf(key);
+        return index != NOT_FOUND ? &_slots[index].value : nullptr;
+    }
+    T* find(const QUuid& key) { return const_cast<T*>(static_cast<const UuidHashMap*>(this)->find(key)); }
+
+    bool contains(const QUuid& key) const { return find(key) != nullptr; }
+
+    /// Sets the value of the key, replacing its previous value if it has one
+    void insert(const QUuid& key, T value);
+
+    /// Returns false if there was no value for the key
+    bool remove(const QUuid& key);
+
+    void clear();
+    void reserve(int size);
+    void swap(UuidHashMap& other);
+
+    iterator begin() { return iterator(_tags.data(), _slots.data(), 0, _tags.size()); }
+    iterator end() { return iterator(_tags.data(), _slots.data(), _tags.size(), _tags.size()); }
+    const_iterator begin() const { return const_iterator(_tags.data(), _slots.data(), 0, _tags.size()); }
+    const_iterator end() const { return const_iterator(_tags.data(), _slots.data(), _tags.size(), _tags.size()); }
+
+private:
+    static const uint8_t EMPTY = 0;
+    static const size_t MIN_CAPACITY = 16;
+    static const size_t NOT_FOUND = (size_t)-1;
+
+    static uint64_t hash(const QUuid& key);
+    static uint8_t tagOf(uint64_t hash) { return (uint8_t)(0x80 | (hash >> 57)); }
+    size_t mask() const { return _tags.size() - 1; }
+    size_t indexOf(const QUuid& key) const;
+
+    // the table is kept at most 3/4 full
+    bool isFull(size_t size) const { return size * 4 > _tags.size() * 3; }
+    void rehash(size_t capacity);
+
+    std::vector<uint8_t> _tags; // EMPTY, or the high bits of the hash of the slot's key
+    std::vector<Slot> _slots;
+    size_t _size { 0 };
+};
+
+template <typename T>
+const uint8_t UuidHashMap<T>::EMPTY;
+template <typename T>
+const size_t UuidHashMap<T>::MIN_CAPACITY;
+template <typename T>
+const size_t UuidHashMap<T>::NOT_FOUND;
+
+template <typename T>
+inline uint64_t UuidHashMap<T>::hash(const QUuid& key) {
+    static_assert(sizeof(QUuid) == 2 * sizeof(uint64_t), "QUuid must be 128 bits");
+
+    // entity IDs are random already, the halves only need folding and spreading over the low bits of the index
+    uint64_t halves[2];
+    memcpy(halves, &key, sizeof(halves));
+    uint64_t result = halves[0] ^ (halves[1] * 0x9E3779B97F4A7C15ULL);
+    result ^= result >> 32;
+    result *= 0xD6E8FEB86659FD93ULL;
+    result ^= result >> 32;
+    return result;
+}
+
+template <typename T>
+size_t UuidHashMap<T>::indexOf(const QUuid& key) const {
+    if (_size == 0) {
+        return NOT_FOUND;
+    }
+
+    uint64_t keyHash = hash(key);
+    uint8_t tag = tagOf(keyHash);
+    size_t mask = this->mask();
+    for (size_t i = keyHash & mask; ; i = (i + 1) & mask) {
+        uint8_t slotTag = _tags[i];
+        if (slotTag == EMPTY) {
+            return NOT_FOUND;
+        }
+        if (slotTag == tag && _slots[i].key == key) {
+            return i;
+        }
+    }
+}
+
+template <typename T>
+void UuidHashMap<T>::insert(const QUuid& key, T value) {
+    assert(!key.isNull());
+
+    if (_tags.empty() || isFull(_size + 1)) {
+        rehash(_tags.empty() ? MIN_CAPACITY : _tags.size() * 2);
+    }
+
+    uint64_t keyHash = hash(key);
+    uint8_t tag = tagOf(keyHash);
+    size_t mask = this->mask();
+    for (size_t i = keyHash & mask; ; i = (i + 1) & mask) {
+        uint8_t slotTag = _tags[i];
+        if (slotTag == EMPTY) {
+            _tags[i] = tag;
+            _slots[i].key = key;
+            _slots[i].value = std::move(value);
+            ++_size;
+            return;
+        }
+        if (slotTag == tag && _slots[i].key == key) {
+            _slots[i].value = std::move(value);
+            return;
+        }
+    }
+}
+
+template <typename T>
+bool UuidHashMap<T>::remove(const QUuid& key) {
+    size_t hole = indexOf(key);
+    if (hole == NOT_FOUND) {
+        return false;
+    }
+
+    size_t mask = this->mask();
+
+    // shift back the entries after the hole that would no longer be found past it
+    for (size_t i = (hole + 1) & mask; _tags[i] != EMPTY; i = (i + 1) & mask) {
+        size_t home = hash(_slots[i].key) & mask;
+        bool homeAfterHole = ((i - home) & mask) < ((i - hole) & mask);
+        if (!homeAfterHole) {
+            _tags[hole] = _tags[i];
+            _slots[hole] = std::move(_slots[i]);
+            hole = i;
+        }
+    }
+
+    _tags[hole] = EMPTY;
+    _slots[hole] = Slot();
+    --_size;
+    return true;
+}
+
+template <typename T>
+void UuidHashMap<T>::clear() {
+    _tags.clear();
+    _slots.clear();
+    _size = 0;
+}
+
+template <typename T>
+void UuidHashMap<T>::reserve(int size) {
+    size_t capacity = _tags.empty() ? MIN_CAPACITY : _tags.size();
+    while ((size_t)size * 4 > capacity * 3) {
+        capacity *= 2;
+    }
+    if (capacity != _tags.size()) {
+        rehash(capacity);
+    }
+}
+
+template <typename T>
+void UuidHashMap<T>::swap(UuidHashMap& other) {
+    _tags.swap(other._tags);
+    _slots.swap(other._slots);
+    std::swap(_size, other._size);
+}
+
+template <typename T>
+void UuidHashMap<T>::rehash(size_t capacity) {
+    std::vector<uint8_t> oldTags(capacity, EMPTY);
+    std::vector<Slot> oldSlots(capacity);
+    oldTags.swap(_tags);
+    oldSlots.swap(_slots);
+
+    size_t mask = this->mask();
+    for (size_t j = 0; j < oldTags.size(); ++j) {
+        if (oldTags[j] == EMPTY) {
+            continue;
+        }
+        size_t i = hash(oldSlots[j].key) & mask;
+        while (_tags[i] != EMPTY) {
+            i = (i + 1) & mask;
+        }
+        _tags[i] = oldTags[j];
+        _slots[i] = std::move(oldSlots[j]);
+    }
+}
+
+#endif // hifi_UuidHashMap_h
@@ -0,0 +1,158 @@
+//
+//  WorkStealingScheduler.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingScheduler.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "PortableHighResolutionClock.h"
+
+static uint64_t usecsNow() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+void WorkStealingScheduler::setNumWorkers(int numWorkers) {
+    numWorkers = std::max(numWorkers, 1);
+    while ((int)_workers.size() > numWorkers) {
+        _workers.pop_back();
+    }
+    while ((int)_workers.size() < numWorkers) {
+        _workers.emplace_back(new Worker());
+    }
+}
+
+void WorkStealingScheduler::schedule(const std::vector<float>& costs) {
+    int numJobs = (int)costs.size();
+    int numWorkers = (int)_workers.size();
+
+    _jobCosts.assign(numJobs, 0.0f);
+    _batchStart = usecsNow();
+    for (auto& worker : _workers) {
+        worker->batchBusyUsecs = 0;
+    }
+
+    if (numJobs == 0) {
+        return;
+    }
+
+    // jobs we know nothing about are assumed to be average
+    float knownCost = 0.0f;
+    int numKnown = 0;
+    for (float cost : costs) {
+        if (cost > 0.0f) {
+            knownCost += cost;
+            ++numKnown;
+        }
+    }
+    float defaultCost = numKnown > 0 ? knownCost / numKnown : 1.0f;
+    auto costOf = [&](int job) {
+        return costs[job] > 0.0f ? costs[job] : defaultCost;
+    };
+
+    _order.resize(numJobs);
+    std::iota(_order.begin(), _order.end(), 0);
+    std::stable_sort(_order.begin(), _order.end(), [&](int a, int b) {
+        return costOf(a) > costOf(b);
+    });
+
+    float totalCost = knownCost + (numJobs - numKnown) * defaultCost;
+    float chunkCost = totalCost / (numWorkers * CHUNKS_PER_WORKER);
+
+    // deal the chunks out to the least loaded worker, in order of decreasing cost
+    std::vector<float> load(numWorkers, 0.0f);
+    int begin = 0;
+    float cost = 0.0f;
+    for (int i = 0; i < numJobs; ++i) {
+        cost += costOf(_order[i]);
+        if (cost >= chunkCost || i == numJobs - 1) {
+            int worker = (int)(std::min_element(load.begin(), load.end()) - load.begin());
+            load[worker] += cost;
+            {
+                std::lock_guard<std::mutex> lock(_workers[worker]->mutex);
+                _workers[worker]->chunks.push_back({ begin, i + 1 });
+            }
+            begin = i + 1;
+            cost = 0.0f;
+        }
+    }
+}
+
+void WorkStealingScheduler::run(int worker, const Job& job) {
+    auto& state = *_workers[worker];
+
+    Chunk chunk;
+    while (popChunk(worker, chunk) || stealChunk(worker, chunk)) {
+        for (int i = chunk.begin; i < chunk.end; ++i) {
+            int jobIndex = _order[i];
+
+            uint64_t start = usecsNow();
+            job(jobIndex);
+            uint64_t elapsed = usecsNow() - start;
+
+            // each job runs exactly once per batch, so the workers never write the same cost
+            _jobCosts[jobIndex] = (float)std::max(elapsed, (uint64_t)1);
+            state.batchBusyUsecs += elapsed;
+            ++state.stats.numJobs;
+        }
+    }
+}
+
+void WorkStealingScheduler::finish() {
+    uint64_t elapsed = usecsNow() - _batchStart;
+
+    for (auto& worker : _workers) {
+        // whatever part of the batch a worker didn't spend running jobs, it spent waiting for the others
+        worker->stats.busyUsecs += worker->batchBusyUsecs;
+        worker->stats.idleUsecs += elapsed - std::min(elapsed, worker->batchBusyUsecs);
+    }
+}
+
+bool WorkStealingScheduler::popChunk(int worker, Chunk& chunk) {
+    auto& state = *_workers[worker];
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.chunks.empty()) {
+        return false;
+    }
+    chunk = state.chunks.front();
+    state.chunks.pop_front();
+    return true;
+}
+
+bool WorkStealingScheduler::stealChunk(int worker, Chunk& chunk) {
+    int numWorkers = (int)_workers.size();
+    for (int i = 1; i < numWorkers; ++i) {
+        auto& victim = *_workers[(worker + i) % numWorkers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            ++_workers[worker]->stats.numSteals;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<WorkStealingScheduler::WorkerStats> WorkStealingScheduler::getWorkerStats() const {
+    std::vector<WorkerStats> stats;
+    stats.reserve(_workers.size());
+    for (const auto& worker : _workers) {
+        stats.push_back(worker->stats);
+    }
+    return stats;
+}
+
+void WorkStealingScheduler::resetWorkerStats() {
+    for (auto& worker : _workers) {
+        worker->stats = WorkerStats();
+    }
+}
@@ -0,0 +1,85 @@
+//
+//  WorkStealingScheduler.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingScheduler_h
+#define hifi_WorkStealingScheduler_h
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// Distributes a batch of jobs of uneven cost over a fixed set of workers.
+///
+/// The jobs are sorted by their estimated cost and packed into chunks of roughly even cost - expensive jobs get a
+/// chunk of their own, cheap ones are grouped - and the chunks are dealt to per-worker deques, each chunk going to
+/// the least loaded worker. A worker drains its own deque from the front (largest chunks first) and then steals
+/// from the back of the other deques, so that the estimation error is evened out with the smallest chunks.
+///
+/// The time each job took is recorded and can be fed back as its cost estimate for the next batch.
+///
+/// schedule() and finish() must be called from a single thread while the workers are idle; run() is called by
+/// each worker, with its own index, in between.
+class WorkStealingScheduler {
+public:
+    using Job = std::function<void(int job)>;
+
+    struct WorkerStats {
+        uint64_t busyUsecs { 0 }; // running jobs
+        uint64_t idleUsecs { 0 }; // out of jobs, waiting for the other workers to finish the batch
+        uint64_t numJobs { 0 };
+        uint64_t numSteals { 0 };
+    };
+
+    void setNumWorkers(int numWorkers);
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+    /// Deals out a batch of jobs 0 to costs.size() - 1. Costs are in any unit, zero means unknown.
+    void schedule(const std::vector<float>& costs);
+
+    /// Runs jobs until there are none left to run or to steal
+    void run(int worker, const Job& job);
+
+    /// Closes the batch, accounting the idle time of the workers
+    void finish();
+
+    /// Time in usecs that a job of the last batch took to run
+    float getJobCost(int job) const { return _jobCosts[job]; }
+
+    std::vector<WorkerStats> getWorkerStats() const;
+    void resetWorkerStats();
+
+private:
+    static const int CHUNKS_PER_WORKER = 8;
+
+    struct Chunk {
+        int begin; // range of _order
+        int end;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Chunk> chunks; // guarded by mutex
+        WorkerStats stats; // only touched by the worker during a batch
+        uint64_t batchBusyUsecs { 0 };
+    };
+
+    bool popChunk(int worker, Chunk& chunk);
+    bool stealChunk(int worker, Chunk& chunk);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<int> _order; // jobs, most expensive first
+    std::vector<float> _jobCosts;
+    uint64_t _batchStart { 0 };
+};
+
+#endif // hifi_WorkStealingScheduler_h
@@ -0,0 +1,198 @@
+//
+//  HotAssetCacheTests.cpp
+//  tests/assets/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HotAssetCacheTests.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include "HotAssetCache.h"
+
+QTEST_MAIN(HotAssetCacheTests)
+
+const qint64 SHARD_CAPACITY = 8000;
+const qint64 CAPACITY = SHARD_CAPACITY * HotAssetCache::NUM_SHARDS;
+const qint64 MAX_ASSET_SIZE = SHARD_CAPACITY / 4; // the largest a shard admits
+const int ASSETS_PER_SHARD = 8;
+const qint64 ASSET_SIZE = SHARD_CAPACITY / ASSETS_PER_SHARD;
+
+static QByteArray assetOf(const AssetUtils::AssetHash& hash, qint64 size = ASSET_SIZE) {
+    return QByteArray((int)size, hash.at(0).toLatin1());
+}
+
+static void offer(HotAssetCache& cache, const AssetUtils::AssetHash& hash, qint64 size = ASSET_SIZE) {
+    QByteArray data = assetOf(hash, size);
+    cache.offer(hash, data.constData(), data.size());
+}
+
+// requests an asset that isn't cached, as a client does before it is read from disk
+static void requestMissing(HotAssetCache& cache, const AssetUtils::AssetHash& hash, int numRequests) {
+    for (int i = 0; i < numRequests; ++i) {
+        QByteArray data;
+        QVERIFY(!cache.get(hash, data));
+    }
+}
+
+static bool isCached(HotAssetCache& cache, const AssetUtils::AssetHash& hash) {
+    auto& shard = cache.shardFor(hash);
+    QMutexLocker locker(&shard.mutex);
+    return shard.entriesByHash.contains(hash);
+}
+
+QVector<AssetUtils::AssetHash> HotAssetCacheTests::hashesInOneShard(HotAssetCache& cache, int numHashes) {
+    QVector<AssetUtils::AssetHash> hashes;
+    HotAssetCache::Shard* shard = nullptr;
+    for (int i = 0; hashes.size() < numHashes; ++i) {
+        AssetUtils::AssetHash hash =
+            QString::fromLatin1(QCryptographicHash::hash(QByteArray::number(i), QCryptographicHash::Sha256).toHex());
+        if (!shard) {
+            shard = &cache.shardFor(hash);
+        }
+        if (&cache.shardFor(hash) == shard) {
+            hashes.push_back(hash);
+        }
+    }
+    return hashes;
+}
+
+void HotAssetCacheTests::sizeAccountingTest() {
+    HotAssetCache cache(CAPACITY);
+    auto hashes = hashesInOneShard(cache, 4);
+
+    offer(cache, hashes[0]);
+    offer(cache, hashes[1], ASSET_SIZE / 2);
+    auto stats = cache.getStats();
+    QCOMPARE(stats.numEntries, 2);
+    QCOMPARE(stats.sizeBytes, ASSET_SIZE + ASSET_SIZE / 2);
+    QCOMPARE(stats.admissions, (quint64)2);
+
+    // offered again, by a task that read it at the same time
+    offer(cache, hashes[0]);
+    QCOMPARE(cache.getStats().sizeBytes, ASSET_SIZE + ASSET_SIZE / 2);
+
+    // too large for a shard to hold, or empty
+    offer(cache, hashes[2], MAX_ASSET_SIZE + 1);
+    offer(cache, hashes[3], 0);
+    QVERIFY(!isCached(cache, hashes[2]));
+    QVERIFY(!isCached(cache, hashes[3]));
+    QCOMPARE(cache.getStats().numEntries, 2);
+
+    QByteArray data;
+    QVERIFY(cache.get(hashes[1], data));
+    QCOMPARE(data, assetOf(hashes[1], ASSET_SIZE / 2));
+    QVERIFY(!cache.get(hashes[2], data));
+    stats = cache.getStats();
+    QCOMPARE(stats.hits, (quint64)1);
+    QCOMPARE(stats.misses, (quint64)1);
+
+    cache.remove(hashes[0]);
+    cache.remove(hashes[0]);
+    stats = cache.getStats();
+    QCOMPARE(stats.numEntries, 1);
+    QCOMPARE(stats.sizeBytes, ASSET_SIZE / 2);
+    QCOMPARE(stats.evictions, (quint64)0);
+}
+
+void HotAssetCacheTests::admissionTest() {
+    HotAssetCache cache(CAPACITY);
+    auto hashes = hashesInOneShard(cache, ASSETS_PER_SHARD + 1);
+    const auto& candidate = hashes[ASSETS_PER_SHARD];
+
+    // a full shard, of assets requested twice each
+    for (int i = 0; i < ASSETS_PER_SHARD; ++i) {
+        requestMissing(cache, hashes[i], 1);
+        offer(cache, hashes[i]);
+        QByteArray data;
+        QVERIFY(cache.get(hashes[i], data));
+    }
+    QCOMPARE(cache.getStats().sizeBytes, SHARD_CAPACITY);
+
+    // requested less often than the least recently used, it is turned away
+    requestMissing(cache, candidate, 2);
+    offer(cache, candidate);
+    QVERIFY(!isCached(cache, candidate));
+    auto stats = cache.getStats();
+    QCOMPARE(stats.rejections, (quint64)1);
+    QCOMPARE(stats.numEntries, ASSETS_PER_SHARD);
+    QCOMPARE(stats.evictions, (quint64)0);
+
+    // requested more often, it takes its place
+    requestMissing(cache, candidate, 1);
+    offer(cache, candidate);
+    QVERIFY(isCached(cache, candidate));
+    QVERIFY(!isCached(cache, hashes[0]));
+    stats = cache.getStats();
+    QCOMPARE(stats.admissions, (quint64)ASSETS_PER_SHARD + 1);
+    QCOMPARE(stats.evictions, (quint64)1);
+    QCOMPARE(stats.numEntries, ASSETS_PER_SHARD);
+    QCOMPARE(stats.sizeBytes, SHARD_CAPACITY);
+}
+
+void HotAssetCacheTests::evictionOrderTest() {
+    HotAssetCache cache(CAPACITY);
+    auto hashes = hashesInOneShard(cache, ASSETS_PER_SHARD + 2);
+    const auto& candidate = hashes[ASSETS_PER_SHARD];
+    const auto& largeCandidate = hashes[ASSETS_PER_SHARD + 1];
+
+    for (int i = 0; i < ASSETS_PER_SHARD; ++i) {
+        offer(cache, hashes[i]);
+    }
+
+    // the first becomes the most recently used, the second is now the least
+    QByteArray data;
+    QVERIFY(cache.get(hashes[0], data));
+
+    requestMissing(cache, candidate, 2);
+    offer(cache, candidate);
+    QVERIFY(isCached(cache, candidate));
+    QVERIFY(!isCached(cache, hashes[1]));
+
+    // an asset twice the size evicts the next two
+    QCOMPARE(MAX_ASSET_SIZE, 2 * ASSET_SIZE);
+    requestMissing(cache, largeCandidate, 2);
+    offer(cache, largeCandidate, MAX_ASSET_SIZE);
+    QVERIFY(!isCached(cache, hashes[2]));
+    QVERIFY(!isCached(cache, hashes[3]));
+    for (int i = 4; i < ASSETS_PER_SHARD; ++i) {
+        QVERIFY(isCached(cache, hashes[i]));
+    }
+    QVERIFY(isCached(cache, hashes[0]));
+    QVERIFY(isCached(cache, candidate));
+    QVERIFY(isCached(cache, largeCandidate));
+
+    auto stats = cache.getStats();
+    QCOMPARE(stats.evictions, (quint64)3);
+    QCOMPARE(stats.numEntries, ASSETS_PER_SHARD - 1);
+    QCOMPARE(stats.sizeBytes, SHARD_CAPACITY);
+}
+
+void HotAssetCacheTests::setCapacityTest() {
+    HotAssetCache cache(CAPACITY);
+    auto hashes = hashesInOneShard(cache, ASSETS_PER_SHARD);
+    for (int i = 0; i < ASSETS_PER_SHARD; ++i) {
+        offer(cache, hashes[i]);
+    }
+
+    // halved, the least recently used half goes
+    cache.setCapacity(CAPACITY / 2);
+    for (int i = 0; i < ASSETS_PER_SHARD; ++i) {
+        QCOMPARE(isCached(cache, hashes[i]), i >= ASSETS_PER_SHARD / 2);
+    }
+    QCOMPARE(cache.getStats().sizeBytes, SHARD_CAPACITY / 2);
+
+    // disabled, nothing is kept or served
+    cache.setCapacity(0);
+    auto stats = cache.getStats();
+    QCOMPARE(stats.numEntries, 0);
+    QCOMPARE(stats.sizeBytes, (qint64)0);
+    offer(cache, hashes[0]);
+    QByteArray data;
+    QVERIFY(!cache.get(hashes[0], data));
+    QCOMPARE(cache.getStats().numEntries, 0);
+}
@@ -0,0 +1,34 @@
+//
+//  HotAssetCacheTests.h
+//  tests/assets/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HotAssetCacheTests_h
+#define hifi_HotAssetCacheTests_h
+
+#include <QtTest/QtTest>
+
+#include <AssetUtils.h>
+
+class HotAssetCache;
+
+class HotAssetCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sizeAccountingTest();
+    void admissionTest(); // an asset is only admitted if requested more often than those it would evict
+    void evictionOrderTest();
+    void setCapacityTest();
+
+private:
+    // hashes of assets that go to the same shard, the tests fill one shard
+    QVector<AssetUtils::AssetHash> hashesInOneShard(HotAssetCache& cache, int numHashes);
+};
+
+#endif // hifi_HotAssetCacheTests_h
@@ -0,0 +1,105 @@
+//
+//  MappedAssetCacheTests.cpp
+//  tests/assets/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCacheTests.h"
+
+#include "MappedAssetCache.h"
+
+QTEST_MAIN(MappedAssetCacheTests)
+
+static QByteArray contentsOf(const std::shared_ptr<const MappedAsset>& mappedAsset) {
+    return QByteArray(mappedAsset->getData(), (int)mappedAsset->getSize());
+}
+
+void MappedAssetCacheTests::initTestCase() {
+    QVERIFY(_dir.isValid());
+}
+
+QString MappedAssetCacheTests::writeAsset(const QString& name, const QByteArray& data) {
+    QString filePath = _dir.filePath(name);
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+        return QString();
+    }
+    return filePath;
+}
+
+void MappedAssetCacheTests::mappingTest() {
+    MappedAssetCache cache;
+    const QByteArray DATA(5000, 'a');
+    QString filePath = writeAsset("mapping", DATA);
+    QVERIFY(!filePath.isEmpty());
+
+    auto mappedAsset = cache.get(filePath);
+    QVERIFY(mappedAsset);
+    QCOMPARE(mappedAsset->getSize(), (qint64)DATA.size());
+    QCOMPARE(contentsOf(mappedAsset), DATA);
+
+    // the file is mapped once, and shared
+    QCOMPARE(cache.get(filePath), mappedAsset);
+
+    // an empty file has nothing to map, but is there
+    QString emptyFilePath = writeAsset("empty", QByteArray());
+    QVERIFY(!emptyFilePath.isEmpty());
+    auto emptyAsset = cache.get(emptyFilePath);
+    QVERIFY(emptyAsset);
+    QCOMPARE(emptyAsset->getSize(), (qint64)0);
+
+    QVERIFY(!cache.get(_dir.filePath("missing")));
+}
+
+void MappedAssetCacheTests::evictionOrderTest() {
+    const int MAX_MAPPINGS = 3;
+    MappedAssetCache cache(MAX_MAPPINGS);
+
+    QVector<QString> filePaths;
+    QVector<std::shared_ptr<const MappedAsset>> mappedAssets;
+    for (int i = 0; i < MAX_MAPPINGS + 1; ++i) {
+        filePaths.push_back(writeAsset(QString("eviction%1").arg(i), QByteArray(100 * (i + 1), (char)('a' + i))));
+        QVERIFY(!filePaths.back().isEmpty());
+    }
+    for (int i = 0; i < MAX_MAPPINGS; ++i) {
+        mappedAssets.push_back(cache.get(filePaths[i]));
+        QVERIFY(mappedAssets.back());
+    }
+
+    // the first becomes the most recently used, so one more mapping evicts the second
+    QCOMPARE(cache.get(filePaths[0]), mappedAssets[0]);
+    mappedAssets.push_back(cache.get(filePaths[MAX_MAPPINGS]));
+    QCOMPARE(cache.get(filePaths[0]), mappedAssets[0]);
+    QCOMPARE(cache.get(filePaths[2]), mappedAssets[2]);
+    QCOMPARE(cache.get(filePaths[MAX_MAPPINGS]), mappedAssets[MAX_MAPPINGS]);
+
+    // an evicted mapping stays valid for those still holding it, and the file is mapped again for the next
+    QCOMPARE(contentsOf(mappedAssets[1]), QByteArray(200, 'b'));
+    auto remapped = cache.get(filePaths[1]);
+    QVERIFY(remapped);
+    QVERIFY(remapped != mappedAssets[1]);
+    QCOMPARE(contentsOf(remapped), contentsOf(mappedAssets[1]));
+
+    // which in turn evicted the least recently used, the first
+    QVERIFY(cache.get(filePaths[0]) != mappedAssets[0]);
+}
+
+void MappedAssetCacheTests::removeTest() {
+    MappedAssetCache cache;
+    QString filePath = writeAsset("remove", QByteArray(100, 'r'));
+    QVERIFY(!filePath.isEmpty());
+
+    auto mappedAsset = cache.get(filePath);
+    QVERIFY(mappedAsset);
+    cache.remove(filePath);
+    auto remapped = cache.get(filePath);
+    QVERIFY(remapped != mappedAsset);
+    QCOMPARE(contentsOf(mappedAsset), contentsOf(remapped));
+
+    cache.clear();
+    QVERIFY(cache.get(filePath) != remapped);
+}
@@ -0,0 +1,33 @@
+//
+//  MappedAssetCacheTests.h
+//  tests/assets/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedAssetCacheTests_h
+#define hifi_MappedAssetCacheTests_h
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+class MappedAssetCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void mappingTest();
+    void evictionOrderTest();
+    void removeTest();
+
+private:
+    QString writeAsset(const QString& name, const QByteArray& data);
+
+    QTemporaryDir _dir;
+};
+
+#endif // hifi_MappedAssetCacheTests_h
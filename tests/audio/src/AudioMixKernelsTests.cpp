@@ -0,0 +1,135 @@
+//
+//  AudioMixKernelsTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixKernelsTests.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "AudioMixKernels.h"
+
+QTEST_MAIN(AudioMixKernelsTests)
+
+// up to a few times the widest vector, and a network frame
+static const int MAX_FRAMES = 100;
+static const int NETWORK_FRAMES = 240;
+
+static std::vector<int> frameCounts() {
+    std::vector<int> counts;
+    for (int numFrames = 0; numFrames <= MAX_FRAMES; numFrames++) {
+        counts.push_back(numFrames);
+    }
+    counts.push_back(NETWORK_FRAMES);
+    return counts;
+}
+
+static std::vector<int16_t> randomSamples(std::mt19937& engine, int numSamples) {
+    std::uniform_int_distribution<int> distribution(-32768, 32767);
+    std::vector<int16_t> samples(numSamples);
+    for (auto& sample : samples) {
+        sample = (int16_t)distribution(engine);
+    }
+    return samples;
+}
+
+static std::vector<float> randomFloats(std::mt19937& engine, int numSamples, float min, float max) {
+    std::uniform_real_distribution<float> distribution(min, max);
+    std::vector<float> samples(numSamples);
+    for (auto& sample : samples) {
+        sample = distribution(engine);
+    }
+    return samples;
+}
+
+// bit for bit, as the SIMD kernels are meant to be
+static bool isSame(const void* a, const void* b, size_t numBytes) {
+    return numBytes == 0 || memcmp(a, b, numBytes) == 0;
+}
+
+void AudioMixKernelsTests::gainfadeMonoToStereoTest() {
+    std::mt19937 engine(1);
+    for (int numFrames : frameCounts()) {
+        auto src = randomSamples(engine, numFrames);
+        auto win = randomFloats(engine, numFrames, 0.0f, 1.0f);
+        auto gains = randomFloats(engine, 2, 0.0f, 2.0f);
+
+        // accumulated onto what is mixed already
+        auto dst = randomFloats(engine, 2 * numFrames, -1.0f, 1.0f);
+        auto expected = dst;
+
+        gainfadeMonoToStereo(src.data(), dst.data(), win.data(), gains[0], gains[1], numFrames);
+        gainfadeMonoToStereoReference(src.data(), expected.data(), win.data(), gains[0], gains[1], numFrames);
+        QVERIFY2(isSame(dst.data(), expected.data(), dst.size() * sizeof(float)), qPrintable(QString::number(numFrames)));
+    }
+}
+
+void AudioMixKernelsTests::gainfadeStereoToStereoTest() {
+    std::mt19937 engine(2);
+    for (int numFrames : frameCounts()) {
+        auto src = randomSamples(engine, 2 * numFrames);
+        auto win = randomFloats(engine, numFrames, 0.0f, 1.0f);
+        auto gains = randomFloats(engine, 2, 0.0f, 2.0f);
+
+        auto dst = randomFloats(engine, 2 * numFrames, -1.0f, 1.0f);
+        auto expected = dst;
+
+        gainfadeStereoToStereo(src.data(), dst.data(), win.data(), gains[0], gains[1], numFrames);
+        gainfadeStereoToStereoReference(src.data(), expected.data(), win.data(), gains[0], gains[1], numFrames);
+        QVERIFY2(isSame(dst.data(), expected.data(), dst.size() * sizeof(float)), qPrintable(QString::number(numFrames)));
+    }
+}
+
+void AudioMixKernelsTests::hasNonZeroSamplesTest() {
+    for (int numSamples : frameCounts()) {
+        // negative zero is silence too
+        std::vector<float> src(numSamples, 0.0f);
+        for (int i = 0; i < numSamples; i += 3) {
+            src[i] = -0.0f;
+        }
+        QCOMPARE(hasNonZeroSamples(src.data(), numSamples), false);
+        QCOMPARE(hasNonZeroSamplesReference(src.data(), numSamples), false);
+
+        // a single sound, wherever it falls in the vectors
+        for (int i = 0; i < numSamples; i++) {
+            src[i] = 1.0e-30f;
+            QCOMPARE(hasNonZeroSamples(src.data(), numSamples), true);
+            QCOMPARE(hasNonZeroSamplesReference(src.data(), numSamples), true);
+            src[i] = 0.0f;
+        }
+    }
+}
+
+void AudioMixKernelsTests::gainDitherPackStereoTest() {
+    std::mt19937 engine(3);
+    for (int numFrames : frameCounts()) {
+        // past the int16_t range, to saturate
+        auto src = randomFloats(engine, 2 * numFrames, -40000.0f, 40000.0f);
+        auto gain = randomFloats(engine, numFrames, 0.0f, 1.5f);
+        auto dither = randomFloats(engine, numFrames, -1.0f, 1.0f);
+
+        std::vector<int16_t> dst(2 * numFrames);
+        std::vector<int16_t> expected(2 * numFrames);
+        gainDitherPackStereo(src.data(), gain.data(), dither.data(), dst.data(), numFrames);
+        gainDitherPackStereoReference(src.data(), gain.data(), dither.data(), expected.data(), numFrames);
+        QVERIFY2(isSame(dst.data(), expected.data(), dst.size() * sizeof(int16_t)), qPrintable(QString::number(numFrames)));
+
+        // halfway between two integers, to round the same way
+        for (int i = 0; i < 2 * numFrames; i++) {
+            src[i] = (float)(i - numFrames) + 0.5f;
+        }
+        std::fill(gain.begin(), gain.end(), 1.0f);
+        std::fill(dither.begin(), dither.end(), 0.0f);
+        gainDitherPackStereo(src.data(), gain.data(), dither.data(), dst.data(), numFrames);
+        gainDitherPackStereoReference(src.data(), gain.data(), dither.data(), expected.data(), numFrames);
+        QVERIFY2(isSame(dst.data(), expected.data(), dst.size() * sizeof(int16_t)), qPrintable(QString::number(numFrames)));
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  AudioMixKernelsTests.h
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixKernelsTests_h
+#define hifi_AudioMixKernelsTests_h
+
+#include <QtTest/QtTest>
+
+// the kernels dispatched for this CPU against the portable reference code, on random input of lengths that are and
+// aren't a multiple of the vector width
+class AudioMixKernelsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void gainfadeMonoToStereoTest();
+    void gainfadeStereoToStereoTest();
+    void hasNonZeroSamplesTest();
+    void gainDitherPackStereoTest();
+};
+
+#endif // hifi_AudioMixKernelsTests_h
@@ -0,0 +1,438 @@
+//
+//  JointDeltasTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointDeltasTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <AvatarData.h>
+#include <GLMHelpers.h>
+#include <JointDeltas.h>
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+QTEST_MAIN(JointDeltasTests)
+
+const int NUM_JOINTS = 60;
+
+static float randomFloat(std::mt19937& random, float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(random);
+}
+
+static glm::quat randomRotation(std::mt19937& random) {
+    glm::vec3 axis = glm::normalize(glm::vec3(randomFloat(random, -1.0f, 1.0f), randomFloat(random, -1.0f, 1.0f),
+                                              randomFloat(random, -1.0f, 1.0f)) + glm::vec3(0.0f, 0.0f, 0.01f));
+    return glm::angleAxis(randomFloat(random, -PI, PI), axis);
+}
+
+static glm::vec3 randomTranslation(std::mt19937& random, float range) {
+    return glm::vec3(randomFloat(random, -range, range), randomFloat(random, -range, range),
+                     randomFloat(random, -range, range));
+}
+
+// a pose with about a fifth of its rotations and half of its translations in the default pose
+static QVector<JointData> randomPose(std::mt19937& random) {
+    QVector<JointData> joints(NUM_JOINTS);
+    for (JointData& joint : joints) {
+        joint.rotationIsDefaultPose = random() % 5 == 0;
+        joint.rotation = joint.rotationIsDefaultPose ? Quaternions::IDENTITY : randomRotation(random);
+        joint.translationIsDefaultPose = random() % 2 == 0;
+        joint.translation = joint.translationIsDefaultPose ? Vectors::ZERO : randomTranslation(random, 0.5f);
+    }
+    return joints;
+}
+
+// the pose a moment later: most joints move a little, a few leave or go back to their default pose
+static QVector<JointData> movedPose(std::mt19937& random, const QVector<JointData>& pose) {
+    QVector<JointData> joints = pose;
+    for (JointData& joint : joints) {
+        if (random() % 10 == 0) {
+            joint.rotationIsDefaultPose = !joint.rotationIsDefaultPose;
+            joint.rotation = joint.rotationIsDefaultPose ? Quaternions::IDENTITY : randomRotation(random);
+        } else if (!joint.rotationIsDefaultPose && random() % 4 != 0) {
+            joint.rotation = glm::normalize(joint.rotation * glm::angleAxis(randomFloat(random, -0.1f, 0.1f),
+                                                                            Vectors::UNIT_Y));
+        }
+        if (random() % 10 == 0) {
+            joint.translationIsDefaultPose = !joint.translationIsDefaultPose;
+            joint.translation = joint.translationIsDefaultPose ? Vectors::ZERO : randomTranslation(random, 0.5f);
+        } else if (!joint.translationIsDefaultPose && random() % 4 != 0) {
+            joint.translation += randomTranslation(random, 0.01f);
+        }
+    }
+    return joints;
+}
+
+static float rotationError(const glm::quat& a, const glm::quat& b) {
+    glm::vec4 difference = glm::vec4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+    glm::vec4 sum = glm::vec4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+    return std::min(glm::length(difference), glm::length(sum));
+}
+
+static float translationError(const glm::vec3& a, const glm::vec3& b) {
+    glm::vec3 difference = glm::abs(a - b);
+    return std::max(difference.x, std::max(difference.y, difference.z));
+}
+
+static bool isFinite(const JointData& joint) {
+    return std::isfinite(joint.rotation.x) && std::isfinite(joint.rotation.y) && std::isfinite(joint.rotation.z) &&
+        std::isfinite(joint.rotation.w) && std::isfinite(joint.translation.x) && std::isfinite(joint.translation.y) &&
+        std::isfinite(joint.translation.z);
+}
+
+// the joints that are not in their default pose, decoded within the quantization of the precision
+static void verifyPose(const QVector<JointData>& decoded, const QVector<JointData>& pose, int precision) {
+    const float rotationBound = 2.0f * JointDeltas::ROTATION_STEP * (float)(1 << precision);
+    const float translationBound = 0.5f * JointDeltas::TRANSLATION_STEP * (float)(1 << precision) + 1.0e-5f;
+    QCOMPARE(decoded.size(), pose.size());
+    for (int i = 0; i < pose.size(); ++i) {
+        if (!pose[i].rotationIsDefaultPose) {
+            QVERIFY(!decoded[i].rotationIsDefaultPose);
+            QVERIFY(rotationError(decoded[i].rotation, pose[i].rotation) <= rotationBound);
+        }
+        if (!pose[i].translationIsDefaultPose) {
+            QVERIFY(!decoded[i].translationIsDefaultPose);
+            QVERIFY(translationError(decoded[i].translation, pose[i].translation) <= translationBound);
+        }
+    }
+}
+
+static void setBit(QByteArray& bits, int offset, int index) {
+    bits[offset + index / BITS_IN_BYTE] = bits[offset + index / BITS_IN_BYTE] | (1 << (index % BITS_IN_BYTE));
+}
+
+// the joint data and default pose flags sections of a record that holds every joint of the pose
+static void packSections(const QVector<JointData>& pose, QByteArray& jointData, QByteArray& defaultPoseFlags) {
+    const int numJoints = pose.size();
+    const int bitVectorSize = (numJoints + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    defaultPoseFlags = QByteArray(1 + 2 * bitVectorSize, 0);
+    defaultPoseFlags[0] = (char)numJoints;
+    for (int i = 0; i < numJoints; ++i) {
+        if (pose[i].rotationIsDefaultPose) {
+            setBit(defaultPoseFlags, 1, i);
+        }
+        if (pose[i].translationIsDefaultPose) {
+            setBit(defaultPoseFlags, 1 + bitVectorSize, i);
+        }
+    }
+
+    jointData = QByteArray(1 + bitVectorSize, 0);
+    jointData[0] = (char)numJoints;
+    for (int i = 0; i < numJoints; ++i) {
+        if (!pose[i].rotationIsDefaultPose) {
+            setBit(jointData, 1, i);
+            unsigned char sixBytes[6];
+            packOrientationQuatToSixBytes(sixBytes, pose[i].rotation);
+            jointData.append(reinterpret_cast<const char*>(sixBytes), sizeof(sixBytes));
+        }
+    }
+    const int translationValidityOffset = jointData.size();
+    jointData.append(QByteArray(bitVectorSize, 0));
+    float maxTranslationDimension = 0.001f;
+    for (const JointData& joint : pose) {
+        if (!joint.translationIsDefaultPose) {
+            glm::vec3 magnitude = glm::abs(joint.translation);
+            maxTranslationDimension = std::max(maxTranslationDimension,
+                                               std::max(magnitude.x, std::max(magnitude.y, magnitude.z)));
+        }
+    }
+    jointData.append(reinterpret_cast<const char*>(&maxTranslationDimension), sizeof(maxTranslationDimension));
+    for (int i = 0; i < numJoints; ++i) {
+        if (!pose[i].translationIsDefaultPose) {
+            setBit(jointData, translationValidityOffset, i);
+            unsigned char sixBytes[6];
+            packFloatVec3ToSignedTwoByteFixed(sixBytes, pose[i].translation / maxTranslationDimension,
+                                              TRANSLATION_COMPRESSION_RADIX);
+            jointData.append(reinterpret_cast<const char*>(sixBytes), sizeof(sixBytes));
+        }
+    }
+}
+
+static const unsigned char* bytes(const QByteArray& array) {
+    return reinterpret_cast<const unsigned char*>(array.constData());
+}
+
+static JointDeltas::Keyframe keyframeOf(const QVector<JointData>& pose) {
+    QByteArray jointData;
+    QByteArray defaultPoseFlags;
+    packSections(pose, jointData, defaultPoseFlags);
+    return JointDeltas::keyframeFromSections(bytes(jointData), jointData.size(), bytes(defaultPoseFlags),
+                                             defaultPoseFlags.size());
+}
+
+void JointDeltasTests::roundTripTest() {
+    std::mt19937 random(1);
+    const int NUM_TRIALS = 50;
+    for (int trial = 0; trial < NUM_TRIALS; ++trial) {
+        QVector<JointData> keyPose = randomPose(random);
+        JointDeltas::Keyframe keyframe = keyframeOf(keyPose);
+        QVERIFY(keyframe.isValid());
+        QVector<JointData> pose = movedPose(random, keyPose);
+
+        for (int precision = 0; precision <= JointDeltas::MAX_PRECISION; ++precision) {
+            QByteArray coded;
+            QVector<JointData> encoderJoints = pose;
+            JointDeltas::encode(pose.constData(), NUM_JOINTS, keyframe, precision, coded, encoderJoints.data());
+
+            QVector<JointData> decoded(NUM_JOINTS);
+            JointDeltas::decode(bytes(coded), coded.size(), keyframe, precision, decoded.data(), NUM_JOINTS);
+            verifyPose(decoded, pose, precision);
+
+            // the sender knows exactly what the receiver decodes
+            for (int i = 0; i < NUM_JOINTS; ++i) {
+                QCOMPARE(decoded[i].rotation, encoderJoints[i].rotation);
+                QCOMPARE(decoded[i].translation, encoderJoints[i].translation);
+            }
+        }
+    }
+}
+
+void JointDeltasTests::truncatedKeyframeTest() {
+    std::mt19937 random(2);
+    QVector<JointData> pose = randomPose(random);
+    QByteArray jointData;
+    QByteArray defaultPoseFlags;
+    packSections(pose, jointData, defaultPoseFlags);
+
+    JointDeltas::Keyframe keyframe = JointDeltas::keyframeFromSections(bytes(jointData), jointData.size(),
+                                                                       bytes(defaultPoseFlags), defaultPoseFlags.size());
+    QVERIFY(keyframe.isValid());
+    QCOMPARE(keyframe.joints.size(), NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        QCOMPARE(keyframe.joints[i].rotationIsDefaultPose, pose[i].rotationIsDefaultPose);
+        QCOMPARE(keyframe.joints[i].translationIsDefaultPose, pose[i].translationIsDefaultPose);
+        QVERIFY(rotationError(keyframe.joints[i].rotation, pose[i].rotation) < 0.001f);
+        QVERIFY(translationError(keyframe.joints[i].translation, pose[i].translation) < 0.001f);
+    }
+
+    // every truncation of either section is rejected, copied so that reading past it is caught by the sanitizers
+    for (int size = 0; size < jointData.size(); ++size) {
+        std::vector<unsigned char> truncated(jointData.constData(), jointData.constData() + size);
+        QVERIFY(!JointDeltas::keyframeFromSections(truncated.data(), size, bytes(defaultPoseFlags),
+                                                   defaultPoseFlags.size()).isValid());
+    }
+    for (int size = 0; size < defaultPoseFlags.size(); ++size) {
+        std::vector<unsigned char> truncated(defaultPoseFlags.constData(), defaultPoseFlags.constData() + size);
+        QVERIFY(!JointDeltas::keyframeFromSections(bytes(jointData), jointData.size(), truncated.data(),
+                                                   size).isValid());
+    }
+
+    // and so is a joint data section without a joint that is not in its default pose
+    int missingJoint = 0;
+    while (pose[missingJoint].rotationIsDefaultPose) {
+        ++missingJoint;
+    }
+    pose[missingJoint].rotationIsDefaultPose = true;
+    QByteArray partialJointData;
+    QByteArray unusedDefaultPoseFlags;
+    packSections(pose, partialJointData, unusedDefaultPoseFlags);
+    QVERIFY(!JointDeltas::keyframeFromSections(bytes(partialJointData), partialJointData.size(), bytes(defaultPoseFlags),
+                                               defaultPoseFlags.size()).isValid());
+}
+
+void JointDeltasTests::truncatedDeltasTest() {
+    std::mt19937 random(3);
+    QVector<JointData> keyPose = randomPose(random);
+    JointDeltas::Keyframe keyframe = keyframeOf(keyPose);
+    QVector<JointData> pose = movedPose(random, keyPose);
+    QByteArray coded;
+    JointDeltas::encode(pose.constData(), NUM_JOINTS, keyframe, 0, coded, nullptr);
+
+    // the decoder reads zeros past the end of its input, whatever it decodes from them is a pose
+    for (int size = 0; size < coded.size(); ++size) {
+        std::vector<unsigned char> truncated(coded.constData(), coded.constData() + size);
+        QVector<JointData> decoded(NUM_JOINTS);
+        JointDeltas::decode(truncated.data(), size, keyframe, 0, decoded.data(), NUM_JOINTS);
+        for (const JointData& joint : decoded) {
+            QVERIFY(isFinite(joint));
+        }
+    }
+}
+
+static QByteArray recordOf(const AvatarData& avatar, AvatarData::AvatarDataDetail detail,
+                           JointDeltas::Keyframe& keyframe) {
+    AvatarDataPacket::SendStatus sendStatus;
+    QVector<JointData> sentJointData;
+    return avatar.toByteArray(detail, 0, QVector<JointData>(), sendStatus, false, false, glm::vec3(), &sentJointData,
+                              0, nullptr, &keyframe);
+}
+
+static AvatarDataPacket::HasFlags flagsOf(const QByteArray& record) {
+    AvatarDataPacket::HasFlags flags;
+    memcpy(&flags, record.constData(), sizeof(flags));
+    return flags;
+}
+
+void JointDeltasTests::avatarRoundTripTest() {
+    std::mt19937 random(4);
+    auto sender = std::make_shared<AvatarData>();
+    auto receiver = std::make_shared<AvatarData>();
+
+    QVector<JointData> keyPose = randomPose(random);
+    sender->setRawJointData(keyPose);
+    JointDeltas::Keyframe keyframe;
+    QByteArray keyRecord = recordOf(*sender, AvatarData::SendAllData, keyframe);
+    QVERIFY(keyframe.isValid());
+    QVERIFY(flagsOf(keyRecord) & AvatarDataPacket::PACKET_HAS_JOINT_DATA);
+    QCOMPARE(receiver->parseDataFromBuffer(keyRecord), keyRecord.size());
+
+    // the poses that follow are sent as deltas from the complete one
+    const int NUM_UPDATES = 10;
+    QVector<JointData> pose = keyPose;
+    for (int update = 0; update < NUM_UPDATES; ++update) {
+        pose = movedPose(random, pose);
+        sender->setRawJointData(pose);
+        QByteArray record = recordOf(*sender, AvatarData::JointDeltaData, keyframe);
+        QVERIFY(flagsOf(record) & AvatarDataPacket::PACKET_HAS_JOINT_DELTAS);
+        QVERIFY(!(flagsOf(record) & AvatarDataPacket::PACKET_HAS_JOINT_DATA));
+        QCOMPARE(receiver->parseDataFromBuffer(record), record.size());
+        verifyPose(receiver->getJointData(), pose, 0);
+    }
+    QVERIFY(!receiver->shouldRequestJointKeyframe(usecTimestampNow()));
+}
+
+void JointDeltasTests::keyframeMismatchTest() {
+    std::mt19937 random(5);
+    auto sender = std::make_shared<AvatarData>();
+
+    QVector<JointData> firstPose = randomPose(random);
+    sender->setRawJointData(firstPose);
+    JointDeltas::Keyframe firstKeyframe;
+    QByteArray firstRecord = recordOf(*sender, AvatarData::SendAllData, firstKeyframe);
+
+    QVector<JointData> secondPose = randomPose(random);
+    sender->setRawJointData(secondPose);
+    JointDeltas::Keyframe secondKeyframe;
+    QByteArray secondRecord = recordOf(*sender, AvatarData::SendAllData, secondKeyframe);
+    QVERIFY(firstKeyframe.hash != secondKeyframe.hash);
+
+    sender->setRawJointData(movedPose(random, firstPose));
+    QByteArray deltaRecord = recordOf(*sender, AvatarData::JointDeltaData, firstKeyframe);
+    QVERIFY(flagsOf(deltaRecord) & AvatarDataPacket::PACKET_HAS_JOINT_DELTAS);
+
+    // a receiver with another keyframe keeps its joints, and asks for a keyframe once per interval
+    auto receiver = std::make_shared<AvatarData>();
+    receiver->parseDataFromBuffer(secondRecord);
+    quint64 now = usecTimestampNow();
+    QVERIFY(!receiver->shouldRequestJointKeyframe(now));
+    QVector<JointData> joints = receiver->getJointData();
+    QCOMPARE(receiver->parseDataFromBuffer(deltaRecord), deltaRecord.size());
+    QVector<JointData> jointsAfterDeltas = receiver->getJointData();
+    QCOMPARE(jointsAfterDeltas.size(), joints.size());
+    for (int i = 0; i < joints.size(); ++i) {
+        QCOMPARE(jointsAfterDeltas[i].rotation, joints[i].rotation);
+        QCOMPARE(jointsAfterDeltas[i].translation, joints[i].translation);
+    }
+    QVERIFY(receiver->shouldRequestJointKeyframe(now));
+    QVERIFY(!receiver->shouldRequestJointKeyframe(now + 100 * USECS_PER_MSEC));
+    QVERIFY(receiver->shouldRequestJointKeyframe(now + USECS_PER_SECOND));
+
+    // until it gets one
+    receiver->parseDataFromBuffer(firstRecord);
+    QVERIFY(!receiver->shouldRequestJointKeyframe(now + 2 * USECS_PER_SECOND));
+    receiver->parseDataFromBuffer(deltaRecord);
+    QVERIFY(!receiver->shouldRequestJointKeyframe(now + 3 * USECS_PER_SECOND));
+
+    // as does a receiver without any keyframe
+    auto newReceiver = std::make_shared<AvatarData>();
+    QCOMPARE(newReceiver->parseDataFromBuffer(deltaRecord), deltaRecord.size());
+    QVERIFY(newReceiver->shouldRequestJointKeyframe(now));
+}
+
+void JointDeltasTests::truncatedRecordTest() {
+    std::mt19937 random(6);
+    auto sender = std::make_shared<AvatarData>();
+    QVector<JointData> keyPose = randomPose(random);
+    sender->setRawJointData(keyPose);
+    JointDeltas::Keyframe keyframe;
+    QByteArray keyRecord = recordOf(*sender, AvatarData::SendAllData, keyframe);
+    QVector<JointData> pose = movedPose(random, keyPose);
+    sender->setRawJointData(pose);
+    QByteArray deltaRecord = recordOf(*sender, AvatarData::JointDeltaData, keyframe);
+
+    // every prefix of either record is read no further than its end
+    auto receiver = std::make_shared<AvatarData>();
+    for (int size = 0; size < keyRecord.size(); ++size) {
+        QByteArray truncated(keyRecord.constData(), size);
+        QVERIFY(receiver->parseDataFromBuffer(truncated) <= size);
+    }
+    QCOMPARE(receiver->parseDataFromBuffer(keyRecord), keyRecord.size());
+    for (int size = 0; size < deltaRecord.size(); ++size) {
+        QByteArray truncated(deltaRecord.constData(), size);
+        QVERIFY(receiver->parseDataFromBuffer(truncated) <= size);
+    }
+
+    // and leaves the keyframe to the complete record
+    QCOMPARE(receiver->parseDataFromBuffer(deltaRecord), deltaRecord.size());
+    verifyPose(receiver->getJointData(), pose, 0);
+}
+
+void JointDeltasTests::oversizedDeltasTest() {
+    const int MAX_JOINTS = 255;
+    std::mt19937 random(7);
+    auto sender = std::make_shared<AvatarData>();
+    auto receiver = std::make_shared<AvatarData>();
+
+    QVector<JointData> keyPose(MAX_JOINTS);
+    for (JointData& joint : keyPose) {
+        joint.rotationIsDefaultPose = false;
+        joint.rotation = randomRotation(random);
+    }
+    sender->setRawJointData(keyPose);
+    JointDeltas::Keyframe keyframe;
+    QByteArray keyRecord = recordOf(*sender, AvatarData::SendAllData, keyframe);
+    QVERIFY(keyframe.isValid());
+    receiver->parseDataFromBuffer(keyRecord);
+
+    // with every joint far from the keyframe, the deltas are smaller than the joint data but don't fit a packet
+    QVector<JointData> pose = keyPose;
+    for (JointData& joint : pose) {
+        joint.rotation = randomRotation(random);
+    }
+    sender->setRawJointData(pose);
+    QByteArray coded;
+    JointDeltas::encode(pose.constData(), MAX_JOINTS, keyframe, 0, coded, nullptr);
+    const int packetCapacity = NLPacket::maxPayloadSize(PacketType::BulkAvatarData);
+    const int jointDeltasSize = (int)AvatarDataPacket::JOINT_DELTAS_HEADER_SIZE + coded.size();
+    QVERIFY(jointDeltasSize > packetCapacity - (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE);
+    QVERIFY(jointDeltasSize <= (int)AvatarDataPacket::maxJointDataSize(MAX_JOINTS));
+
+    // so the joint data is sent instead, across packets as the avatar mixer does
+    AvatarDataPacket::SendStatus sendStatus;
+    sendStatus.sendUUID = true;
+    QVector<JointData> lastSentJoints;
+    const int MAX_RECORDS = 10;
+    int numRecords = 0;
+    do {
+        QByteArray record = sender->toByteArray(AvatarData::JointDeltaData, 0, lastSentJoints, sendStatus, false, false,
+                                                glm::vec3(), &lastSentJoints, packetCapacity, nullptr, &keyframe);
+        QVERIFY(record.size() <= packetCapacity);
+        QByteArray recordData = record.mid(NUM_BYTES_RFC4122_UUID);
+        QVERIFY(!(flagsOf(recordData) & AvatarDataPacket::PACKET_HAS_JOINT_DELTAS));
+        QCOMPARE(receiver->parseDataFromBuffer(recordData), recordData.size());
+        ++numRecords;
+    } while (!sendStatus && numRecords < MAX_RECORDS);
+    QVERIFY(sendStatus);
+    QVERIFY(numRecords > 1);
+
+    QVector<JointData> joints = receiver->getJointData();
+    QCOMPARE(joints.size(), MAX_JOINTS);
+    for (int i = 0; i < MAX_JOINTS; ++i) {
+        QVERIFY(rotationError(joints[i].rotation, pose[i].rotation) < 0.001f);
+    }
+}
@@ -0,0 +1,28 @@
+//
+//  JointDeltasTests.h
+//  tests/avatars/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JointDeltasTests_h
+#define hifi_JointDeltasTests_h
+
+#include <QtTest/QtTest>
+
+class JointDeltasTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void truncatedKeyframeTest();
+    void truncatedDeltasTest();
+    void avatarRoundTripTest();
+    void keyframeMismatchTest();
+    void truncatedRecordTest();
+    void oversizedDeltasTest();
+};
+
+#endif // hifi_JointDeltasTests_h
@@ -0,0 +1,230 @@
+//
+//  MessagesTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MessagesTests.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <MessagesClient.h>
+#include <MessagesPacer.h>
+#include <ReceivedMessage.h>
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(MessagesTests)
+
+// a thousand bytes per second: a tenth of a second is a hundred bytes
+const float KBPS = 8.0f;
+const int MESSAGE_SIZE = 100;
+
+static QByteArray messageOf(int index, int size = MESSAGE_SIZE) {
+    return QByteArray(size, (char)('a' + index % 26));
+}
+
+void MessagesTests::coalesceTest() {
+    MessagesPacer pacer;
+    pacer.setMaxNodeBandwidth(1000.0f * KBPS);
+    QUuid firstNode = QUuid::createUuid();
+    QUuid secondNode = QUuid::createUuid();
+
+    // the messages for a node since the last send go out together, in order
+    QVERIFY(pacer.queueMessage(firstNode, messageOf(0)));
+    QVERIFY(pacer.queueMessage(firstNode, messageOf(1)));
+    QVERIFY(pacer.queueMessage(secondNode, messageOf(2)));
+    QVERIFY(pacer.queueMessage(firstNode, messageOf(3)));
+    QCOMPARE(pacer.getNumHeldBytes(), 4 * MESSAGE_SIZE);
+
+    auto batches = pacer.takeMessages(0.0f);
+    QCOMPARE(batches.size(), 2);
+    QCOMPARE(batches[firstNode], QVector<QByteArray>({ messageOf(0), messageOf(1), messageOf(3) }));
+    QCOMPARE(batches[secondNode], QVector<QByteArray>({ messageOf(2) }));
+    QCOMPARE(pacer.getNumHeldBytes(), 0);
+
+    QVERIFY(pacer.takeMessages(0.0f).isEmpty());
+}
+
+void MessagesTests::unlimitedTest() {
+    MessagesPacer pacer;
+    QUuid node = QUuid::createUuid();
+    const int NUM_MESSAGES = 1000;
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        QVERIFY(pacer.queueMessage(node, messageOf(i, 1000)));
+    }
+
+    auto batches = pacer.takeMessages(0.0f);
+    QCOMPARE(batches[node].size(), NUM_MESSAGES);
+    QCOMPARE(pacer.getNumHeldBytes(), 0);
+    QVERIFY(!pacer.hasNode(node));
+}
+
+void MessagesTests::holdAndDropTest() {
+    MessagesPacer pacer;
+    pacer.setMaxNodeBandwidth(KBPS);
+    QUuid node = QUuid::createUuid();
+
+    // a second's worth is held, the rest dropped
+    const int NUM_MESSAGES = 15;
+    const int NUM_HELD_MESSAGES = 10;
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        QCOMPARE(pacer.queueMessage(node, messageOf(i)), i < NUM_HELD_MESSAGES);
+    }
+    QCOMPARE(pacer.getNumHeldBytes(), NUM_HELD_MESSAGES * MESSAGE_SIZE);
+
+    // a burst of a tenth of a second's worth, then the messages the elapsed time pays for
+    int numSent = 0;
+    auto batches = pacer.takeMessages(0.0f);
+    QCOMPARE(batches[node], QVector<QByteArray>({ messageOf(numSent++) }));
+    batches = pacer.takeMessages(0.05f);
+    QCOMPARE(batches[node], QVector<QByteArray>({ messageOf(numSent++) }));
+    // the last message took the budget below zero
+    QVERIFY(pacer.takeMessages(0.04f).isEmpty());
+    batches = pacer.takeMessages(0.02f);
+    QCOMPARE(batches[node], QVector<QByteArray>({ messageOf(numSent++) }));
+    QCOMPARE(pacer.getNumHeldBytes(), (NUM_HELD_MESSAGES - numSent) * MESSAGE_SIZE);
+
+    // a long wait refills no more than the burst
+    while (numSent < NUM_HELD_MESSAGES) {
+        batches = pacer.takeMessages(1.0f);
+        QCOMPARE(batches[node], QVector<QByteArray>({ messageOf(numSent++) }));
+    }
+    QCOMPARE(pacer.getNumHeldBytes(), 0);
+    QVERIFY(pacer.hasNode(node));
+    QVERIFY(pacer.takeMessages(1.0f).isEmpty());
+    QVERIFY(!pacer.hasNode(node));
+
+    // a message too large to hold still goes out, on its own, and is paid back before the next
+    const int LARGE_MESSAGE_SIZE = 5000;
+    QVERIFY(pacer.queueMessage(node, messageOf(0, LARGE_MESSAGE_SIZE)));
+    QVERIFY(!pacer.queueMessage(node, messageOf(1)));
+    batches = pacer.takeMessages(0.0f);
+    QCOMPARE(batches[node], QVector<QByteArray>({ messageOf(0, LARGE_MESSAGE_SIZE) }));
+    QVERIFY(pacer.queueMessage(node, messageOf(2)));
+    QVERIFY(pacer.takeMessages(1.0f).isEmpty());
+    batches = pacer.takeMessages(4.0f);
+    QCOMPARE(batches[node], QVector<QByteArray>({ messageOf(2) }));
+}
+
+void MessagesTests::removeNodeTest() {
+    MessagesPacer pacer;
+    pacer.setMaxNodeBandwidth(KBPS);
+    QUuid node = QUuid::createUuid();
+    QUuid otherNode = QUuid::createUuid();
+    const int NUM_MESSAGES = 5;
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        QVERIFY(pacer.queueMessage(node, messageOf(i)));
+    }
+    QVERIFY(pacer.queueMessage(otherNode, messageOf(0)));
+    QCOMPARE(pacer.takeMessages(0.0f).size(), 2);
+
+    QCOMPARE(pacer.removeNode(node), NUM_MESSAGES - 1);
+    QVERIFY(!pacer.hasNode(node));
+    QCOMPARE(pacer.getNumHeldBytes(), 0);
+    QCOMPARE(pacer.removeNode(node), 0);
+}
+
+struct Message {
+    QString channel;
+    bool isText;
+    QString message;
+    QByteArray data;
+    QUuid senderID;
+};
+
+// the bytes of a message, as the messages mixer coalesces them
+static QByteArray encode(const Message& message) {
+    auto packetList = message.isText ?
+        MessagesClient::encodeMessagesPacket(message.channel, message.message, message.senderID) :
+        MessagesClient::encodeMessagesDataPacket(message.channel, message.data, message.senderID);
+    packetList->closeCurrentPacket();
+    return packetList->getMessage();
+}
+
+static QSharedPointer<ReceivedMessage> receivedMessageOf(const QByteArray& bytes) {
+    return QSharedPointer<ReceivedMessage>::create(bytes, PacketType::MessagesData,
+                                                   versionForPacketType(PacketType::MessagesData), HifiSockAddr());
+}
+
+static QVector<Message> messages() {
+    return {
+        { "first.channel", true, "a text message", QByteArray(), QUuid::createUuid() },
+        { "second.channel", false, QString(), QByteArray(300, 'd'), QUuid::createUuid() },
+        { "", true, "", QByteArray(), QUuid::createUuid() },
+        { "first.channel", true, QString(2000, 'x'), QByteArray(), QUuid::createUuid() }
+    };
+}
+
+void MessagesTests::decodeSeveralMessagesTest() {
+    QVector<Message> sent = messages();
+    QByteArray bytes;
+    for (const Message& message : sent) {
+        bytes += encode(message);
+    }
+
+    auto receivedMessage = receivedMessageOf(bytes);
+    for (const Message& message : sent) {
+        QString channel, text;
+        QByteArray data;
+        bool isText { false };
+        QUuid senderID;
+        QVERIFY(MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, text, data, senderID));
+        QCOMPARE(channel, message.channel);
+        QCOMPARE(isText, message.isText);
+        QCOMPARE(text, message.message);
+        QCOMPARE(data, message.data);
+        QCOMPARE(senderID, message.senderID);
+    }
+    QCOMPARE(receivedMessage->getBytesLeftToRead(), (qint64)0);
+}
+
+void MessagesTests::decodeTruncatedMessagesTest() {
+    QVector<Message> sent = messages();
+    QByteArray bytes;
+    QVector<int> messageEnds; // without the sender ID, which a message can be missing
+    for (const Message& message : sent) {
+        bytes += encode(message);
+        messageEnds.push_back(bytes.size() - NUM_BYTES_RFC4122_UUID);
+    }
+
+    // every message the packet holds is decoded, and none that runs past its end
+    for (int size = 0; size < bytes.size(); ++size) {
+        auto receivedMessage = receivedMessageOf(bytes.left(size));
+        int numDecoded = 0;
+        while (receivedMessage->getBytesLeftToRead() > 0) {
+            QString channel, text;
+            QByteArray data;
+            bool isText { false };
+            QUuid senderID;
+            if (!MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, text, data, senderID)) {
+                break;
+            }
+            QCOMPARE(channel, sent[numDecoded].channel);
+            QCOMPARE(text, sent[numDecoded].message);
+            QCOMPARE(data, sent[numDecoded].data);
+            ++numDecoded;
+        }
+        int numHeld = (int)std::count_if(messageEnds.begin(), messageEnds.end(), [&](int end) { return end <= size; });
+        QCOMPARE(numDecoded, numHeld);
+    }
+
+    // as is a message with a length that runs past the end
+    QByteArray message = encode(sent[0]);
+    QByteArray tooLong = message;
+    quint32 messageLength = 1000;
+    const int MESSAGE_LENGTH_OFFSET = sizeof(quint16) + sent[0].channel.toUtf8().size() + sizeof(bool);
+    memcpy(tooLong.data() + MESSAGE_LENGTH_OFFSET, &messageLength, sizeof(messageLength));
+    auto receivedMessage = receivedMessageOf(message + tooLong);
+    QString channel, text;
+    QByteArray data;
+    bool isText { false };
+    QUuid senderID;
+    QVERIFY(MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, text, data, senderID));
+    QVERIFY(!MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, text, data, senderID));
+}
@@ -0,0 +1,27 @@
+//
+//  MessagesTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MessagesTests_h
+#define hifi_MessagesTests_h
+
+#include <QtTest/QtTest>
+
+class MessagesTests : public QObject {
+    Q_OBJECT
+private slots:
+    void coalesceTest();
+    void unlimitedTest();
+    void holdAndDropTest();
+    void removeNodeTest();
+    void decodeSeveralMessagesTest();
+    void decodeTruncatedMessagesTest();
+};
+
+#endif // hifi_MessagesTests_h
@@ -0,0 +1,156 @@
+//
+//  SocketReceiveTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SocketReceiveTests.h"
+
+#include <iostream>
+
+#include <QtNetwork/QUdpSocket>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <udt/Packet.h>
+#include <udt/PacketBufferPool.h>
+#include <udt/Socket.h>
+
+QTEST_MAIN(SocketReceiveTests)
+
+// Enable this to manually run receiveBenchmark
+// (NOT a regular unit test; sends 200,000 packets through each receive path)
+//#define MANUAL_TEST true
+
+static const int PACKET_PAYLOAD_SIZE = 512;
+static const int SEND_BURST_SIZE = 256;
+static const quint64 RECEIVE_TIMEOUT_USECS = 500 * USECS_PER_MSEC;
+
+struct ReceiveResult {
+    int numSent { 0 };
+    int numReceived { 0 };
+    quint64 elapsedUsecs { 0 };
+};
+
+static ReceiveResult sendAndReceive(bool batched, int numPackets, int numReceiveThreads = 1, int numSenders = 1) {
+    ReceiveResult result;
+
+    udt::Socket receiver;
+    receiver.setBatchedReceiveEnabled(batched);
+    receiver.setNumReceiveThreads(numReceiveThreads);
+    receiver.bind(QHostAddress::LocalHost);
+    receiver.setPacketHandler([&](std::unique_ptr<udt::Packet> packet) {
+        ++result.numReceived;
+    });
+
+    // every sender has its own port, so with SO_REUSEPORT the kernel can hash them to different receive shards
+    std::vector<std::unique_ptr<QUdpSocket>> senders;
+    for (int i = 0; i < numSenders; ++i) {
+        senders.emplace_back(new QUdpSocket);
+        senders.back()->bind(QHostAddress::LocalHost);
+    }
+
+    auto packet = udt::Packet::create();
+    QByteArray payload(PACKET_PAYLOAD_SIZE, 'x');
+    packet->write(payload);
+
+    auto startTime = usecTimestampNow();
+
+    while (result.numSent < numPackets) {
+        // send in bursts small enough to fit in the receive buffer, then let the receiver drain it
+        for (int i = 0; i < SEND_BURST_SIZE && result.numSent < numPackets; ++i) {
+            auto& sender = senders[result.numSent % numSenders];
+            sender->writeDatagram(packet->getData(), packet->getDataSize(), QHostAddress::LocalHost, receiver.localPort());
+            ++result.numSent;
+        }
+        QCoreApplication::processEvents();
+    }
+
+    // give the receiver a chance to pick up anything still queued
+    auto lastProgressTime = usecTimestampNow();
+    int lastNumReceived = result.numReceived;
+    while (result.numReceived < result.numSent && usecTimestampNow() - lastProgressTime < RECEIVE_TIMEOUT_USECS) {
+        QCoreApplication::processEvents();
+        if (result.numReceived != lastNumReceived) {
+            lastNumReceived = result.numReceived;
+            lastProgressTime = usecTimestampNow();
+        }
+    }
+
+    result.elapsedUsecs = usecTimestampNow() - startTime;
+    return result;
+}
+
+void SocketReceiveTests::packetBufferPoolTest() {
+    auto pool = udt::PacketBufferPool::create(1);
+
+    char* firstSlab = nullptr;
+    {
+        auto buffer = pool->acquire();
+        firstSlab = buffer.get();
+        QCOMPARE(pool->getNumAllocatedSlabs(), (size_t)1);
+        QCOMPARE(pool->getNumFreeSlabs(), (size_t)0);
+    }
+    QCOMPARE(pool->getNumFreeSlabs(), (size_t)1);
+
+    // the released slab is re-used
+    auto buffer = pool->acquire();
+    QCOMPARE(buffer.get(), firstSlab);
+    QCOMPARE(pool->getNumAllocatedSlabs(), (size_t)1);
+
+    // past the free list limit slabs go back to the heap
+    auto otherBuffer = pool->acquire();
+    QCOMPARE(pool->getNumAllocatedSlabs(), (size_t)2);
+    buffer.reset();
+    otherBuffer.reset();
+    QCOMPARE(pool->getNumFreeSlabs(), (size_t)1);
+    QCOMPARE(pool->getNumAllocatedSlabs(), (size_t)1);
+
+    // heap buffers still work as packet buffers
+    udt::PacketBuffer heapBuffer = std::unique_ptr<char[]>(new char[udt::MAX_PACKET_SIZE]);
+    QVERIFY(heapBuffer);
+}
+
+void SocketReceiveTests::batchedReceiveTest() {
+#if defined(Q_OS_LINUX)
+    const int NUM_PACKETS = 1000;
+    auto result = sendAndReceive(true, NUM_PACKETS);
+    QCOMPARE(result.numSent, NUM_PACKETS);
+    QCOMPARE(result.numReceived, NUM_PACKETS);
+#else
+    QSKIP("Batched receive is only supported on Linux");
+#endif
+}
+
+void SocketReceiveTests::shardedReceiveTest() {
+#if defined(Q_OS_LINUX)
+    const int NUM_PACKETS = 1000;
+    const int NUM_RECEIVE_THREADS = 4;
+    const int NUM_SENDERS = 16;
+    auto result = sendAndReceive(true, NUM_PACKETS, NUM_RECEIVE_THREADS, NUM_SENDERS);
+    QCOMPARE(result.numSent, NUM_PACKETS);
+    QCOMPARE(result.numReceived, NUM_PACKETS);
+#else
+    QSKIP("Sharded receive is only supported on Linux");
+#endif
+}
+
+void SocketReceiveTests::receiveBenchmark() {
+#if MANUAL_TEST
+    const int NUM_PACKETS = 200000;
+
+    for (bool batched : { false, true }) {
+        auto result = sendAndReceive(batched, NUM_PACKETS);
+        float seconds = (float)result.elapsedUsecs / (float)USECS_PER_SECOND;
+        std::cout << (batched ? "batched" : "per-datagram") << " receive: "
+            << result.numReceived << "/" << result.numSent << " packets in " << seconds << "s = "
+            << (int)(result.numReceived / seconds) << " packets/sec" << std::endl;
+    }
+#else
+    QSKIP("Define MANUAL_TEST in SocketReceiveTests.cpp to run the receive benchmark");
+#endif // MANUAL_TEST
+}
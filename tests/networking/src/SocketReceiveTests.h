@@ -0,0 +1,34 @@
+//
+//  SocketReceiveTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SocketReceiveTests_h
+#define hifi_SocketReceiveTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SocketReceiveTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that released slabs are handed back out by the pool
+    void packetBufferPoolTest();
+
+    // Test that the batched receive path delivers every datagram
+    void batchedReceiveTest();
+
+    // Test that every datagram arrives when receiving on several SO_REUSEPORT sockets
+    void shardedReceiveTest();
+
+    // Report packets/sec for the per-datagram and the batched receive paths (only when run manually)
+    void receiveBenchmark();
+};
+
+#endif // hifi_SocketReceiveTests_h
@@ -0,0 +1,53 @@
+//
+//  EntityEncodingTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodingTests.h"
+
+#include <OctreePacketData.h>
+#include <ShapeEntityItem.h>
+
+QTEST_MAIN(EntityEncodingTests)
+
+static QByteArray encode(const EntityItemPointer& entity, bool useEncodedDataCache) {
+    OctreePacketData packetData;
+    EncodeBitstreamParams params;
+    params.useEncodedDataCache = useEncodedDataCache;
+    EntityTreeElementExtraEncodeDataPointer extra { nullptr };
+    auto appendState = entity->appendEntityData(&packetData, params, extra);
+    if (appendState != OctreeElement::COMPLETED) {
+        return QByteArray();
+    }
+    return QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+}
+
+void EntityEncodingTests::reusesEncodingTest() {
+    auto entity = std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setQueryAACube(AACube(glm::vec3(0.0f), 1.0f));
+
+    QByteArray encoded = encode(entity, true);
+    QVERIFY(!encoded.isEmpty());
+    QCOMPARE(encode(entity, true), encoded);
+    QCOMPARE(encode(entity, false), encoded);
+}
+
+void EntityEncodingTests::queryAACubeChangeTest() {
+    auto entity = std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setQueryAACube(AACube(glm::vec3(0.0f), 1.0f));
+    QByteArray encoded = encode(entity, true);
+    QVERIFY(!encoded.isEmpty());
+
+    entity->setQueryAACube(AACube(glm::vec3(10.0f), 2.0f));
+    QByteArray reencoded = encode(entity, true);
+    QVERIFY(reencoded != encoded);
+    QCOMPARE(reencoded, encode(entity, false));
+
+    entity->setQueryAACube(AACube(glm::vec3(0.0f), 1.0f));
+    QCOMPARE(encode(entity, true), encoded);
+}
@@ -0,0 +1,24 @@
+//
+//  EntityEncodingTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodingTests_h
+#define hifi_EntityEncodingTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEncodingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void reusesEncodingTest();
+    void queryAACubeChangeTest(); // the query cube changes without the entity being edited
+};
+
+#endif // hifi_EntityEncodingTests_h
@@ -0,0 +1,87 @@
+//
+//  EntityLoadTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityLoadTests.h"
+
+#include <EntityTree.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(EntityLoadTests)
+
+static QVariantMap vec3ToMap(float x, float y, float z) {
+    return { { "x", x }, { "y", y }, { "z", z } };
+}
+
+// entities of every type, with the enum properties that are read from strings
+static QVariantList makeEntities(int numEntities) {
+    const QStringList TYPES = { "Box", "Sphere", "Shape", "Text", "Image", "Model", "Zone", "Light", "Gizmo", "Grid" };
+    const QStringList PULSE_MODES = { "none", "in", "out" };
+    const QStringList SHAPE_TYPES = { "none", "box", "sphere", "compound", "simple-hull", "static-mesh" };
+    const QStringList BILLBOARD_MODES = { "none", "yaw", "full" };
+
+    QVariantList entities;
+    for (int i = 0; i < numEntities; ++i) {
+        QVariantMap entity;
+        entity["id"] = QUuid::createUuid().toString();
+        entity["type"] = TYPES[i % TYPES.size()];
+        entity["name"] = QString("entity %1").arg(i);
+        entity["created"] = (double)(i + 1);
+        entity["position"] = vec3ToMap((float)(i % 97), (float)(i % 89), (float)(i % 83));
+        entity["dimensions"] = vec3ToMap(1.0f + (float)(i % 5), 1.0f, 1.0f + (float)(i % 3));
+        entity["shapeType"] = SHAPE_TYPES[i % SHAPE_TYPES.size()];
+        entity["billboardMode"] = BILLBOARD_MODES[i % BILLBOARD_MODES.size()];
+        entity["pulse"] = QVariantMap({ { "colorMode", PULSE_MODES[i % PULSE_MODES.size()] },
+                                        { "alphaMode", PULSE_MODES[(i + 1) % PULSE_MODES.size()] } });
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+static QMap<QString, QVariantMap> entitiesByID(const EntityTreePointer& tree) {
+    QVariantMap map;
+    tree->writeToMap(map, tree->getRoot(), true, false);
+    QMap<QString, QVariantMap> entities;
+    for (const QVariant& entity : map["Entities"].toList()) {
+        QVariantMap entityMap = entity.toMap();
+        // how long ago the entity was loaded
+        entityMap.remove("age");
+        entityMap.remove("ageAsText");
+        entityMap.remove("lastEdited");
+        entities[entityMap["id"].toString()] = entityMap;
+    }
+    return entities;
+}
+
+void EntityLoadTests::parallelLoadTest() {
+    const int NUM_ENTITIES = 2000;
+    const int version = versionForPacketType(PacketType::EntityData);
+    const QVariantList entities = makeEntities(NUM_ENTITIES);
+
+    EntityTreePointer parallelTree = std::make_shared<EntityTree>();
+    parallelTree->createRootElement();
+    QVariantMap map { { "Version", version }, { "Entities", entities } };
+    QVERIFY(parallelTree->readFromMap(map));
+    QCOMPARE(parallelTree->getLoadStats().numItems, NUM_ENTITIES);
+
+    EntityTreePointer serialTree = std::make_shared<EntityTree>();
+    serialTree->createRootElement();
+    for (const QVariant& entity : entities) {
+        QVariantMap entityMap { { "Version", version }, { "Entities", QVariantList({ entity }) } };
+        QVERIFY(serialTree->readFromMap(entityMap));
+    }
+
+    auto parallelEntities = entitiesByID(parallelTree);
+    auto serialEntities = entitiesByID(serialTree);
+    QCOMPARE(parallelEntities.size(), NUM_ENTITIES);
+    QCOMPARE(parallelEntities.keys(), serialEntities.keys());
+    for (const QString& id : parallelEntities.keys()) {
+        QCOMPARE(parallelEntities[id], serialEntities[id]);
+    }
+}
@@ -0,0 +1,23 @@
+//
+//  EntityLoadTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityLoadTests_h
+#define hifi_EntityLoadTests_h
+
+#include <QtTest/QtTest>
+
+class EntityLoadTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void parallelLoadTest(); // a load spread over threads gives the same entities as one entity at a time
+};
+
+#endif // hifi_EntityLoadTests_h
@@ -0,0 +1,151 @@
+//
+//  EntityPriorityQueueTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPriorityQueueTests.h"
+
+#include <cfloat>
+#include <random>
+#include <unordered_map>
+
+#include <EntityPriorityQueue.h>
+#include <ShapeEntityItem.h>
+
+QTEST_MAIN(EntityPriorityQueueTests)
+
+static EntityItemPointer makeEntity() {
+    return std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+}
+
+void EntityPriorityQueueTests::verifyHeap(const EntityPriorityQueue& queue) {
+    QCOMPARE(queue._heap.size(), queue._indices.size());
+    for (size_t i = 0; i < queue._heap.size(); ++i) {
+        auto index = queue._indices.find(queue._heap[i].getRawEntityPointer());
+        QVERIFY(index != queue._indices.end());
+        QCOMPARE(index->second, i);
+        if (i > 0) {
+            QVERIFY(queue._heap[i].getPriority() <= queue._heap[(i - 1) / 2].getPriority());
+        }
+    }
+}
+
+void EntityPriorityQueueTests::popsInPriorityOrder() {
+    EntityPriorityQueue queue;
+    QVERIFY(queue.empty());
+
+    std::vector<EntityItemPointer> entities;
+    const float priorities[] = { 3.0f, 1.0f, 4.0f, 1.0f, 5.0f, 9.0f, 2.0f, 6.0f };
+    for (float priority : priorities) {
+        entities.push_back(makeEntity());
+        queue.emplace(entities.back(), priority);
+        verifyHeap(queue);
+    }
+    QCOMPARE(queue.size(), entities.size());
+
+    float lastPriority = FLT_MAX;
+    while (!queue.empty()) {
+        QVERIFY(queue.top().getPriority() <= lastPriority);
+        lastPriority = queue.top().getPriority();
+        QVERIFY(queue.contains(queue.top().getRawEntityPointer()));
+        const EntityItem* popped = queue.top().getRawEntityPointer();
+        queue.pop();
+        QVERIFY(!queue.contains(popped));
+        verifyHeap(queue);
+    }
+    QCOMPARE(lastPriority, 1.0f);
+}
+
+void EntityPriorityQueueTests::randomOperations() {
+    const int NUM_ENTITIES = 200;
+    const int NUM_OPERATIONS = 20000;
+
+    std::mt19937 engine(1234);
+    auto randomIndex = [&](size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(engine); };
+    // few distinct priorities, so that there are ties
+    auto randomPriority = [&] { return (float)std::uniform_int_distribution<int>(0, 30)(engine) * 0.5f; };
+
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(makeEntity());
+    }
+
+    struct Expected {
+        float priority;
+        bool forceRemove;
+    };
+    // what the queue should hold, searched in full for the highest priority
+    std::unordered_map<const EntityItem*, Expected> expected;
+
+    EntityPriorityQueue queue;
+    for (int operation = 0; operation < NUM_OPERATIONS; ++operation) {
+        size_t which = randomIndex(100);
+        if (which < 35) {
+            const EntityItemPointer& entity = entities[randomIndex(entities.size())];
+            if (!queue.contains(entity.get())) {
+                bool forceRemove = randomIndex(2) == 0;
+                float priority = randomPriority();
+                queue.emplace(entity, priority, forceRemove);
+                expected[entity.get()] = { priority, forceRemove };
+            }
+        } else if (which < 65) {
+            // queued or not
+            const EntityItemPointer& entity = entities[randomIndex(entities.size())];
+            bool forceRemove = randomIndex(2) == 0;
+            float priority = randomPriority();
+            queue.update(entity, priority, forceRemove);
+            expected[entity.get()] = { priority, forceRemove };
+        } else if (which < 98) {
+            if (expected.empty()) {
+                QVERIFY(queue.empty());
+                continue;
+            }
+            float highest = -FLT_MAX;
+            for (const auto& entry : expected) {
+                highest = std::max(highest, entry.second.priority);
+            }
+            const PrioritizedEntity& top = queue.top();
+            QCOMPARE(top.getPriority(), highest);
+            auto found = expected.find(top.getRawEntityPointer());
+            QVERIFY(found != expected.end());
+            QCOMPARE(found->second.priority, highest);
+            QCOMPARE(top.shouldForceRemove(), found->second.forceRemove);
+            QVERIFY(top.getEntity());
+            expected.erase(found);
+            queue.pop();
+        } else {
+            // new priorities for all, and some dropped
+            std::unordered_map<const EntityItem*, float> priorities;
+            for (auto& entry : expected) {
+                float priority = randomIndex(10) == 0 ? PrioritizedEntity::DO_NOT_SEND : randomPriority();
+                priorities[entry.first] = priority;
+            }
+            queue.reprioritize([&](const PrioritizedEntity& entity) {
+                return priorities.at(entity.getRawEntityPointer());
+            });
+            for (auto it = expected.begin(); it != expected.end();) {
+                float priority = priorities[it->first];
+                if (priority == PrioritizedEntity::DO_NOT_SEND) {
+                    it = expected.erase(it);
+                } else {
+                    it->second.priority = priority;
+                    ++it;
+                }
+            }
+        }
+
+        QCOMPARE(queue.size(), expected.size());
+        for (const auto& entity : entities) {
+            QCOMPARE(queue.contains(entity.get()), expected.count(entity.get()) > 0);
+        }
+        verifyHeap(queue);
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
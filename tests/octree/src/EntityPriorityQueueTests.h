@@ -0,0 +1,30 @@
+//
+//  EntityPriorityQueueTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPriorityQueueTests_h
+#define hifi_EntityPriorityQueueTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPriorityQueue;
+
+class EntityPriorityQueueTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void popsInPriorityOrder();
+    void randomOperations(); // random pushes, pops, updates and reprioritizations against a brute-force queue
+
+private:
+    // the heap is ordered, and the index of each entity is where it is in the heap
+    void verifyHeap(const EntityPriorityQueue& queue);
+};
+
+#endif // hifi_EntityPriorityQueueTests_h
@@ -0,0 +1,206 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <functional>
+#include <random>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <EntitySpatialIndex.h>
+#include <ShapeEntityItem.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+// the index compares in SIMD lanes, in another order than the brute force: only results this far from the edge count
+static const float SLACK = 1.0e-3f;
+
+static const float WORLD_HALF_SIZE = 500.0f;
+
+// how far a point is from a box, zero if it is inside
+static float distanceToBox(const glm::vec3& point, const AABox& box) {
+    glm::vec3 outside = glm::max(box.getMinimumPoint() - point, glm::vec3(0.0f)) +
+        glm::max(point - box.getMaximumPoint(), glm::vec3(0.0f));
+    return glm::length(outside);
+}
+
+static AABox grow(const AABox& box, float slack) {
+    return AABox(box.getMinimumPoint() - glm::vec3(slack), box.getDimensions() + glm::vec3(2.0f * slack));
+}
+
+// the index's frustum test: the box isn't wholly outside any plane, or it touches the keyhole
+static bool touchesView(const ViewFrustum& frustum, const AABox& box, float slack) {
+    AABox grown = grow(box, slack);
+    if (distanceToBox(frustum.getPosition(), grown) <= frustum.getCenterRadius()) {
+        return true;
+    }
+    const ::Plane* planes = frustum.getPlanes();
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        if (planes[i].distance(grown.getFarthestVertex(planes[i].getNormal())) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class RandomEntities {
+public:
+    RandomEntities(EntitySpatialIndex& index) : _index(index) {}
+
+    float random(float low, float high) { return std::uniform_real_distribution<float>(low, high)(_engine); }
+    size_t random(size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(_engine); }
+
+    // a cube of the size of an octree element
+    AACube randomCube() {
+        float size = exp2f((float)(int)random(-3.0f, 7.0f));
+        glm::vec3 corner(random(-WORLD_HALF_SIZE, WORLD_HALF_SIZE), random(-WORLD_HALF_SIZE, WORLD_HALF_SIZE),
+            random(-WORLD_HALF_SIZE, WORLD_HALF_SIZE));
+        return AACube(glm::floor(corner / size) * size, size);
+    }
+
+    void add() {
+        EntityItemPointer entity = std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+        AACube cube = randomCube();
+        _index.insert(entity, cube);
+        _entities.push_back(entity);
+        _cubes[entity->getID()] = cube;
+    }
+
+    void move() {
+        EntityItemPointer entity = _entities[random(_entities.size())];
+        AACube cube = randomCube();
+        _index.insert(entity, cube);
+        _cubes[entity->getID()] = cube;
+    }
+
+    void remove() {
+        size_t which = random(_entities.size());
+        _index.remove(_entities[which]);
+        _cubes.remove(_entities[which]->getID());
+        _entities[which] = _entities.back();
+        _entities.pop_back();
+    }
+
+    size_t size() const { return _entities.size(); }
+
+    // compares a query's result with a scan of all the entities, touches tells if an entity's cube touches the
+    // queried volume once grown by the slack
+    void compare(const std::vector<EntityItemPointer>& found, const std::function<bool(const AABox&, float)>& touches,
+                 const char* query) {
+        QSet<QUuid> foundIDs;
+        for (const auto& entity : found) {
+            QVERIFY2(!foundIDs.contains(entity->getID()), query);
+            QVERIFY2(_cubes.contains(entity->getID()), query);
+            foundIDs.insert(entity->getID());
+            QVERIFY2(touches(AABox(_cubes[entity->getID()]), SLACK), query);
+        }
+        for (const auto& entity : _entities) {
+            if (touches(AABox(_cubes[entity->getID()]), -SLACK)) {
+                QVERIFY2(foundIDs.contains(entity->getID()), query);
+            }
+        }
+    }
+
+    void query() {
+        std::vector<EntityItemPointer> found;
+
+        glm::vec3 center(random(-WORLD_HALF_SIZE, WORLD_HALF_SIZE), random(-WORLD_HALF_SIZE, WORLD_HALF_SIZE),
+            random(-WORLD_HALF_SIZE, WORLD_HALF_SIZE));
+        float radius = random(0.0f, 100.0f);
+        _index.findTouchingSphere(center, radius, found);
+        compare(found, [&](const AABox& box, float slack) {
+            return distanceToBox(center, box) <= radius + slack;
+        }, "sphere");
+
+        found.clear();
+        glm::vec3 dimensions(random(0.0f, 200.0f), random(0.0f, 200.0f), random(0.0f, 200.0f));
+        AABox box(center - 0.5f * dimensions, dimensions);
+        _index.findTouchingBox(box, found);
+        compare(found, [&](const AABox& cube, float slack) {
+            return grow(cube, slack).touches(box);
+        }, "box");
+
+        found.clear();
+        ViewFrustum frustum;
+        frustum.setPosition(center);
+        frustum.setOrientation(glm::normalize(glm::quat(random(-1.0f, 1.0f), random(-1.0f, 1.0f), random(-1.0f, 1.0f),
+            random(-1.0f, 1.0f))));
+        frustum.setProjection(random(30.0f, 90.0f), random(1.0f, 2.0f), DEFAULT_NEAR_CLIP, random(50.0f, 800.0f));
+        frustum.setCenterRadius(random(0.0f, 20.0f));
+        frustum.calculate();
+        _index.findInView(frustum, found);
+        compare(found, [&](const AABox& cube, float slack) {
+            return touchesView(frustum, cube, slack);
+        }, "frustum");
+    }
+
+private:
+    EntitySpatialIndex& _index;
+    std::mt19937 _engine { 1234 };
+    std::vector<EntityItemPointer> _entities;
+    QHash<QUuid, AACube> _cubes;
+};
+
+void EntitySpatialIndexTests::emptyIndex() {
+    EntitySpatialIndex index;
+    std::vector<EntityItemPointer> found;
+    index.findTouchingSphere(glm::vec3(0.0f), 1000.0f, found);
+    index.findTouchingBox(AABox(glm::vec3(-1000.0f), 2000.0f), found);
+    QVERIFY(found.empty());
+    QCOMPARE(index.size(), 0);
+
+    // nor is anything found once the only entity is removed
+    EntityItemPointer entity = std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+    index.insert(entity, AACube(glm::vec3(0.0f), 1.0f));
+    QCOMPARE(index.size(), 1);
+    index.remove(entity);
+    QCOMPARE(index.size(), 0);
+    index.findTouchingSphere(glm::vec3(0.0f), 1000.0f, found);
+    QVERIFY(found.empty());
+}
+
+void EntitySpatialIndexTests::queriesMatchBruteForce() {
+    const int NUM_ROUNDS = 30;
+    const int NUM_QUERIES_PER_ROUND = 10;
+
+    EntitySpatialIndex index;
+    RandomEntities entities(index);
+
+    for (int round = 0; round < NUM_ROUNDS; ++round) {
+        // rounds of a few changes query the unsorted tail and the removed entries, bigger ones rebuild the index
+        int numChanges = round % 3 == 0 ? 500 : 20;
+        for (int i = 0; i < numChanges; ++i) {
+            size_t operation = entities.random(4);
+            if (entities.size() == 0 || operation < 2) {
+                entities.add();
+            } else if (operation == 2) {
+                entities.move();
+            } else {
+                entities.remove();
+            }
+        }
+        QCOMPARE(index.size(), (int)entities.size());
+
+        for (int i = 0; i < NUM_QUERIES_PER_ROUND; ++i) {
+            entities.query();
+            if (QTest::currentTestFailed()) {
+                return;
+            }
+        }
+    }
+
+    // and once all are removed
+    while (entities.size() > 0) {
+        entities.remove();
+    }
+    QCOMPARE(index.size(), 0);
+    entities.query();
+}
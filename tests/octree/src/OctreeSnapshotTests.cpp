@@ -0,0 +1,296 @@
+//
+//  OctreeSnapshotTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshotTests.h"
+
+#include <cstring>
+
+#include <QFile>
+#include <QMap>
+
+#include <OctreeJournal.h>
+#include <OctreeSnapshot.h>
+
+QTEST_MAIN(OctreeSnapshotTests)
+
+static const PacketVersion CONTENT_VERSION = 42;
+static const int64_t DATA_VERSION = 7;
+
+struct JournalRecord {
+    OctreeJournal::RecordType type;
+    QUuid id;
+    QByteArray data;
+};
+
+static QByteArray makeRecord(int i) {
+    // records of varied sizes, some empty
+    return QByteArray(i % 7 * 37, (char)('a' + i % 26));
+}
+
+static QList<JournalRecord> replayAll(const QString& fileName, const QUuid& snapshotID, int& numReplayed) {
+    QList<JournalRecord> records;
+    numReplayed = OctreeJournal::replay(fileName, snapshotID, DATA_VERSION, CONTENT_VERSION,
+        [&](OctreeJournal::RecordType type, const QUuid& id, const QByteArray& data) {
+            records.push_back({ type, id, data });
+        });
+    return records;
+}
+
+static void truncateFile(const QString& fileName, int numBytes) {
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - numBytes));
+}
+
+void OctreeSnapshotTests::initTestCase() {
+    QVERIFY(_dir.isValid());
+}
+
+QString OctreeSnapshotTests::filePath(const QString& name) const {
+    return _dir.filePath(name);
+}
+
+void OctreeSnapshotTests::snapshotRoundTrip() {
+    const QString fileName = filePath("roundTrip.ents");
+    const QUuid snapshotID = QUuid::createUuid();
+    const QByteArray metadata = "{\"Id\":\"test\"}";
+    const int NUM_RECORDS = 100;
+
+    QMap<QUuid, QByteArray> records;
+    OctreeSnapshot::Writer writer(fileName, CONTENT_VERSION, snapshotID, DATA_VERSION);
+    QVERIFY(writer.open());
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        QUuid id = QUuid::createUuid();
+        records[id] = makeRecord(i);
+        QVERIFY(writer.addRecord(id, records[id]));
+    }
+    writer.setMetadata(metadata);
+    QVERIFY(writer.commit());
+
+    OctreeSnapshot::Reader reader;
+    QVERIFY(reader.open(fileName));
+    QCOMPARE(reader.getID(), snapshotID);
+    QCOMPARE(reader.getDataVersion(), DATA_VERSION);
+    QCOMPARE(reader.getContentVersion(), CONTENT_VERSION);
+    QCOMPARE(reader.getMetadata(), metadata);
+    QCOMPARE(reader.getNumRecords(), NUM_RECORDS);
+
+    // every record reads back, through the index and through a lookup
+    QSet<QUuid> seen;
+    for (int i = 0; i < reader.getNumRecords(); ++i) {
+        QUuid id = reader.getRecordID(i);
+        QVERIFY(records.contains(id));
+        QCOMPARE(reader.getRecord(i), records[id]);
+        QCOMPARE(reader.findRecord(id), i);
+        seen.insert(id);
+    }
+    QCOMPARE(seen.size(), NUM_RECORDS);
+    QCOMPARE(reader.findRecord(QUuid::createUuid()), -1);
+    reader.close();
+}
+
+void OctreeSnapshotTests::emptySnapshot() {
+    const QString fileName = filePath("empty.ents");
+    const QUuid snapshotID = QUuid::createUuid();
+
+    OctreeSnapshot::Writer writer(fileName, CONTENT_VERSION, snapshotID, DATA_VERSION);
+    QVERIFY(writer.open());
+    QVERIFY(writer.commit());
+
+    OctreeSnapshot::Reader reader;
+    QVERIFY(reader.open(fileName));
+    QCOMPARE(reader.getID(), snapshotID);
+    QCOMPARE(reader.getNumRecords(), 0);
+    QCOMPARE(reader.findRecord(snapshotID), -1);
+    QVERIFY(reader.getMetadata().isEmpty());
+}
+
+void OctreeSnapshotTests::snapshotInfo() {
+    const QString fileName = filePath("info.ents");
+    const QUuid snapshotID = QUuid::createUuid();
+
+    OctreeSnapshot::Writer writer(fileName, CONTENT_VERSION, snapshotID, DATA_VERSION);
+    QVERIFY(writer.open());
+    QVERIFY(writer.addRecord(QUuid::createUuid(), makeRecord(1)));
+    QVERIFY(writer.commit());
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray data = file.readAll();
+    QVERIFY(OctreeSnapshot::isSnapshot(data));
+
+    QUuid id;
+    int64_t dataVersion = 0;
+    PacketVersion contentVersion = 0;
+    QVERIFY(OctreeSnapshot::readInfo(data, id, dataVersion, contentVersion));
+    QCOMPARE(id, snapshotID);
+    QCOMPARE(dataVersion, DATA_VERSION);
+    QCOMPARE(contentVersion, CONTENT_VERSION);
+
+    // JSON, or a header cut short, isn't a snapshot
+    QVERIFY(!OctreeSnapshot::isSnapshot("{\"Entities\":[]}"));
+    QVERIFY(!OctreeSnapshot::readInfo(data.left(sizeof(OctreeSnapshot::Header) - 1), id, dataVersion, contentVersion));
+}
+
+void OctreeSnapshotTests::truncatedSnapshot() {
+    const QString fileName = filePath("truncated.ents");
+
+    OctreeSnapshot::Writer writer(fileName, CONTENT_VERSION, QUuid::createUuid(), DATA_VERSION);
+    QVERIFY(writer.open());
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(writer.addRecord(QUuid::createUuid(), makeRecord(i)));
+    }
+    writer.setMetadata("metadata");
+    QVERIFY(writer.commit());
+
+    // the index and metadata no longer fit in the file
+    truncateFile(fileName, sizeof(OctreeSnapshot::IndexEntry));
+    OctreeSnapshot::Reader reader;
+    QVERIFY(!reader.open(fileName));
+}
+
+void OctreeSnapshotTests::journalReplay() {
+    const QString fileName = filePath("replay.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+
+    QList<JournalRecord> expected;
+    for (int i = 0; i < 20; ++i) {
+        auto type = i % 4 == 3 ? OctreeJournal::Erase : OctreeJournal::Update;
+        expected.push_back({ type, QUuid::createUuid(), type == OctreeJournal::Update ? makeRecord(i) : QByteArray() });
+    }
+
+    OctreeJournal journal(fileName);
+    QVERIFY(journal.reset(snapshotID, DATA_VERSION, CONTENT_VERSION));
+    QVERIFY(!OctreeJournal::hasRecords(fileName));
+    for (const auto& record : expected) {
+        QVERIFY(journal.append(record.type, record.id, record.data));
+    }
+    QVERIFY(journal.flush());
+    QVERIFY(OctreeJournal::hasRecords(fileName));
+
+    int numReplayed = 0;
+    QList<JournalRecord> replayed = replayAll(fileName, snapshotID, numReplayed);
+    QCOMPARE(numReplayed, expected.size());
+    QCOMPARE(replayed.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        QCOMPARE(replayed[i].type, expected[i].type);
+        QCOMPARE(replayed[i].id, expected[i].id);
+        QCOMPARE(replayed[i].data, expected[i].data);
+    }
+
+    // a reset starts over, on the new snapshot
+    const QUuid nextSnapshotID = QUuid::createUuid();
+    QVERIFY(journal.reset(nextSnapshotID, DATA_VERSION, CONTENT_VERSION));
+    QVERIFY(!OctreeJournal::hasRecords(fileName));
+    QCOMPARE(replayAll(fileName, nextSnapshotID, numReplayed).size(), 0);
+    QCOMPARE(numReplayed, 0);
+}
+
+void OctreeSnapshotTests::journalOfOtherSnapshot() {
+    const QString fileName = filePath("other.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+
+    OctreeJournal journal(fileName);
+    QVERIFY(journal.reset(snapshotID, DATA_VERSION, CONTENT_VERSION));
+    QVERIFY(journal.append(OctreeJournal::Update, QUuid::createUuid(), makeRecord(1)));
+    QVERIFY(journal.flush());
+
+    int numReplayed = 0;
+    QVERIFY(replayAll(fileName, QUuid::createUuid(), numReplayed).isEmpty());
+    QCOMPARE(numReplayed, 0);
+
+    // nor is it replayed on another version of the same snapshot
+    numReplayed = OctreeJournal::replay(fileName, snapshotID, DATA_VERSION + 1, CONTENT_VERSION,
+        [](OctreeJournal::RecordType, const QUuid&, const QByteArray&) { QFAIL("replayed a journal of another snapshot"); });
+    QCOMPARE(numReplayed, 0);
+}
+
+void OctreeSnapshotTests::truncatedJournalRecord() {
+    const QString fileName = filePath("truncated.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+    const int NUM_RECORDS = 5;
+
+    QList<QUuid> ids;
+    {
+        OctreeJournal journal(fileName);
+        QVERIFY(journal.reset(snapshotID, DATA_VERSION, CONTENT_VERSION));
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            ids.push_back(QUuid::createUuid());
+            QVERIFY(journal.append(OctreeJournal::Update, ids.back(), makeRecord(i + 1)));
+        }
+        QVERIFY(journal.flush());
+    }
+
+    // a crash while the last record was appended, at every length it could have been cut to
+    const int lastRecordSize = sizeof(uint32_t) + sizeof(uint8_t) + 16 + makeRecord(NUM_RECORDS).size() + sizeof(uint16_t);
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray whole = file.readAll();
+    file.close();
+
+    for (int cut = 1; cut <= lastRecordSize; ++cut) {
+        QFile truncated(fileName);
+        QVERIFY(truncated.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QVERIFY(truncated.write(whole.left(whole.size() - cut)) == whole.size() - cut);
+        truncated.close();
+
+        int numReplayed = 0;
+        QList<JournalRecord> replayed = replayAll(fileName, snapshotID, numReplayed);
+        QCOMPARE(numReplayed, NUM_RECORDS - 1);
+        QCOMPARE(replayed.size(), NUM_RECORDS - 1);
+        for (int i = 0; i < replayed.size(); ++i) {
+            QCOMPARE(replayed[i].id, ids[i]);
+            QCOMPARE(replayed[i].data, makeRecord(i + 1));
+        }
+    }
+}
+
+void OctreeSnapshotTests::tornJournalRecord() {
+    const QString fileName = filePath("torn.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+    const int NUM_RECORDS = 5;
+
+    {
+        OctreeJournal journal(fileName);
+        QVERIFY(journal.reset(snapshotID, DATA_VERSION, CONTENT_VERSION));
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            QVERIFY(journal.append(OctreeJournal::Update, QUuid::createUuid(), makeRecord(i + 1)));
+        }
+        QVERIFY(journal.flush());
+    }
+
+    // the last record is whole in length, but part of its data never made it to the disk
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray data = file.readAll();
+    const int lastDataSize = makeRecord(NUM_RECORDS).size();
+    QVERIFY(lastDataSize > 0);
+    data[data.size() - (int)sizeof(uint16_t) - lastDataSize / 2] ^= (char)0xff;
+    QVERIFY(file.seek(0));
+    QVERIFY(file.write(data) == data.size());
+    file.close();
+
+    int numReplayed = 0;
+    QCOMPARE(replayAll(fileName, snapshotID, numReplayed).size(), NUM_RECORDS - 1);
+    QCOMPARE(numReplayed, NUM_RECORDS - 1);
+
+    // nor does a size past the end of the file, as left by a torn size field, read past it
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    data = file.readAll();
+    const int lastRecordSize = sizeof(uint32_t) + sizeof(uint8_t) + 16 + lastDataSize + sizeof(uint16_t);
+    uint32_t hugeSize = 0x7fffffff;
+    memcpy(data.data() + data.size() - lastRecordSize, &hugeSize, sizeof(hugeSize));
+    QVERIFY(file.seek(0));
+    QVERIFY(file.write(data) == data.size());
+    file.close();
+
+    QCOMPARE(replayAll(fileName, snapshotID, numReplayed).size(), NUM_RECORDS - 1);
+    QCOMPARE(numReplayed, NUM_RECORDS - 1);
+}
@@ -0,0 +1,41 @@
+//
+//  OctreeSnapshotTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSnapshotTests_h
+#define hifi_OctreeSnapshotTests_h
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class OctreeSnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // snapshots
+    void snapshotRoundTrip();
+    void emptySnapshot();
+    void snapshotInfo();
+    void truncatedSnapshot();
+
+    // journals
+    void journalReplay();
+    void journalOfOtherSnapshot();
+    void truncatedJournalRecord();
+    void tornJournalRecord();
+
+private:
+    QString filePath(const QString& name) const;
+
+    QTemporaryDir _dir;
+};
+
+#endif // hifi_OctreeSnapshotTests_h
@@ -53,6 +53,10 @@ typedef PropertyFlags<ExamplePropertyList> ExamplePropertyFlags;
 
 QTEST_MAIN(OctreeTests)
 
+// Enable this to manually run elementTreeBuildBenchmark and elementTreeTraversalBenchmark
+// (NOT regular unit tests; build trees of about 300k elements)
+//#define MANUAL_TEST true
+
 void OctreeTests::propertyFlagsTests() {
     bool verbose = true;
     
@@ -827,3 +831,55 @@ void OctreeTests::elementAddChildTests() {
         }
     }
 }
+
+#if MANUAL_TEST
+// a full tree this deep is 8^6 leaves, about 300k elements
+static const int BENCHMARK_TREE_DEPTH = 6;
+
+static void addChildren(const OctreeElementPointer& element, int depth) {
+    if (depth == 0) {
+        return;
+    }
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        addChildren(element->addChildAtIndex(i), depth - 1);
+    }
+}
+
+static int countLeaves(const OctreeElementPointer& element) {
+    int numLeaves = element->isLeaf() ? 1 : 0;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        OctreeElementPointer child = element->getChildAtIndex(i);
+        if (child) {
+            numLeaves += countLeaves(child);
+        }
+    }
+    return numLeaves;
+}
+#endif // MANUAL_TEST
+
+void OctreeTests::elementTreeBuildBenchmark() {
+#if MANUAL_TEST
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    QBENCHMARK {
+        auto root = tree->createNewElement();
+        addChildren(root, BENCHMARK_TREE_DEPTH);
+    }
+#else
+    QSKIP("Define MANUAL_TEST in OctreeTests.cpp to run the tree build benchmark");
+#endif // MANUAL_TEST
+}
+
+void OctreeTests::elementTreeTraversalBenchmark() {
+#if MANUAL_TEST
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    auto root = tree->createNewElement();
+    addChildren(root, BENCHMARK_TREE_DEPTH);
+
+    const int NUM_LEAVES = 1 << (3 * BENCHMARK_TREE_DEPTH);
+    QBENCHMARK {
+        QCOMPARE(countLeaves(root), NUM_LEAVES);
+    }
+#else
+    QSKIP("Define MANUAL_TEST in OctreeTests.cpp to run the tree traversal benchmark");
+#endif // MANUAL_TEST
+}
@@ -27,6 +27,10 @@ private slots:
 
     void elementAddChildTests();
 
+    // building and walking a full tree, which is mostly allocating and chasing elements
+    void elementTreeBuildBenchmark();
+    void elementTreeTraversalBenchmark();
+
     // TODO: Break these into separate test functions
 };
 
@@ -0,0 +1,208 @@
+//
+// JointPackingTests.cpp
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointPackingTests.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <GLMHelpers.h>
+#include <glm/gtc/random.hpp>
+
+QTEST_MAIN(JointPackingTests)
+
+// about the number of joints of an avatar
+const int NUM_BENCHMARK_JOINTS = 128;
+
+// the components of count quaternions, one array per component
+struct Quats {
+    std::array<std::vector<float>, 4> components;
+
+    Quats(int count) {
+        for (auto& component : components) {
+            component.resize(count);
+        }
+    }
+    void set(int n, const glm::quat& quat) {
+        for (int i = 0; i < 4; ++i) {
+            components[i][n] = quat[i];
+        }
+    }
+    glm::quat get(int n) const {
+        glm::quat quat;
+        for (int i = 0; i < 4; ++i) {
+            quat[i] = components[i][n];
+        }
+        return quat;
+    }
+    std::array<const float*, 4> constPointers() const {
+        return {{ components[0].data(), components[1].data(), components[2].data(), components[3].data() }};
+    }
+    std::array<float*, 4> pointers() {
+        return {{ components[0].data(), components[1].data(), components[2].data(), components[3].data() }};
+    }
+};
+
+static glm::quat randomUnitQuat() {
+    glm::vec4 components = glm::linearRand(glm::vec4(-1.0f), glm::vec4(1.0f));
+    return glm::normalize(glm::quat(components.w, components.x, components.y, components.z));
+}
+
+static glm::quat randomQuat(int n) {
+    switch (n % 5) {
+        case 0:
+            // ties between the largest components
+            return glm::quat(0.5f, -0.5f, 0.5f, (n & 8) ? 0.5f : -0.5f);
+        case 1:
+            // a single axis, and signed zeros
+            return glm::angleAxis(glm::linearRand(-PI, PI), glm::vec3(0.0f, (n & 8) ? -0.0f : 0.0f, 1.0f));
+        case 2:
+            // slightly off unit length, as they come from the animation
+            return randomUnitQuat() * 1.0001f;
+        default:
+            return randomUnitQuat();
+    }
+}
+
+void JointPackingTests::quatsTest() {
+    // every count, for every remainder of the SIMD batches
+    for (int count = 0; count < 2 * NUM_BENCHMARK_JOINTS; ++count) {
+        Quats quats(count);
+        for (int n = 0; n < count; ++n) {
+            quats.set(n, randomQuat(n + count));
+        }
+
+        QByteArray expected(count * 6, 0);
+        unsigned char* destination = reinterpret_cast<unsigned char*>(expected.data());
+        for (int n = 0; n < count; ++n) {
+            destination += packOrientationQuatToSixBytes(destination, quats.get(n));
+        }
+        QByteArray packed(count * 6, 0);
+        QCOMPARE(packOrientationQuatsToSixBytes(reinterpret_cast<unsigned char*>(packed.data()),
+                                                quats.constPointers().data(), count), count * 6);
+        QCOMPARE(packed, expected);
+
+        Quats unpacked(count);
+        QCOMPARE(unpackOrientationQuatsFromSixBytes(reinterpret_cast<const unsigned char*>(packed.constData()),
+                                                    unpacked.pointers().data(), count), count * 6);
+        const unsigned char* source = reinterpret_cast<const unsigned char*>(packed.constData());
+        for (int n = 0; n < count; ++n) {
+            glm::quat quat;
+            source += unpackOrientationQuatFromSixBytes(source, quat);
+            glm::quat batchQuat = unpacked.get(n);
+            QVERIFY(memcmp(&quat, &batchQuat, sizeof(glm::quat)) == 0);
+        }
+    }
+}
+
+void JointPackingTests::vec3sTest() {
+    const int TRANSLATION_RADIX = 14;
+    const int HAND_CONTROLLER_RADIX = 12;
+    for (int radix : { TRANSLATION_RADIX, HAND_CONTROLLER_RADIX, 0 }) {
+        for (int count = 0; count < 2 * NUM_BENCHMARK_JOINTS; ++count) {
+            std::array<std::vector<float>, 3> components;
+            for (auto& component : components) {
+                component.resize(count);
+                for (int n = 0; n < count; ++n) {
+                    // some out of the fixed point range, to be clamped
+                    component[n] = glm::linearRand(-1.0f, 1.0f) * ((n % 7 == 0) ? 65536.0f : 1.0f);
+                }
+            }
+            const float* const constPointers[3] = { components[0].data(), components[1].data(), components[2].data() };
+
+            QByteArray expected(count * 6, 0);
+            unsigned char* destination = reinterpret_cast<unsigned char*>(expected.data());
+            for (int n = 0; n < count; ++n) {
+                glm::vec3 vector(components[0][n], components[1][n], components[2][n]);
+                destination += packFloatVec3ToSignedTwoByteFixed(destination, vector, radix);
+            }
+            QByteArray packed(count * 6, 0);
+            QCOMPARE(packFloatVec3sToSignedTwoByteFixed(reinterpret_cast<unsigned char*>(packed.data()), constPointers,
+                                                        count, radix), count * 6);
+            QCOMPARE(packed, expected);
+
+            std::array<std::vector<float>, 3> unpacked;
+            for (auto& component : unpacked) {
+                component.resize(count);
+            }
+            float* const pointers[3] = { unpacked[0].data(), unpacked[1].data(), unpacked[2].data() };
+            QCOMPARE(unpackFloatVec3sFromSignedTwoByteFixed(reinterpret_cast<const unsigned char*>(packed.constData()),
+                                                            pointers, count, radix), count * 6);
+            const unsigned char* source = reinterpret_cast<const unsigned char*>(packed.constData());
+            for (int n = 0; n < count; ++n) {
+                glm::vec3 vector;
+                source += unpackFloatVec3FromSignedTwoByteFixed(source, vector, radix);
+                glm::vec3 batchVector(unpacked[0][n], unpacked[1][n], unpacked[2][n]);
+                QVERIFY(memcmp(&vector, &batchVector, sizeof(glm::vec3)) == 0);
+            }
+        }
+    }
+}
+
+void JointPackingTests::packQuatsBenchmark_data() {
+    QTest::addColumn<bool>("batch");
+    QTest::newRow("one at a time") << false;
+    QTest::newRow("batch") << true;
+}
+
+void JointPackingTests::packQuatsBenchmark() {
+    QFETCH(bool, batch);
+
+    Quats quats(NUM_BENCHMARK_JOINTS);
+    for (int n = 0; n < NUM_BENCHMARK_JOINTS; ++n) {
+        quats.set(n, randomQuat(n));
+    }
+    auto components = quats.constPointers();
+    std::vector<unsigned char> buffer(NUM_BENCHMARK_JOINTS * 6);
+
+    QBENCHMARK {
+        if (batch) {
+            packOrientationQuatsToSixBytes(buffer.data(), components.data(), NUM_BENCHMARK_JOINTS);
+        } else {
+            unsigned char* destination = buffer.data();
+            for (int n = 0; n < NUM_BENCHMARK_JOINTS; ++n) {
+                destination += packOrientationQuatToSixBytes(destination, quats.get(n));
+            }
+        }
+    }
+}
+
+void JointPackingTests::unpackQuatsBenchmark_data() {
+    QTest::addColumn<bool>("batch");
+    QTest::newRow("one at a time") << false;
+    QTest::newRow("batch") << true;
+}
+
+void JointPackingTests::unpackQuatsBenchmark() {
+    QFETCH(bool, batch);
+
+    Quats quats(NUM_BENCHMARK_JOINTS);
+    for (int n = 0; n < NUM_BENCHMARK_JOINTS; ++n) {
+        quats.set(n, randomQuat(n));
+    }
+    std::vector<unsigned char> buffer(NUM_BENCHMARK_JOINTS * 6);
+    packOrientationQuatsToSixBytes(buffer.data(), quats.constPointers().data(), NUM_BENCHMARK_JOINTS);
+    Quats unpacked(NUM_BENCHMARK_JOINTS);
+    auto components = unpacked.pointers();
+
+    QBENCHMARK {
+        if (batch) {
+            unpackOrientationQuatsFromSixBytes(buffer.data(), components.data(), NUM_BENCHMARK_JOINTS);
+        } else {
+            const unsigned char* source = buffer.data();
+            for (int n = 0; n < NUM_BENCHMARK_JOINTS; ++n) {
+                glm::quat quat;
+                source += unpackOrientationQuatFromSixBytes(source, quat);
+                unpacked.set(n, quat);
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+//
+// JointPackingTests.h
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JointPackingTests_h
+#define hifi_JointPackingTests_h
+
+#include <QtTest/QtTest>
+
+class JointPackingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // the batches must give the same bytes and values as the one at a time functions
+    void quatsTest();
+    void vec3sTest();
+
+    // the joints of an avatar, one at a time against in batches
+    void packQuatsBenchmark_data();
+    void packQuatsBenchmark();
+    void unpackQuatsBenchmark_data();
+    void unpackQuatsBenchmark();
+};
+
+#endif // hifi_JointPackingTests_h
@@ -0,0 +1,140 @@
+//
+// RangeCoderTests.cpp
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RangeCoderTests.h"
+
+#include <random>
+#include <vector>
+
+#include <RangeCoder.h>
+
+QTEST_MAIN(RangeCoderTests)
+
+enum SymbolKind {
+    BIT,
+    INT,
+    DIRECT_BITS
+};
+
+struct Symbol {
+    SymbolKind kind;
+    int32_t value;
+    int numBits;
+};
+
+static const unsigned char* bytes(const QByteArray& array) {
+    return reinterpret_cast<const unsigned char*>(array.constData());
+}
+
+void RangeCoderTests::roundTripTest() {
+    std::mt19937 random(1);
+    const int NUM_TRIALS = 1000;
+    for (int trial = 0; trial < NUM_TRIALS; ++trial) {
+        // a mix of skewed bits, small signed integers and raw bits, coded with a few models of each
+        std::vector<Symbol> symbols(random() % 500);
+        QByteArray coded;
+        {
+            RangeEncoder encoder(coded);
+            BitModel bitModels[4];
+            IntModel intModels[3];
+            for (size_t i = 0; i < symbols.size(); ++i) {
+                Symbol& symbol = symbols[i];
+                symbol.kind = (SymbolKind)(random() % 3);
+                if (symbol.kind == BIT) {
+                    symbol.value = (random() % 10) == 0 ? 1 : 0;
+                    encoder.encodeBit(bitModels[i % 4], symbol.value);
+                } else if (symbol.kind == INT) {
+                    int32_t value = (int32_t)(random() % (1U << (random() % IntModel::MAX_BITS)));
+                    symbol.value = intModels[i % 3].encode(encoder, (random() & 1) ? -value : value);
+                } else {
+                    symbol.numBits = random() % 25;
+                    symbol.value = (int32_t)(random() & ((1U << symbol.numBits) - 1));
+                    encoder.encodeDirectBits(symbol.value, symbol.numBits);
+                }
+            }
+            encoder.flush();
+        }
+
+        RangeDecoder decoder(bytes(coded), coded.size());
+        BitModel bitModels[4];
+        IntModel intModels[3];
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            const Symbol& symbol = symbols[i];
+            if (symbol.kind == BIT) {
+                QCOMPARE(decoder.decodeBit(bitModels[i % 4]), symbol.value);
+            } else if (symbol.kind == INT) {
+                QCOMPARE(intModels[i % 3].decode(decoder), symbol.value);
+            } else {
+                QCOMPARE((int32_t)decoder.decodeDirectBits(symbol.numBits), symbol.value);
+            }
+        }
+    }
+}
+
+void RangeCoderTests::clampTest() {
+    const std::vector<int32_t> values = { IntModel::MAX_MAGNITUDE, -IntModel::MAX_MAGNITUDE,
+                                          IntModel::MAX_MAGNITUDE + 1, INT32_MAX, INT32_MIN };
+    QByteArray coded;
+    std::vector<int32_t> encoded;
+    {
+        RangeEncoder encoder(coded);
+        IntModel model;
+        for (int32_t value : values) {
+            encoded.push_back(model.encode(encoder, value));
+        }
+        encoder.flush();
+    }
+    QCOMPARE(encoded[0], IntModel::MAX_MAGNITUDE);
+    QCOMPARE(encoded[1], -IntModel::MAX_MAGNITUDE);
+    QCOMPARE(encoded[2], IntModel::MAX_MAGNITUDE);
+    QCOMPARE(encoded[3], IntModel::MAX_MAGNITUDE);
+    QCOMPARE(encoded[4], -IntModel::MAX_MAGNITUDE);
+
+    RangeDecoder decoder(bytes(coded), coded.size());
+    IntModel model;
+    for (int32_t value : encoded) {
+        QCOMPARE(model.decode(decoder), value);
+    }
+}
+
+void RangeCoderTests::compressionTest() {
+    // a bit that is one time in fifty costs well under a bit
+    const int NUM_BITS = 1000;
+    QByteArray coded;
+    RangeEncoder encoder(coded);
+    BitModel model;
+    for (int i = 0; i < NUM_BITS; ++i) {
+        encoder.encodeBit(model, (i % 50) == 0 ? 1 : 0);
+    }
+    encoder.flush();
+    QVERIFY(coded.size() < NUM_BITS / 8 / 3);
+
+    // nothing coded is nothing sent
+    QByteArray empty;
+    RangeEncoder(empty).flush();
+    QCOMPARE(empty.size(), 0);
+}
+
+void RangeCoderTests::corruptInputTest() {
+    // any input decodes to something, without reading past its end
+    std::mt19937 random(2);
+    for (int size = 0; size < 64; ++size) {
+        QByteArray junk(size, 0);
+        for (int i = 0; i < size; ++i) {
+            junk[i] = (char)random();
+        }
+        RangeDecoder decoder(bytes(junk), junk.size());
+        IntModel model;
+        for (int i = 0; i < 100; ++i) {
+            int32_t value = model.decode(decoder);
+            QVERIFY(value >= -IntModel::MAX_MAGNITUDE && value <= IntModel::MAX_MAGNITUDE);
+        }
+    }
+}
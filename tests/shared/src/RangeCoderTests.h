@@ -0,0 +1,25 @@
+//
+// RangeCoderTests.h
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RangeCoderTests_h
+#define hifi_RangeCoderTests_h
+
+#include <QtTest/QtTest>
+
+class RangeCoderTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void clampTest();
+    void compressionTest();
+    void corruptInputTest();
+};
+
+#endif // hifi_RangeCoderTests_h
@@ -0,0 +1,142 @@
+//
+// SlabAllocatorTests.cpp
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SlabAllocatorTests.h"
+
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <SlabAllocator.h>
+
+QTEST_MAIN(SlabAllocatorTests)
+
+// Enable this to manually run allocateBenchmark
+// (NOT a regular unit test; allocates and releases 100,000 blocks per iteration)
+//#define MANUAL_TEST true
+
+void SlabAllocatorTests::allocateTest() {
+    const int NUM_BLOCKS = 10000;
+    size_t allocatedBytes = SlabPool::getAllocatedBytes();
+
+    // blocks of every size, pooled or not, are distinct, aligned and writable
+    std::vector<std::pair<char*, size_t>> blocks;
+    std::set<char*> distinct;
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        size_t size = 1 + i % (SlabPool::MAX_BLOCK_SIZE + 100);
+        char* block = static_cast<char*>(SlabPool::allocate(size));
+        QVERIFY(block);
+        QCOMPARE((size_t)block % alignof(std::max_align_t), (size_t)0);
+        memset(block, i, size);
+        blocks.push_back({ block, size });
+        distinct.insert(block);
+    }
+    QCOMPARE((int)distinct.size(), NUM_BLOCKS);
+    QVERIFY(SlabPool::getAllocatedBytes() > allocatedBytes);
+    QVERIFY(SlabPool::getReservedBytes() >= SlabPool::getAllocatedBytes());
+
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        QCOMPARE(blocks[i].first[blocks[i].second - 1], (char)i);
+        SlabPool::release(blocks[i].first, blocks[i].second);
+    }
+    QCOMPARE(SlabPool::getAllocatedBytes(), allocatedBytes);
+}
+
+void SlabAllocatorTests::reuseTest() {
+    const size_t SIZE = 48;
+    void* first = SlabPool::allocate(SIZE);
+    SlabPool::release(first, SIZE);
+
+    // sizes that round up to the same block share a pool, the last block released is the first one reused
+    void* second = SlabPool::allocate(SIZE - 1);
+    QCOMPARE(second, first);
+    SlabPool::release(second, SIZE - 1);
+
+    size_t reservedBytes = SlabPool::getReservedBytes();
+    for (int i = 0; i < 1000; ++i) {
+        SlabPool::release(SlabPool::allocate(SIZE), SIZE);
+    }
+    QCOMPARE(SlabPool::getReservedBytes(), reservedBytes);
+}
+
+void SlabAllocatorTests::sharedPointerTest() {
+    size_t allocatedBytes = SlabPool::getAllocatedBytes();
+    {
+        std::shared_ptr<int> pointer(new int(1), std::default_delete<int>(), SlabAllocator<int>());
+        auto other = std::allocate_shared<int>(SlabAllocator<int>(), 2);
+        QCOMPARE(*pointer + *other, 3);
+        QVERIFY(SlabPool::getAllocatedBytes() > allocatedBytes);
+    }
+    QCOMPARE(SlabPool::getAllocatedBytes(), allocatedBytes);
+}
+
+void SlabAllocatorTests::threadsTest() {
+    const int NUM_THREADS = 4;
+    const int NUM_BLOCKS = 10000;
+    const size_t SIZE = 64;
+    size_t allocatedBytes = SlabPool::getAllocatedBytes();
+
+    // each thread releases the blocks the previous one allocated
+    std::vector<std::vector<void*>> blocks(NUM_THREADS);
+    for (auto& threadBlocks : blocks) {
+        for (int i = 0; i < NUM_BLOCKS; ++i) {
+            threadBlocks.push_back(SlabPool::allocate(SIZE));
+        }
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (void* block : blocks[(t + 1) % NUM_THREADS]) {
+                SlabPool::release(block, SIZE);
+            }
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                SlabPool::release(SlabPool::allocate(SIZE), SIZE);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    QCOMPARE(SlabPool::getAllocatedBytes(), allocatedBytes);
+}
+
+void SlabAllocatorTests::allocateBenchmark_data() {
+    QTest::addColumn<bool>("slab");
+    QTest::newRow("SlabPool") << true;
+    QTest::newRow("operator new") << false;
+}
+
+void SlabAllocatorTests::allocateBenchmark() {
+#if MANUAL_TEST
+    QFETCH(bool, slab);
+
+    // about the size of an entity tree element
+    const size_t SIZE = 320;
+    const int NUM_BLOCKS = 100000;
+    std::vector<void*> blocks(NUM_BLOCKS);
+
+    QBENCHMARK {
+        for (void*& block : blocks) {
+            block = slab ? SlabPool::allocate(SIZE) : ::operator new(SIZE);
+        }
+        for (void* block : blocks) {
+            if (slab) {
+                SlabPool::release(block, SIZE);
+            } else {
+                ::operator delete(block);
+            }
+        }
+    }
+#else
+    QSKIP("Define MANUAL_TEST in SlabAllocatorTests.cpp to run the allocation benchmark");
+#endif // MANUAL_TEST
+}
@@ -0,0 +1,29 @@
+//
+// SlabAllocatorTests.h
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SlabAllocatorTests_h
+#define hifi_SlabAllocatorTests_h
+
+#include <QtTest/QtTest>
+
+class SlabAllocatorTests : public QObject {
+    Q_OBJECT
+private slots:
+    void allocateTest();
+    void reuseTest();
+    void sharedPointerTest();
+    void threadsTest();
+
+    // many small blocks allocated then released, against the system allocator
+    void allocateBenchmark_data();
+    void allocateBenchmark();
+};
+
+#endif // hifi_SlabAllocatorTests_h
@@ -0,0 +1,232 @@
+//
+// UuidHashMapTests.cpp
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UuidHashMapTests.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include <QHash>
+
+#include <UuidHashMap.h>
+
+QTEST_MAIN(UuidHashMapTests)
+
+// Enable this to manually run lookupBenchmark and insertBenchmark
+// (NOT regular unit tests; fill maps of up to a million entries)
+//#define MANUAL_TEST true
+
+using Value = std::shared_ptr<int>;
+
+static std::vector<QUuid> createKeys(int count) {
+    std::vector<QUuid> keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        keys.push_back(QUuid::createUuid());
+    }
+    return keys;
+}
+
+void UuidHashMapTests::insertFindTest() {
+    const int NUM_KEYS = 10000;
+    auto keys = createKeys(NUM_KEYS);
+
+    UuidHashMap<Value> map;
+    QVERIFY(map.isEmpty());
+    QVERIFY(!map.contains(keys[0]));
+    QVERIFY(!map.value(keys[0]));
+
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        map.insert(keys[i], std::make_shared<int>(i));
+    }
+    QCOMPARE(map.size(), NUM_KEYS);
+
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        Value value = map.value(keys[i]);
+        QVERIFY(value);
+        QCOMPARE(*value, i);
+    }
+    QVERIFY(!map.contains(QUuid::createUuid()));
+
+    // inserting a key again replaces its value
+    map.insert(keys[0], std::make_shared<int>(-1));
+    QCOMPARE(map.size(), NUM_KEYS);
+    QCOMPARE(*map.value(keys[0]), -1);
+}
+
+void UuidHashMapTests::removeTest() {
+    const int NUM_KEYS = 10000;
+    auto keys = createKeys(NUM_KEYS);
+
+    UuidHashMap<Value> map;
+    QHash<QUuid, int> reference;
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        map.insert(keys[i], std::make_shared<int>(i));
+        reference.insert(keys[i], i);
+    }
+
+    // remove in another order than inserted, interleaved with new inserts, so that entries get shifted around
+    std::mt19937 random(1);
+    std::shuffle(keys.begin(), keys.end(), random);
+    for (int i = 0; i < NUM_KEYS / 2; ++i) {
+        QVERIFY(map.remove(keys[i]));
+        reference.remove(keys[i]);
+
+        QUuid key = QUuid::createUuid();
+        map.insert(key, std::make_shared<int>(NUM_KEYS + i));
+        reference.insert(key, NUM_KEYS + i);
+    }
+    QVERIFY(!map.remove(keys[0]));
+
+    QCOMPARE(map.size(), reference.size());
+    for (auto i = reference.begin(); i != reference.end(); ++i) {
+        Value value = map.value(i.key());
+        QVERIFY(value);
+        QCOMPARE(*value, i.value());
+    }
+    for (int i = 0; i < NUM_KEYS / 2; ++i) {
+        QVERIFY(!map.contains(keys[i]));
+    }
+
+    // the values of removed entries are released
+    Value value = std::make_shared<int>(0);
+    QUuid key = QUuid::createUuid();
+    map.insert(key, value);
+    QCOMPARE(value.use_count(), 2L);
+    map.remove(key);
+    QCOMPARE(value.use_count(), 1L);
+}
+
+void UuidHashMapTests::iterationTest() {
+    const int NUM_KEYS = 1000;
+    auto keys = createKeys(NUM_KEYS);
+
+    UuidHashMap<Value> map;
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        map.insert(keys[i], std::make_shared<int>(i));
+    }
+
+    std::vector<int> seen(NUM_KEYS, 0);
+    for (auto i = map.begin(); i != map.end(); ++i) {
+        QCOMPARE(i.key(), keys[*i.value()]);
+        ++seen[*i.value()];
+    }
+    for (int count : seen) {
+        QCOMPARE(count, 1);
+    }
+
+    int numValues = 0;
+    const UuidHashMap<Value>& constMap = map;
+    for (const Value& value : constMap) {
+        QVERIFY(value);
+        ++numValues;
+    }
+    QCOMPARE(numValues, NUM_KEYS);
+
+    UuidHashMap<Value> other;
+    other.swap(map);
+    QVERIFY(map.isEmpty());
+    QVERIFY(map.begin() == map.end());
+    QCOMPARE(other.size(), NUM_KEYS);
+}
+
+static void addBenchmarkRows() {
+    QTest::addColumn<int>("numEntries");
+    QTest::addColumn<bool>("flat");
+
+    for (int numEntries : { 10000, 100000, 1000000 }) {
+        QTest::newRow(qPrintable(QString("UuidHashMap %1").arg(numEntries))) << numEntries << true;
+        QTest::newRow(qPrintable(QString("QHash %1").arg(numEntries))) << numEntries << false;
+    }
+}
+
+void UuidHashMapTests::lookupBenchmark_data() {
+    addBenchmarkRows();
+}
+
+void UuidHashMapTests::lookupBenchmark() {
+#if MANUAL_TEST
+    QFETCH(int, numEntries);
+    QFETCH(bool, flat);
+
+    // the same number of lookups whatever the size, in random order, a tenth of them misses
+    const int NUM_LOOKUPS = 100000;
+    auto keys = createKeys(numEntries);
+    std::vector<QUuid> lookups;
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> pick(0, numEntries - 1);
+    for (int i = 0; i < NUM_LOOKUPS; ++i) {
+        lookups.push_back(i % 10 == 0 ? QUuid::createUuid() : keys[pick(random)]);
+    }
+
+    UuidHashMap<Value> flatMap;
+    QHash<QUuid, Value> hashMap;
+    for (int i = 0; i < numEntries; ++i) {
+        if (flat) {
+            flatMap.insert(keys[i], std::make_shared<int>(i));
+        } else {
+            hashMap.insert(keys[i], std::make_shared<int>(i));
+        }
+    }
+
+    int found = 0;
+    if (flat) {
+        QBENCHMARK {
+            for (const QUuid& key : lookups) {
+                found += flatMap.value(key) ? 1 : 0;
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (const QUuid& key : lookups) {
+                found += hashMap.value(key) ? 1 : 0;
+            }
+        }
+    }
+    QVERIFY(found > 0);
+#else
+    QSKIP("Define MANUAL_TEST in UuidHashMapTests.cpp to run the lookup benchmark");
+#endif // MANUAL_TEST
+}
+
+void UuidHashMapTests::insertBenchmark_data() {
+    addBenchmarkRows();
+}
+
+void UuidHashMapTests::insertBenchmark() {
+#if MANUAL_TEST
+    QFETCH(int, numEntries);
+    QFETCH(bool, flat);
+
+    auto keys = createKeys(numEntries);
+    Value value = std::make_shared<int>(0);
+
+    if (flat) {
+        QBENCHMARK {
+            UuidHashMap<Value> map;
+            for (const QUuid& key : keys) {
+                map.insert(key, value);
+            }
+            QCOMPARE(map.size(), numEntries);
+        }
+    } else {
+        QBENCHMARK {
+            QHash<QUuid, Value> map;
+            for (const QUuid& key : keys) {
+                map.insert(key, value);
+            }
+            QCOMPARE(map.size(), numEntries);
+        }
+    }
+#else
+    QSKIP("Define MANUAL_TEST in UuidHashMapTests.cpp to run the insert benchmark");
+#endif // MANUAL_TEST
+}
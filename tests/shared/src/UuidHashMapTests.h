@@ -0,0 +1,30 @@
+//
+// UuidHashMapTests.h
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UuidHashMapTests_h
+#define hifi_UuidHashMapTests_h
+
+#include <QtTest/QtTest>
+
+class UuidHashMapTests : public QObject {
+    Q_OBJECT
+private slots:
+    void insertFindTest();
+    void removeTest();
+    void iterationTest();
+
+    // the entity map's workloads, against QHash
+    void lookupBenchmark_data();
+    void lookupBenchmark();
+    void insertBenchmark_data();
+    void insertBenchmark();
+};
+
+#endif // hifi_UuidHashMapTests_h
@@ -0,0 +1,107 @@
+//
+// WorkStealingSchedulerTests.cpp
+// tests/shared/src
+//
+// Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingSchedulerTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <WorkStealingScheduler.h>
+
+QTEST_MAIN(WorkStealingSchedulerTests)
+
+static void runBatch(WorkStealingScheduler& scheduler, const std::vector<float>& costs,
+                     const WorkStealingScheduler::Job& job) {
+    scheduler.schedule(costs);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < scheduler.getNumWorkers(); ++i) {
+        threads.emplace_back([&, i] { scheduler.run(i, job); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    scheduler.finish();
+}
+
+void WorkStealingSchedulerTests::runsEachJobOnceTest() {
+    WorkStealingScheduler scheduler;
+    scheduler.setNumWorkers(4);
+
+    const int NUM_JOBS = 1000;
+    std::vector<std::atomic<int>> runs(NUM_JOBS);
+
+    // a few expensive jobs among many unknown ones
+    std::vector<float> costs(NUM_JOBS, 0.0f);
+    for (int i = 0; i < NUM_JOBS; i += 97) {
+        costs[i] = 100.0f + i;
+    }
+
+    for (int batch = 0; batch < 3; ++batch) {
+        for (auto& count : runs) {
+            count = 0;
+        }
+
+        runBatch(scheduler, costs, [&](int job) {
+            ++runs[job];
+        });
+
+        for (int i = 0; i < NUM_JOBS; ++i) {
+            QCOMPARE(runs[i].load(), 1);
+        }
+    }
+
+    uint64_t numJobs = 0;
+    for (const auto& stats : scheduler.getWorkerStats()) {
+        numJobs += stats.numJobs;
+    }
+    QCOMPARE(numJobs, (uint64_t)(3 * NUM_JOBS));
+
+    scheduler.resetWorkerStats();
+    for (const auto& stats : scheduler.getWorkerStats()) {
+        QCOMPARE(stats.numJobs, (uint64_t)0);
+        QCOMPARE(stats.numSteals, (uint64_t)0);
+    }
+}
+
+void WorkStealingSchedulerTests::emptyBatchTest() {
+    WorkStealingScheduler scheduler;
+    scheduler.setNumWorkers(2);
+
+    bool ran = false;
+    runBatch(scheduler, {}, [&](int job) {
+        ran = true;
+    });
+    QVERIFY(!ran);
+
+    // shrinking keeps at least one worker
+    scheduler.setNumWorkers(0);
+    QCOMPARE(scheduler.getNumWorkers(), 1);
+}
+
+void WorkStealingSchedulerTests::jobCostTest() {
+    WorkStealingScheduler scheduler;
+    scheduler.setNumWorkers(2);
+
+    const int NUM_JOBS = 8;
+    const int SLOW_JOB = 3;
+    runBatch(scheduler, std::vector<float>(NUM_JOBS, 0.0f), [&](int job) {
+        if (job == SLOW_JOB) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+
+    // every job gets a measured cost, usable as the estimate for the next batch
+    for (int i = 0; i < NUM_JOBS; ++i) {
+        QVERIFY(scheduler.getJobCost(i) > 0.0f);
+    }
+    QVERIFY(scheduler.getJobCost(SLOW_JOB) >= 5000.0f);
+}
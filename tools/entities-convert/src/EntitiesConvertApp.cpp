@@ -0,0 +1,120 @@
+//
+//  EntitiesConvertApp.cpp
+//  tools/entities-convert/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitiesConvertApp.h"
+
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+static QString fileTypeOf(const QString& fileName) {
+    QString fileType;
+    for (const auto& extension : PERSIST_EXTENSIONS) {
+        if (fileName.endsWith("." + extension) && extension.size() > fileType.size()) {
+            fileType = extension;
+        }
+    }
+    return fileType;
+}
+
+EntitiesConvertApp::EntitiesConvertApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Entities persist file converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "models.json.gz");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file", "models.ents");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption) || !parser.isSet(outputFilenameOption)) {
+        qCritical() << "Both an input and an output file are required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+
+    QString inputFileType = fileTypeOf(inputFilename);
+    QString outputFileType = fileTypeOf(outputFilename);
+    if (inputFileType.isEmpty()) {
+        qCritical() << "Unknown input file type" << inputFilename;
+        _returnCode = 1;
+        return;
+    }
+    if (outputFileType.isEmpty()) {
+        qCritical() << "Unknown output file type" << outputFilename;
+        _returnCode = 1;
+        return;
+    }
+
+    // adding entities needs a node list, even if it doesn't talk to anyone
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+
+    {
+        EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+        tree->createRootElement();
+        tree->setIsServer(true);
+
+        bool success = false;
+        tree->withWriteLock([&] {
+            // not readFromFile(), which would pick whichever of the persist files next to the input is newest
+            if (inputFileType == "ents") {
+                success = tree->readFromSnapshotFile(inputFilename);
+            } else if (inputFileType == "json.gz") {
+                success = tree->readJSONFromGzippedFile(inputFilename);
+            } else {
+                QFile file(inputFilename);
+                if (file.open(QIODevice::ReadOnly)) {
+                    QDataStream inputStream(&file);
+                    success = tree->readFromStream(file.size(), inputStream);
+                }
+            }
+        });
+        if (!success) {
+            qCritical() << "Failed to read" << inputFilename;
+            _returnCode = 2;
+        } else if (!tree->writeToFile(outputFilename.toLocal8Bit().constData(), nullptr, outputFileType)) {
+            qCritical() << "Failed to write" << outputFilename;
+            _returnCode = 3;
+        }
+    }
+
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+}
+
+EntitiesConvertApp::~EntitiesConvertApp() {
+}
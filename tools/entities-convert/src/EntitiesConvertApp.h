@@ -0,0 +1,30 @@
+//
+//  EntitiesConvertApp.h
+//  tools/entities-convert/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitiesConvertApp_h
+#define hifi_EntitiesConvertApp_h
+
+#include <QCoreApplication>
+
+/// Converts an entity server persist file between the JSON formats and the binary snapshot format, by the file
+/// extensions: .json, .json.gz or .ents
+class EntitiesConvertApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntitiesConvertApp(int argc, char* argv[]);
+    ~EntitiesConvertApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_EntitiesConvertApp_h
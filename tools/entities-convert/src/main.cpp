@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/entities-convert/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "EntitiesConvertApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Entities Convert");
+
+    EntitiesConvertApp app(argc, argv);
+    return app.getReturnCode();
+}